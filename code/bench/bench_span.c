@@ -0,0 +1,142 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/time/framework.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Span arithmetic benchmark: the plain field-wise add and nanosecond
+ * conversion next to their overflow-checked and saturating forms, over the
+ * same in-cache array of timeouts, so the rows compare cost per operation.
+ * Passes interleave the ops and each row keeps its best pass, so a noisy
+ * neighbour or a clock change lands on every row alike or on none.
+ *
+ * usage: bench_span [rows] [rounds]
+ */
+
+#define BENCH_DEFAULT_ROWS   4096
+#define BENCH_DEFAULT_ROUNDS 2000
+#define BENCH_PASSES         7
+
+static volatile int64_t g_sink;
+
+typedef enum {
+    BENCH_ADD = 0,
+    BENCH_ADD_CHECKED,
+    BENCH_ADD_SATURATING,
+    BENCH_SCALE_CHECKED,
+    BENCH_FROM_UNIT,
+    BENCH_FROM_UNIT_CHECKED,
+    BENCH_TO_NS,
+    BENCH_TO_NS_CHECKED,
+    BENCH_TO_NS_SATURATING,
+    BENCH_COUNT
+} bench_op_t;
+
+static const char *g_names[BENCH_COUNT] = {
+    "add", "add_checked", "add_saturating", "scale_checked",
+    "from_unit", "from_unit_checked",
+    "to_ns", "to_ns_checked", "to_ns_saturating"
+};
+
+static double run(bench_op_t op, const fossil_time_span_t *spans, size_t rows, size_t rounds) {
+    fossil_time_timer_t timer;
+    fossil_time_span_t acc, tmp;
+    int64_t sink = 0;
+
+    fossil_time_span_clear(&acc);
+    fossil_time_timer_start(&timer);
+
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < rows; ++i) {
+            switch (op) {
+                case BENCH_ADD:
+                    fossil_time_span_add(&tmp, &spans[i], &spans[rows - 1 - i]);
+                    sink += tmp.milliseconds;
+                    break;
+                case BENCH_ADD_CHECKED:
+                    sink += fossil_time_span_add_checked(&tmp, &spans[i], &spans[rows - 1 - i]);
+                    sink += tmp.milliseconds;
+                    break;
+                case BENCH_ADD_SATURATING:
+                    fossil_time_span_add_saturating(&tmp, &spans[i], &spans[rows - 1 - i]);
+                    sink += tmp.milliseconds;
+                    break;
+                case BENCH_SCALE_CHECKED:
+                    sink += fossil_time_span_scale_checked(&tmp, &spans[i], 3);
+                    sink += tmp.milliseconds;
+                    break;
+                case BENCH_FROM_UNIT:
+                    fossil_time_span_from_unit(&acc, (int64_t)i * 1000, "ms");
+                    sink += acc.milliseconds;
+                    break;
+                case BENCH_FROM_UNIT_CHECKED:
+                    sink += fossil_time_span_from_unit_checked(&acc, (int64_t)i * 1000, "ms");
+                    sink += acc.milliseconds;
+                    break;
+                case BENCH_TO_NS:
+                    sink += fossil_time_span_to_nanoseconds(&spans[i]);
+                    break;
+                case BENCH_TO_NS_CHECKED: {
+                    int64_t ns = 0;
+                    sink += fossil_time_span_to_nanoseconds_checked(&spans[i], &ns);
+                    sink += ns;
+                    break;
+                }
+                case BENCH_TO_NS_SATURATING:
+                    sink += fossil_time_span_to_nanoseconds_saturating(&spans[i]);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    g_sink += sink;
+    return (double)fossil_time_timer_elapsed_ns(&timer) / (double)(rows * rounds);
+}
+
+int main(int argc, char **argv) {
+    size_t rows = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : BENCH_DEFAULT_ROWS;
+    size_t rounds = argc > 2 ? (size_t)strtoull(argv[2], NULL, 10) : BENCH_DEFAULT_ROUNDS;
+    fossil_time_span_t *spans;
+
+    spans = (fossil_time_span_t *)malloc(rows * sizeof(fossil_time_span_t));
+    if (!spans || rows == 0 || rounds == 0) {
+        free(spans);
+        return 1;
+    }
+
+    /* Timeouts from 1 ms to about 17 minutes, in the field view */
+    for (size_t i = 0; i < rows; ++i)
+        fossil_time_span_from_nanoseconds(&spans[i], (int64_t)(i * 7919 % 1000000 + 1) * 1000000LL);
+
+    printf("%zu rows x %zu rounds\n", rows, rounds);
+    printf("%-18s %10s\n", "op", "ns/op");
+    double best[BENCH_COUNT];
+    for (int k = 0; k < BENCH_COUNT; ++k)
+        best[k] = 0.0;
+    for (int p = 0; p < BENCH_PASSES; ++p) {
+        for (int k = 0; k < BENCH_COUNT; ++k) {
+            double ns = run((bench_op_t)k, spans, rows, rounds / BENCH_PASSES + 1);
+            if (p == 0 || ns < best[k])
+                best[k] = ns;
+        }
+    }
+    for (int k = 0; k < BENCH_COUNT; ++k)
+        printf("%-18s %10.2f\n", g_names[k], best[k]);
+
+    free(spans);
+    return 0;
+}
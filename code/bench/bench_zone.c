@@ -0,0 +1,191 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/time/framework.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Zone lookup benchmark: per-call binary search, the per-thread period
+ * cache, and libc localtime_r with TZ set to the same zone, over the same
+ * timestamps in sorted (one event every few seconds) and shuffled order,
+ * followed by full local breakdowns with fossil_time_zone_to_local_batch
+ * and ISO 8601 export of the same column, row by row and batched.
+ *
+ * usage: bench_zone [zone] [rows]
+ */
+
+#define BENCH_DEFAULT_ROWS 4000000
+#define BENCH_FORMAT_CHUNK 4096
+#define BENCH_FORMAT_STRIDE 40
+
+static volatile int64_t g_sink;
+
+typedef enum {
+    BENCH_UNCACHED = 0,
+    BENCH_CACHED,
+    BENCH_LIBC
+} bench_path_t;
+
+static double run_batch(const fossil_time_zone_t *zone, const int64_t *ts, size_t rows,
+                        int64_t *ns, fossil_time_date_t *out) {
+    fossil_time_timer_t timer;
+
+    for (size_t i = 0; i < rows; ++i)
+        ns[i] = ts[i] * 1000000000LL;
+    memset(out, 0, rows * sizeof(*out));  /* fault the pages in before timing */
+
+    fossil_time_timer_start(&timer);
+    fossil_time_zone_to_local_batch(zone, ns, rows, out);
+    double per_row = (double)fossil_time_timer_elapsed_ns(&timer) / (double)rows;
+
+    g_sink += out[rows / 2].hour;
+    return per_row;
+}
+
+/* ns must already hold the column; text holds one chunk of rows */
+static double run_format(const fossil_time_zone_t *zone, const int64_t *ns, size_t rows,
+                         char *text, int batched) {
+    fossil_time_timer_t timer;
+
+    fossil_time_timer_start(&timer);
+    for (size_t at = 0; at < rows; at += BENCH_FORMAT_CHUNK) {
+        size_t n = rows - at < BENCH_FORMAT_CHUNK ? rows - at : BENCH_FORMAT_CHUNK;
+
+        if (batched) {
+            fossil_time_zone_format_batch(zone, ns + at, n, text, BENCH_FORMAT_STRIDE, "iso");
+        } else {
+            for (size_t i = 0; i < n; ++i)
+                fossil_time_zone_format(zone, ns[at + i], text + i * BENCH_FORMAT_STRIDE,
+                                        BENCH_FORMAT_STRIDE, "iso");
+        }
+        g_sink += text[11];
+    }
+    return (double)fossil_time_timer_elapsed_ns(&timer) / (double)rows;
+}
+
+static double run(bench_path_t path, const fossil_time_zone_t *zone, const int64_t *ts, size_t rows) {
+    fossil_time_timer_t timer;
+    fossil_time_zone_period_t p;
+    int64_t sink = 0;
+
+    fossil_time_timer_start(&timer);
+
+    for (size_t i = 0; i < rows; ++i) {
+        switch (path) {
+            case BENCH_UNCACHED:
+                fossil_time_zone_lookup(zone, ts[i], &p);
+                sink += p.offset_sec;
+                break;
+            case BENCH_CACHED:
+                fossil_time_zone_lookup_cached(zone, ts[i], &p);
+                sink += p.offset_sec;
+                break;
+            case BENCH_LIBC: {
+#if defined(_WIN32)
+                struct tm tm;
+                time_t t = (time_t)ts[i];
+                localtime_s(&tm, &t);
+#else
+                struct tm tm;
+                time_t t = (time_t)ts[i];
+                localtime_r(&t, &tm);
+#endif
+                sink += tm.tm_hour + tm.tm_isdst;
+                break;
+            }
+        }
+    }
+
+    g_sink += sink;
+    return (double)fossil_time_timer_elapsed_ns(&timer) / (double)rows;
+}
+
+int main(int argc, char **argv) {
+    const char *name = argc > 1 ? argv[1] : "Europe/Berlin";
+    size_t rows = argc > 2 ? (size_t)strtoull(argv[2], NULL, 10) : BENCH_DEFAULT_ROWS;
+    static const char *paths[] = { "uncached", "cached", "localtime_r" };
+    fossil_time_zone_t *zone;
+    int64_t *sorted, *shuffled;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    zone = fossil_time_zone_open(name);
+    if (!zone) {
+        printf("bench_zone: zone %s not available, skipping\n", name);
+        return 0;
+    }
+
+    sorted = (int64_t *)malloc(rows * sizeof(int64_t));
+    shuffled = (int64_t *)malloc(rows * sizeof(int64_t));
+    if (!sorted || !shuffled || rows == 0) {
+        fossil_time_zone_close(zone);
+        free(sorted);
+        free(shuffled);
+        return 1;
+    }
+
+    /* From 2024-01-01, one event every 7 s: spans both 2024 DST switches */
+    for (size_t i = 0; i < rows; ++i)
+        sorted[i] = shuffled[i] = 1704067200LL + (int64_t)i * 7;
+    for (size_t i = rows - 1; i > 0; --i) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        size_t j = (size_t)(rng % (i + 1));
+        int64_t tmp = shuffled[i];
+        shuffled[i] = shuffled[j];
+        shuffled[j] = tmp;
+    }
+
+#if defined(_WIN32)
+    _putenv_s("TZ", name);
+    _tzset();
+#else
+    setenv("TZ", name, 1);
+    tzset();
+#endif
+
+    printf("zone %s, %zu rows\n", name, rows);
+    printf("%-12s %12s %12s\n", "path", "sorted ns", "shuffled ns");
+    for (int k = 0; k < 3; ++k) {
+        double a = run((bench_path_t)k, zone, sorted, rows);
+        double b = run((bench_path_t)k, zone, shuffled, rows);
+        printf("%-12s %12.2f %12.2f\n", paths[k], a, b);
+    }
+
+    int64_t *ns = (int64_t *)malloc(rows * sizeof(int64_t));
+    int64_t *ns_shuffled = (int64_t *)malloc(rows * sizeof(int64_t));
+    fossil_time_date_t *local = (fossil_time_date_t *)malloc(rows * sizeof(fossil_time_date_t));
+    static char text[BENCH_FORMAT_CHUNK * BENCH_FORMAT_STRIDE];
+    if (ns && ns_shuffled && local) {
+        double a = run_batch(zone, shuffled, rows, ns_shuffled, local);
+        double b;
+        double c = run_batch(zone, sorted, rows, ns, local);
+        printf("%-12s %12.2f %12.2f\n", "local_batch", c, a);
+
+        a = run_format(zone, ns, rows, text, 0);
+        b = run_format(zone, ns_shuffled, rows, text, 0);
+        printf("%-12s %12.2f %12.2f\n", "format", a, b);
+        a = run_format(zone, ns, rows, text, 1);
+        b = run_format(zone, ns_shuffled, rows, text, 1);
+        printf("%-12s %12.2f %12.2f\n", "format_batch", a, b);
+    }
+    free(ns);
+    free(ns_shuffled);
+    free(local);
+
+    fossil_time_zone_close(zone);
+    free(sorted);
+    free(shuffled);
+    return 0;
+}
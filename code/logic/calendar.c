@@ -198,7 +198,7 @@ int fossil_time_calendar_is_holiday(
     char tmp[32];
     return fossil_time_calendar_get_holiday(
         dt, region_id, tmp, sizeof(tmp)
-    ) == 0;
+    ) >= 0;
 }
 
 int fossil_time_calendar_get_holiday(
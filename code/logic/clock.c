@@ -0,0 +1,140 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/time/clock.h"
+#include "fossil/time/leap.h"
+#include "fossil/time/sleep.h"
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+#if defined(__linux__)
+#  include <sys/timex.h>
+#endif
+
+/* ======================================================
+ * Internal helpers
+ * ====================================================== */
+
+#if defined(_MSC_VER)
+#  define FOSSIL_CLOCK_LOAD64(p)      InterlockedCompareExchange64((p), 0, 0)
+#  define FOSSIL_CLOCK_STORE64(p, v)  (void)InterlockedExchange64((p), (v))
+#else
+#  define FOSSIL_CLOCK_LOAD64(p)      __atomic_load_n((p), __ATOMIC_RELAXED)
+#  define FOSSIL_CLOCK_STORE64(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#endif
+
+static volatile int64_t g_uncertainty = FOSSIL_TIME_UNCERTAINTY_MEASURED;
+
+/* Kernel's bound on the wall clock error, grown since the last NTP update */
+static int64_t measured_uncertainty(void) {
+#if defined(__linux__)
+    struct timex tx = {0};
+    int state = adjtimex(&tx);
+
+    /* Unsynchronized, maxerror is only the kernel's 16 s cap, not a bound */
+    if (state == -1 || state == TIME_ERROR || (tx.status & STA_UNSYNC))
+        return -1;
+    return (int64_t)tx.maxerror * 1000; /* microseconds */
+#else
+    return -1;
+#endif
+}
+
+static int64_t realtime_ns(void) {
+    struct timespec ts;
+#if defined(_WIN32)
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+    return fossil_time_leap_smear_clock((int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec);
+}
+
+/* ======================================================
+ * C API — Uncertainty
+ * ====================================================== */
+
+int fossil_time_now_set_uncertainty(int64_t error_ns) {
+    if (error_ns < 0 && error_ns != FOSSIL_TIME_UNCERTAINTY_MEASURED)
+        return -1;
+    FOSSIL_CLOCK_STORE64(&g_uncertainty, error_ns);
+    return 0;
+}
+
+int64_t fossil_time_now_uncertainty(void) {
+    int64_t error_ns = FOSSIL_CLOCK_LOAD64(&g_uncertainty);
+    return error_ns == FOSSIL_TIME_UNCERTAINTY_MEASURED ? measured_uncertainty() : error_ns;
+}
+
+/* ======================================================
+ * C API — Readings
+ * ====================================================== */
+
+int fossil_time_now_interval(fossil_time_interval_t *out) {
+    if (!out)
+        return -1;
+
+    /* The kernel bound only grows between updates, so reading it after
+     * the clock keeps it valid for the reading */
+    int64_t now = realtime_ns();
+    int64_t error_ns = fossil_time_now_uncertainty();
+    if (error_ns < 0)
+        return -1;
+
+    out->earliest = now - error_ns;
+    out->latest = now + error_ns;
+    return 0;
+}
+
+int fossil_time_now_after(int64_t t_ns) {
+    fossil_time_interval_t now;
+    if (fossil_time_now_interval(&now) != 0)
+        return -1;
+    return now.earliest > t_ns;
+}
+
+int fossil_time_now_before(int64_t t_ns) {
+    fossil_time_interval_t now;
+    if (fossil_time_now_interval(&now) != 0)
+        return -1;
+    return now.latest < t_ns;
+}
+
+int fossil_time_now_commit_wait(int64_t t_ns) {
+    fossil_time_interval_t now;
+
+    for (;;) {
+        if (fossil_time_now_interval(&now) != 0)
+            return -1;
+        if (now.earliest > t_ns)
+            return 0;
+        /* The bound can grow while asleep, so check again on waking */
+        fossil_time_sleep_nanoseconds((uint64_t)(t_ns - now.earliest) + 1);
+    }
+}
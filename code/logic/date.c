@@ -23,6 +23,8 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/time/date.h"
+#include "fossil/time/query.h"
+#include "fossil/time/leap.h"
 #include <string.h>
 #include <strings.h>
 #include <stdint.h>
@@ -75,39 +77,41 @@ static int64_t fossil_time_tm_to_epoch_utc(const struct tm *tm) {
          + tm->tm_sec;
 }
 
-/* ======================================================
- * Internal: portable UTC timegm replacement
- * ====================================================== */
-
-static time_t fossil_time_internal_timegm(struct tm *tm) {
-
-#if defined(_WIN32)
-
-    /* Windows provides _mkgmtime */
-    return _mkgmtime(tm);
-
-#else
-
-    /* POSIX fallback: temporarily force UTC */
-    char *old_tz = getenv("TZ");
-    time_t result;
-
-    setenv("TZ", "UTC", 1);
-    tzset();
-
-    result = mktime(tm);
+/* Proleptic Gregorian year containing a day count since 1970-01-01 */
+static int64_t fossil_time_year_from_days(int64_t days) {
+    int64_t z = days + 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp  = (5 * doy + 2) / 153;
+    return (int64_t)yoe + era * 400 + (mp >= 10);
+}
 
-    if (old_tz)
-        setenv("TZ", old_tz, 1);
-    else
-        unsetenv("TZ");
+/* Floor of ns / 1e9, for converting smeared nanoseconds back to seconds */
+static int64_t fossil_time_floor_seconds(int64_t ns) {
+    int64_t sec = ns / 1000000000LL;
+    return (ns % 1000000000LL < 0) ? sec - 1 : sec;
+}
 
-    tzset();
-    return result;
+/*
+ * Smearing only moves instants near leap seconds, all well inside the
+ * int64 nanosecond range (1677-2262); seconds beyond it pass through.
+ */
+#define FOSSIL_DATE_SMEAR_MAX_SECONDS 9000000000LL
 
-#endif
+static int64_t fossil_time_smear_seconds(
+    int64_t seconds,
+    fossil_time_scale_t from,
+    fossil_time_scale_t to
+) {
+    if (seconds > FOSSIL_DATE_SMEAR_MAX_SECONDS || seconds < -FOSSIL_DATE_SMEAR_MAX_SECONDS)
+        return seconds;
+    return fossil_time_floor_seconds(fossil_time_leap_convert(seconds * 1000000000LL, from, to));
 }
 
+static void fossil_time_date_from_epoch_ns(int64_t nanoseconds, fossil_time_date_t *dt);
+
 /* ======================================================
  * Core API
  * ====================================================== */
@@ -116,13 +120,23 @@ void fossil_time_date_now(fossil_time_date_t *dt) {
     struct timespec ts;
     struct tm tm;
 
+#if defined(_WIN32)
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+
+    if (fossil_time_leap_smear_window() != 0) {
+        int64_t ns = (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+        fossil_time_date_from_epoch_ns(fossil_time_leap_smear_clock(ns), dt);
+        return;
+    }
+
     memset(dt, 0, sizeof(*dt));
 
 #if defined(_WIN32)
-    timespec_get(&ts, TIME_UTC);
     gmtime_s(&tm, &ts.tv_sec);
 #else
-    clock_gettime(CLOCK_REALTIME, &ts);
     gmtime_r(&ts.tv_sec, &tm);
 #endif
 
@@ -178,21 +192,29 @@ int fossil_time_date_validate(const fossil_time_date_t *dt) {
 }
 
 void fossil_time_date_normalize(fossil_time_date_t *dt) {
-    /* Conservative normalize: recompute derived only */
-    struct tm tm = {0};
-
-    tm.tm_year = dt->year - 1900;
-    tm.tm_mon  = dt->month - 1;
-    tm.tm_mday = dt->day;
-    tm.tm_hour = dt->hour;
-    tm.tm_min  = dt->minute;
-    tm.tm_sec  = dt->second;
-
-    time_t t = fossil_time_internal_timegm(&tm);
-    gmtime_r(&t, &tm);
-
-    dt->weekday = tm.tm_wday;
-    dt->yearday = tm.tm_yday + 1;
+    /*
+     * Conservative normalize: recompute derived only. Out-of-range fields
+     * carry into the next larger one, as mktime would, but the arithmetic
+     * is done here so the process TZ is never touched.
+     */
+    int64_t month = (int64_t)dt->month - 1;
+    int64_t year  = (int64_t)dt->year + (month >= 0 ? month / 12 : (month - 11) / 12);
+    month -= (year - dt->year) * 12;
+
+    int64_t seconds = (fossil_time_days_from_civil(year, (unsigned)(month + 1), 1)
+                       + dt->day - 1) * 86400
+                    + (int64_t)dt->hour * 3600
+                    + (int64_t)dt->minute * 60
+                    + dt->second;
+
+    int64_t days = seconds / 86400;
+    if (seconds % 86400 < 0)
+        days--;
+
+    int64_t wd = (days + 4) % 7;
+    dt->weekday = (int8_t)(wd < 0 ? wd + 7 : wd);
+    dt->yearday = (int16_t)(days - fossil_time_days_from_civil(
+        fossil_time_year_from_days(days), 1, 1) + 1);
 }
 
 int fossil_time_date_compare(
@@ -223,7 +245,8 @@ int64_t fossil_time_date_diff_seconds(
            fossil_time_date_to_unix_seconds(b);
 }
 
-int64_t fossil_time_date_to_unix_seconds(
+/* Civil fields to epoch seconds, before any smear */
+static int64_t fossil_time_date_epoch_seconds(
     const fossil_time_date_t *dt
 ) {
     struct tm tm = {0};
@@ -239,10 +262,20 @@ int64_t fossil_time_date_to_unix_seconds(
     return seconds - (dt->tz_offset_min * 60);
 }
 
+int64_t fossil_time_date_to_unix_seconds(
+    const fossil_time_date_t *dt
+) {
+    int64_t seconds = fossil_time_date_epoch_seconds(dt);
+
+    if (fossil_time_leap_smear_window() != 0)
+        return fossil_time_smear_seconds(seconds, FOSSIL_TIME_SCALE_SMEAR, FOSSIL_TIME_SCALE_UTC);
+    return seconds;
+}
+
 int64_t fossil_time_date_to_unix_nanoseconds(
     const fossil_time_date_t *dt
 ) {
-    int64_t sec = fossil_time_date_to_unix_seconds(dt);
+    int64_t sec = fossil_time_date_epoch_seconds(dt);
     int64_t ns  = 0;
 
     if (dt->precision_mask & FOSSIL_TIME_PRECISION_MILLI)
@@ -252,7 +285,10 @@ int64_t fossil_time_date_to_unix_nanoseconds(
     if (dt->precision_mask & FOSSIL_TIME_PRECISION_NANO)
         ns += dt->nanosecond;
 
-    return sec * 1000000000LL + ns;
+    ns += sec * 1000000000LL;
+    if (fossil_time_leap_smear_window() != 0)
+        return fossil_time_leap_convert(ns, FOSSIL_TIME_SCALE_SMEAR, FOSSIL_TIME_SCALE_UTC);
+    return ns;
 }
 
 void fossil_time_date_from_unix_seconds(
@@ -260,6 +296,10 @@ void fossil_time_date_from_unix_seconds(
     fossil_time_date_t *dt
 ) {
     struct tm tm;
+
+    if (fossil_time_leap_smear_window() != 0)
+        seconds = fossil_time_smear_seconds(seconds, FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_SMEAR);
+
     time_t t = (time_t)seconds;
 
     memset(dt, 0, sizeof(*dt));
@@ -284,8 +324,243 @@ void fossil_time_date_from_unix_seconds(
         FOSSIL_TIME_PRECISION_SECOND;
 }
 
+void fossil_time_date_from_unix_nanoseconds(
+    int64_t nanoseconds,
+    fossil_time_date_t *dt
+) {
+    if (fossil_time_leap_smear_window() != 0)
+        nanoseconds = fossil_time_leap_convert(
+            nanoseconds, FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_SMEAR);
+    fossil_time_date_from_epoch_ns(nanoseconds, dt);
+}
+
+static void fossil_time_date_from_epoch_ns(
+    int64_t nanoseconds,
+    fossil_time_date_t *dt
+) {
+    int64_t sec = nanoseconds / 1000000000LL;
+    int64_t sub = nanoseconds % 1000000000LL;
+    if (sub < 0) {
+        sub += 1000000000LL;
+        sec--;
+    }
+
+    int64_t days = sec / 86400;
+    int64_t sod  = sec % 86400;
+    if (sod < 0) {
+        sod += 86400;
+        days--;
+    }
+
+    /* civil_from_days */
+    int64_t z = days + 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp  = (5 * doy + 2) / 153;
+    const unsigned d   = doy - (153 * mp + 2) / 5 + 1;
+    const unsigned m   = mp < 10 ? mp + 3 : mp - 9;
+    const int64_t y    = (int64_t)yoe + era * 400 + (m <= 2);
+
+    memset(dt, 0, sizeof(*dt));
+
+    dt->year   = (int32_t)y;
+    dt->month  = (int8_t)m;
+    dt->day    = (int8_t)d;
+    dt->hour   = (int8_t)(sod / 3600);
+    dt->minute = (int8_t)((sod / 60) % 60);
+    dt->second = (int8_t)(sod % 60);
+
+    dt->millisecond = (int16_t)(sub / 1000000);
+    dt->microsecond = (int16_t)((sub / 1000) % 1000);
+    dt->nanosecond  = (int16_t)(sub % 1000);
+
+    int64_t wd = (days + 4) % 7;
+    dt->weekday = (int8_t)(wd < 0 ? wd + 7 : wd);
+    dt->yearday = (int16_t)(days - fossil_time_days_from_civil(y, 1, 1) + 1);
+    dt->tz_offset_min = 0;
+
+    dt->precision_mask =
+        FOSSIL_TIME_PRECISION_YEAR   |
+        FOSSIL_TIME_PRECISION_MONTH  |
+        FOSSIL_TIME_PRECISION_DAY    |
+        FOSSIL_TIME_PRECISION_HOUR   |
+        FOSSIL_TIME_PRECISION_MINUTE |
+        FOSSIL_TIME_PRECISION_SECOND |
+        FOSSIL_TIME_PRECISION_MILLI  |
+        FOSSIL_TIME_PRECISION_MICRO  |
+        FOSSIL_TIME_PRECISION_NANO;
+}
+
 // format logic
 
+/* ======================================================
+ * Internal: ISO 8601 writer and reader
+ * No printf: digits are copied from a pair table
+ * ====================================================== */
+
+/*
+ * Widest field text: "-2147483648-128-128T-128:-128:-128." plus eight
+ * "-32768" sub-second groups is 85 bytes; a suffix is capped separately.
+ */
+#define FOSSIL_DATE_MAX_FIELDS 96
+#define FOSSIL_DATE_MAX_SUFFIX 64
+#define FOSSIL_DATE_MAX_ISO (FOSSIL_DATE_MAX_FIELDS + FOSSIL_DATE_MAX_SUFFIX)
+
+static const char fossil_digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* As printf("%0*d"): at least width characters, the sign counted in them */
+static size_t fossil_put_int(char *p, int64_t v, int width) {
+    char tmp[24];
+    size_t n = 0, len = 0;
+    uint64_t u = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+
+    /* Fixed-width fields of timestamps: one table copy per two digits */
+    if (width == 2 && v >= 0 && v < 100) {
+        memcpy(p, fossil_digit_pairs + v * 2, 2);
+        return 2;
+    }
+    if (width == 3 && v >= 0 && v < 1000) {
+        p[0] = (char)('0' + v / 100);
+        memcpy(p + 1, fossil_digit_pairs + (v % 100) * 2, 2);
+        return 3;
+    }
+    if (width == 4 && v >= 0 && v < 10000) {
+        memcpy(p, fossil_digit_pairs + (v / 100) * 2, 2);
+        memcpy(p + 2, fossil_digit_pairs + (v % 100) * 2, 2);
+        return 4;
+    }
+
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+
+    if (v < 0) {
+        p[len++] = '-';
+        width--;
+    }
+    for (int pad = width - (int)n; pad > 0; --pad)
+        p[len++] = '0';
+    while (n)
+        p[len++] = tmp[--n];
+    return len;
+}
+
+/* "Z" for UTC, otherwise +hh:mm or -hh:mm */
+static size_t fossil_put_offset(char *p, int offset_min) {
+    int a = offset_min < 0 ? -offset_min : offset_min;
+    size_t len = 1;
+
+    if (offset_min == 0) {
+        p[0] = 'Z';
+        return 1;
+    }
+    p[0] = offset_min < 0 ? '-' : '+';
+    len += fossil_put_int(p + len, a / 60, 2);
+    p[len++] = ':';
+    len += fossil_put_int(p + len, a % 60, 2);
+    return len;
+}
+
+/*
+ * Write the ISO 8601 form of the fields in the precision mask to out
+ * (FOSSIL_DATE_MAX_ISO bytes, not terminated). The suffix follows a time
+ * part; NULL writes the designator for tz_offset_min instead.
+ */
+static size_t fossil_write_iso(
+    const fossil_time_date_t *dt,
+    char *out,
+    const char *suffix,
+    size_t suffix_len
+) {
+    static const uint64_t sub_masks[8] = {
+        FOSSIL_TIME_PRECISION_MILLI, FOSSIL_TIME_PRECISION_MICRO,
+        FOSSIL_TIME_PRECISION_NANO,  FOSSIL_TIME_PRECISION_PICO,
+        FOSSIL_TIME_PRECISION_FEMTO, FOSSIL_TIME_PRECISION_ATTO,
+        FOSSIL_TIME_PRECISION_ZEPTO, FOSSIL_TIME_PRECISION_YOCTO
+    };
+    const uint64_t mask = dt->precision_mask;
+    size_t n = 0;
+
+    /* Date part */
+    if (mask & FOSSIL_TIME_PRECISION_YEAR)
+        n += fossil_put_int(out + n, dt->year, 4);
+    if (mask & FOSSIL_TIME_PRECISION_MONTH) {
+        out[n++] = '-';
+        n += fossil_put_int(out + n, dt->month, 2);
+    }
+    if (mask & FOSSIL_TIME_PRECISION_DAY) {
+        out[n++] = '-';
+        n += fossil_put_int(out + n, dt->day, 2);
+    }
+
+    /* Time part */
+    if (mask & (FOSSIL_TIME_PRECISION_HOUR |
+                FOSSIL_TIME_PRECISION_MINUTE |
+                FOSSIL_TIME_PRECISION_SECOND)) {
+        const int16_t sub[8] = {
+            dt->millisecond, dt->microsecond, dt->nanosecond, dt->picosecond,
+            dt->femtosecond, dt->attosecond, dt->zeptosecond, dt->yoctosecond
+        };
+        size_t frac;
+
+        out[n++] = 'T';
+        n += fossil_put_int(out + n, (mask & FOSSIL_TIME_PRECISION_HOUR) ? dt->hour : 0, 2);
+        out[n++] = ':';
+        n += fossil_put_int(out + n, (mask & FOSSIL_TIME_PRECISION_MINUTE) ? dt->minute : 0, 2);
+        out[n++] = ':';
+        n += fossil_put_int(out + n, (mask & FOSSIL_TIME_PRECISION_SECOND) ? dt->second : 0, 2);
+
+        /* Sub-seconds, trailing zeros trimmed */
+        out[n] = '.';
+        frac = n + 1;
+        for (int i = 0; i < 8; ++i) {
+            if (mask & sub_masks[i])
+                frac += fossil_put_int(out + frac, sub[i], 3);
+        }
+        while (frac > n + 1 && out[frac - 1] == '0')
+            frac--;
+        if (frac > n + 1)
+            n = frac;
+
+        if (suffix) {
+            memcpy(out + n, suffix, suffix_len);
+            n += suffix_len;
+        } else {
+            n += fossil_put_offset(out + n, dt->tz_offset_min);
+        }
+    }
+
+    return n;
+}
+
+/* Copy like snprintf: always terminated, returns the untruncated length */
+static int fossil_emit(char *buffer, size_t buffer_size, const char *text, size_t len) {
+    size_t copy = len < buffer_size - 1 ? len : buffer_size - 1;
+    memcpy(buffer, text, copy);
+    buffer[copy] = '\0';
+    return (int)len;
+}
+
+/* Exactly `count` ASCII digits */
+static int fossil_read_digits(const char **s, int count, int *out) {
+    int v = 0;
+    for (int i = 0; i < count; ++i) {
+        char c = (*s)[i];
+        if (c < '0' || c > '9')
+            return 0;
+        v = v * 10 + (c - '0');
+    }
+    *s += count;
+    *out = v;
+    return 1;
+}
+
 int fossil_time_date_format(
     const fossil_time_date_t *dt,
     char *buffer,
@@ -294,61 +569,202 @@ int fossil_time_date_format(
 ) {
     if (!dt || !buffer || buffer_size == 0) return 0;
 
-    size_t n = 0;
+    char text[FOSSIL_DATE_MAX_ISO];
+    size_t n = fossil_write_iso(dt, text, NULL, 0);
 
-    /* Date part */
-    if (dt->precision_mask & FOSSIL_TIME_PRECISION_YEAR)
-        n += snprintf(buffer + n, buffer_size - n, "%04d", dt->year);
-    if (dt->precision_mask & FOSSIL_TIME_PRECISION_MONTH)
-        n += snprintf(buffer + n, buffer_size - n, "-%02d", dt->month);
-    if (dt->precision_mask & FOSSIL_TIME_PRECISION_DAY)
-        n += snprintf(buffer + n, buffer_size - n, "-%02d", dt->day);
+    /* Log format fallback */
+    if (!strcmp(format_id, "log") && n == 0) {
+        return snprintf(buffer, buffer_size, "%04d%02d%02d-%02d%02d%02d",
+                        dt->year, dt->month, dt->day,
+                        dt->hour, dt->minute, dt->second);
+    }
 
-    /* Time part */
-    if (dt->precision_mask & (FOSSIL_TIME_PRECISION_HOUR |
-                              FOSSIL_TIME_PRECISION_MINUTE |
-                              FOSSIL_TIME_PRECISION_SECOND)) {
-        int h = (dt->precision_mask & FOSSIL_TIME_PRECISION_HOUR) ? dt->hour : 0;
-        int m = (dt->precision_mask & FOSSIL_TIME_PRECISION_MINUTE) ? dt->minute : 0;
-        int s = (dt->precision_mask & FOSSIL_TIME_PRECISION_SECOND) ? dt->second : 0;
-        n += snprintf(buffer + n, buffer_size - n, "T%02d:%02d:%02d", h, m, s);
-
-        /* Sub-seconds */
-        char subsec[32];
-        int pos = 0;
-        if (dt->precision_mask & FOSSIL_TIME_PRECISION_MILLI)
-            pos += snprintf(subsec + pos, sizeof(subsec) - pos, "%03d", dt->millisecond);
-        if (dt->precision_mask & FOSSIL_TIME_PRECISION_MICRO)
-            pos += snprintf(subsec + pos, sizeof(subsec) - pos, "%03d", dt->microsecond);
-        if (dt->precision_mask & FOSSIL_TIME_PRECISION_NANO)
-            pos += snprintf(subsec + pos, sizeof(subsec) - pos, "%03d", dt->nanosecond);
-        if (dt->precision_mask & FOSSIL_TIME_PRECISION_PICO)
-            pos += snprintf(subsec + pos, sizeof(subsec) - pos, "%03d", dt->picosecond);
-        if (dt->precision_mask & FOSSIL_TIME_PRECISION_FEMTO)
-            pos += snprintf(subsec + pos, sizeof(subsec) - pos, "%03d", dt->femtosecond);
-        if (dt->precision_mask & FOSSIL_TIME_PRECISION_ATTO)
-            pos += snprintf(subsec + pos, sizeof(subsec) - pos, "%03d", dt->attosecond);
-        if (dt->precision_mask & FOSSIL_TIME_PRECISION_ZEPTO)
-            pos += snprintf(subsec + pos, sizeof(subsec) - pos, "%03d", dt->zeptosecond);
-        if (dt->precision_mask & FOSSIL_TIME_PRECISION_YOCTO)
-            pos += snprintf(subsec + pos, sizeof(subsec) - pos, "%03d", dt->yoctosecond);
-
-        /* Trim trailing zeros */
-        while (pos > 0 && subsec[pos - 1] == '0') pos--;
-        if (pos > 0) n += snprintf(buffer + n, buffer_size - n, ".%.*s", pos, subsec);
-
-        /* UTC marker */
-        n += snprintf(buffer + n, buffer_size - n, "Z");
+    return fossil_emit(buffer, buffer_size, text, n);
+}
+
+int fossil_time_date_format_iso(
+    const fossil_time_date_t *dt,
+    char *buffer,
+    size_t buffer_size,
+    const char *suffix
+) {
+    char text[FOSSIL_DATE_MAX_ISO];
+    size_t suffix_len = 0;
+
+    if (!dt || !buffer || buffer_size == 0)
+        return -1;
+    if (suffix) {
+        suffix_len = strlen(suffix);
+        if (suffix_len > FOSSIL_DATE_MAX_SUFFIX)
+            return -1;
     }
 
-    /* Log format fallback */
-    if (!strcmp(format_id, "log") && n == 0) {
-        n = snprintf(buffer, buffer_size, "%04d%02d%02d-%02d%02d%02d",
-                     dt->year, dt->month, dt->day,
-                     dt->hour, dt->minute, dt->second);
+    return fossil_emit(buffer, buffer_size, text,
+                       fossil_write_iso(dt, text, suffix, suffix_len));
+}
+
+int fossil_time_date_format_batch(
+    const fossil_time_date_t *dates,
+    size_t count,
+    char *buffer,
+    size_t stride,
+    const char *format_id
+) {
+    char designator[16];
+    size_t designator_len = 0;
+    int cached = 0;
+    int16_t cached_offset = 0;
+
+    if (count > 0 && (!dates || !buffer || stride == 0 || !format_id))
+        return -1;
+
+    for (size_t i = 0; i < count; ++i) {
+        char text[FOSSIL_DATE_MAX_ISO];
+        char *row = buffer + i * stride;
+        size_t n;
+
+        /* Rows sharing an offset share its designator */
+        if (!cached || dates[i].tz_offset_min != cached_offset) {
+            cached_offset = dates[i].tz_offset_min;
+            designator_len = fossil_put_offset(designator, cached_offset);
+            cached = 1;
+        }
+
+        n = fossil_write_iso(&dates[i], text, designator, designator_len);
+        if (n == 0)
+            fossil_time_date_format(&dates[i], row, stride, format_id);
+        else
+            fossil_emit(row, stride, text, n);
     }
 
-    return (int)n;
+    return 0;
+}
+
+int fossil_time_date_parse(
+    const char *text,
+    fossil_time_date_t *out
+) {
+    static const uint64_t sub_masks[8] = {
+        FOSSIL_TIME_PRECISION_MILLI, FOSSIL_TIME_PRECISION_MICRO,
+        FOSSIL_TIME_PRECISION_NANO,  FOSSIL_TIME_PRECISION_PICO,
+        FOSSIL_TIME_PRECISION_FEMTO, FOSSIL_TIME_PRECISION_ATTO,
+        FOSSIL_TIME_PRECISION_ZEPTO, FOSSIL_TIME_PRECISION_YOCTO
+    };
+    fossil_time_date_t dt;
+    const char *s = text;
+    int v;
+
+    if (!text || !out)
+        return -1;
+
+    memset(&dt, 0, sizeof(dt));
+    dt.weekday = -1;
+    dt.yearday = -1;
+
+    if (!fossil_read_digits(&s, 4, &v))
+        return -1;
+    dt.year = v;
+    dt.precision_mask = FOSSIL_TIME_PRECISION_YEAR;
+
+    if (*s == '-') {
+        s++;
+        if (!fossil_read_digits(&s, 2, &v))
+            return -1;
+        dt.month = (int8_t)v;
+        dt.precision_mask |= FOSSIL_TIME_PRECISION_MONTH;
+    }
+    if ((dt.precision_mask & FOSSIL_TIME_PRECISION_MONTH) && *s == '-') {
+        s++;
+        if (!fossil_read_digits(&s, 2, &v))
+            return -1;
+        dt.day = (int8_t)v;
+        dt.precision_mask |= FOSSIL_TIME_PRECISION_DAY;
+    }
+
+    if ((dt.precision_mask & FOSSIL_TIME_PRECISION_DAY) &&
+        (*s == 'T' || *s == 't' || *s == ' ')) {
+        s++;
+        if (!fossil_read_digits(&s, 2, &v))
+            return -1;
+        dt.hour = (int8_t)v;
+        dt.precision_mask |= FOSSIL_TIME_PRECISION_HOUR;
+
+        if (*s == ':') {
+            s++;
+            if (!fossil_read_digits(&s, 2, &v))
+                return -1;
+            dt.minute = (int8_t)v;
+            dt.precision_mask |= FOSSIL_TIME_PRECISION_MINUTE;
+
+            if (*s == ':') {
+                s++;
+                if (!fossil_read_digits(&s, 2, &v))
+                    return -1;
+                dt.second = (int8_t)v;
+                dt.precision_mask |= FOSSIL_TIME_PRECISION_SECOND;
+
+                /* Up to 24 fraction digits, three per sub-second field */
+                if (*s == '.' || *s == ',') {
+                    int16_t sub[8] = {0};
+                    int digits = 0;
+
+                    s++;
+                    while (*s >= '0' && *s <= '9') {
+                        if (digits == 24)
+                            return -1;
+                        sub[digits / 3] = (int16_t)(sub[digits / 3] * 10 + (*s++ - '0'));
+                        digits++;
+                    }
+                    if (digits == 0)
+                        return -1;
+                    for (int pad = digits; pad % 3 != 0; ++pad)
+                        sub[digits / 3] = (int16_t)(sub[digits / 3] * 10);
+                    for (int i = 0; i < (digits + 2) / 3; ++i)
+                        dt.precision_mask |= sub_masks[i];
+
+                    dt.millisecond = sub[0];
+                    dt.microsecond = sub[1];
+                    dt.nanosecond  = sub[2];
+                    dt.picosecond  = sub[3];
+                    dt.femtosecond = sub[4];
+                    dt.attosecond  = sub[5];
+                    dt.zeptosecond = sub[6];
+                    dt.yoctosecond = sub[7];
+                }
+            }
+        }
+
+        /* Designator: Z, +hh, +hhmm or +hh:mm */
+        if (*s == 'Z' || *s == 'z') {
+            s++;
+        } else if (*s == '+' || *s == '-') {
+            int sign = (*s++ == '-') ? -1 : 1;
+            int hh, mm = 0;
+
+            if (!fossil_read_digits(&s, 2, &hh))
+                return -1;
+            if (*s == ':') {
+                s++;
+                if (!fossil_read_digits(&s, 2, &mm))
+                    return -1;
+            } else if (*s >= '0' && *s <= '9') {
+                if (!fossil_read_digits(&s, 2, &mm))
+                    return -1;
+            }
+            if (hh > 23 || mm > 59)
+                return -1;
+            dt.tz_offset_min = (int16_t)(sign * (hh * 60 + mm));
+        }
+    }
+
+    if (*s != '\0' || !fossil_time_date_validate(&dt))
+        return -1;
+
+    if (dt.precision_mask & FOSSIL_TIME_PRECISION_DAY)
+        fossil_time_date_normalize(&dt);
+
+    *out = dt;
+    return 0;
 }
 
 int fossil_time_date_format_smart(
@@ -825,5 +1241,16 @@ int fossil_time_date_search(
             return dt->weekday == i;
     }
 
+    /* =========================================================
+     * COMPILED: relative windows and compound clauses
+     * ========================================================= */
+
+    {
+        fossil_time_query_t compiled;
+
+        if (fossil_time_query_compile(&compiled, query, now) == 0)
+            return fossil_time_query_match(&compiled, dt);
+    }
+
     return 0;
 }
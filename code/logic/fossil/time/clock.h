@@ -0,0 +1,186 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_TIME_CLOCK_H
+#define FOSSIL_TIME_CLOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ======================================================
+ * Fossil Time — Bounded Wall Clock
+ * ====================================================== */
+
+/*
+ * A reading of the wall clock as an interval that contains true time,
+ * in the style of Spanner's TrueTime. Two events whose intervals do not
+ * overlap are ordered without asking anyone else; a writer that waits out
+ * its own uncertainty ("commit wait") makes its timestamp safe to compare
+ * with any later reading on any node.
+ *
+ * The bound comes from the kernel's NTP discipline (adjtimex maxerror) on
+ * Linux, or from a fixed value set by the caller. Readings use the same
+ * timeline as fossil_time_date_now, smeared when leap smearing is on.
+ */
+typedef struct fossil_time_interval_t {
+    int64_t earliest;  /* epoch ns, true time is not before this */
+    int64_t latest;    /* epoch ns, true time is not after this */
+} fossil_time_interval_t;
+
+/* Passed to fossil_time_now_set_uncertainty to read the bound from the OS */
+#define FOSSIL_TIME_UNCERTAINTY_MEASURED (-1)
+
+/* ======================================================
+ * C API — Uncertainty
+ * ====================================================== */
+
+/**
+ * @brief Choose where the clock error bound comes from.
+ *
+ * @param error_ns A fixed bound in nanoseconds (>= 0), or
+ *                 FOSSIL_TIME_UNCERTAINTY_MEASURED (the default) to read
+ *                 it from the OS on every call.
+ * @return 0 on success, -1 for any other negative value.
+ */
+int fossil_time_now_set_uncertainty(int64_t error_ns);
+
+/**
+ * @brief Current clock error bound.
+ *
+ * @return Bound in nanoseconds, or -1 if it is measured and the OS does
+ *         not report one: non-Linux, adjtimex failed, or the clock is not
+ *         synchronized (TIME_ERROR or STA_UNSYNC), when the kernel's
+ *         maxerror is only a cap rather than a bound.
+ */
+int64_t fossil_time_now_uncertainty(void);
+
+/* ======================================================
+ * C API — Readings
+ * ====================================================== */
+
+/**
+ * @brief Read the wall clock as [earliest, latest].
+ *
+ * @param out Receives the interval.
+ * @return 0 on success, -1 if @p out is NULL or no bound is available.
+ */
+int fossil_time_now_interval(fossil_time_interval_t *out);
+
+/**
+ * @brief Whether an instant has definitely passed on every node.
+ *
+ * @param t_ns Epoch nanoseconds.
+ * @return 1 if the earliest possible now is after @p t_ns, 0 if not, -1 on error.
+ */
+int fossil_time_now_after(int64_t t_ns);
+
+/**
+ * @brief Whether an instant has definitely not arrived on any node.
+ *
+ * @param t_ns Epoch nanoseconds.
+ * @return 1 if the latest possible now is before @p t_ns, 0 if not, -1 on error.
+ */
+int fossil_time_now_before(int64_t t_ns);
+
+/**
+ * @brief Sleep until an instant has definitely passed.
+ *
+ * Sleeps the remaining uncertainty with fossil_time_sleep_nanoseconds and
+ * re-reads the clock until fossil_time_now_after(t_ns) holds. A commit
+ * stamped with the latest bound of a reading is safe to release after
+ * this returns.
+ *
+ * @param t_ns Epoch nanoseconds, usually the latest bound of a reading.
+ * @return 0 once @p t_ns has passed, -1 if no bound is available.
+ */
+int fossil_time_now_commit_wait(int64_t t_ns);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/* ======================================================
+ * C++ Wrapper — Thin, Inline
+ * ====================================================== */
+
+#ifdef __cplusplus
+namespace fossil {
+namespace time {
+
+class Clock {
+public:
+    Clock() = delete; /* static-only utility */
+
+    /**
+     * Use a fixed error bound in nanoseconds, or
+     * FOSSIL_TIME_UNCERTAINTY_MEASURED to ask the OS.
+     */
+    static inline bool set_uncertainty(int64_t error_ns) {
+        return fossil_time_now_set_uncertainty(error_ns) == 0;
+    }
+
+    /**
+     * Current error bound in nanoseconds, or -1 if unavailable.
+     */
+    static inline int64_t uncertainty() {
+        return fossil_time_now_uncertainty();
+    }
+
+    /**
+     * Read the wall clock as [earliest, latest]. Returns true on success.
+     */
+    static inline bool now(fossil_time_interval_t &out) {
+        return fossil_time_now_interval(&out) == 0;
+    }
+
+    /**
+     * Whether t_ns has definitely passed.
+     */
+    static inline bool after(int64_t t_ns) {
+        return fossil_time_now_after(t_ns) == 1;
+    }
+
+    /**
+     * Whether t_ns has definitely not arrived.
+     */
+    static inline bool before(int64_t t_ns) {
+        return fossil_time_now_before(t_ns) == 1;
+    }
+
+    /**
+     * Sleep until t_ns has definitely passed. Returns true on success.
+     */
+    static inline bool commit_wait(int64_t t_ns) {
+        return fossil_time_now_commit_wait(t_ns) == 0;
+    }
+};
+
+} /* namespace time */
+} /* namespace fossil */
+#endif
+
+#endif /* FOSSIL_TIME_CLOCK_H */
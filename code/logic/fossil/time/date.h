@@ -227,12 +227,29 @@ void fossil_time_date_from_unix_seconds(
     fossil_time_date_t *dt
 );
 
+/**
+ * @brief Populate a fossil_time_date_t structure from Unix time in nanoseconds.
+ *
+ * Pure integer civil arithmetic (no libc time functions), valid for the whole
+ * int64_t range. Fills the calendar, clock, millisecond, microsecond and
+ * nanosecond fields together with weekday and yearday, and sets the
+ * timezone offset to zero (UTC).
+ *
+ * @param nanoseconds The number of nanoseconds since the Unix epoch.
+ * @param dt Pointer to the fossil_time_date_t structure to populate.
+ */
+void fossil_time_date_from_unix_nanoseconds(
+    int64_t nanoseconds,
+    fossil_time_date_t *dt
+);
+
 /**
  * @brief Format a fossil_time_date_t structure as a string using a named format.
  *
  * This function formats the given fossil_time_date_t structure as a string according
  * to the specified format_id. Supported format_id values include:
- *   - "iso": ISO 8601 format (e.g., "2024-06-01T12:34:56Z")
+ *   - "iso": ISO 8601 format (e.g., "2024-06-01T12:34:56Z", or
+ *     "2024-06-01T14:34:56+02:00" when tz_offset_min is 120)
  *   - "iso_nano": ISO 8601 with nanoseconds
  *   - "human": Human-readable format (e.g., "June 1, 2024, 12:34 PM")
  *   - "short": Short form (e.g., "6/1/24 12:34")
@@ -254,6 +271,69 @@ int fossil_time_date_format(
     const char *format_id
 );
 
+/**
+ * @brief Format a date as ISO 8601 with a caller-chosen suffix.
+ *
+ * Same fields as the "iso" format, but the text after the time part is
+ * @p suffix instead of the designator for tz_offset_min: e.g. " CEST" to
+ * show a zone abbreviation, or "" for a floating local time. NULL keeps
+ * the designator ("Z" or "+hh:mm").
+ *
+ * @param dt          Pointer to the fossil_time_date_t structure to format.
+ * @param buffer      Output buffer for the formatted string.
+ * @param buffer_size Size of the output buffer in bytes.
+ * @param suffix      Text written after the time part, or NULL.
+ * @return Number of characters the full string needs (excluding null terminator),
+ *         or -1 on invalid arguments.
+ */
+int fossil_time_date_format_iso(
+    const fossil_time_date_t *dt,
+    char *buffer,
+    size_t buffer_size,
+    const char *suffix
+);
+
+/**
+ * @brief Format an array of dates into fixed-width rows.
+ *
+ * Row i is written to buffer + i * stride exactly as fossil_time_date_format
+ * would write it into a buffer of stride bytes. The offset designator is
+ * rendered once and reused for consecutive rows with the same tz_offset_min.
+ *
+ * @param dates     Array of dates.
+ * @param count     Number of elements.
+ * @param buffer    Output buffer of count * stride bytes.
+ * @param stride    Bytes per row, including the null terminator.
+ * @param format_id String identifier for the desired format.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_time_date_format_batch(
+    const fossil_time_date_t *dates,
+    size_t count,
+    char *buffer,
+    size_t stride,
+    const char *format_id
+);
+
+/**
+ * @brief Parse an ISO 8601 date or timestamp.
+ *
+ * Accepts the extended forms fossil_time_date_format writes:
+ * YYYY, YYYY-MM, YYYY-MM-DD, then optionally a 'T' (or space), hh[:mm[:ss
+ * [.fraction]]] and a designator "Z", "+hh", "+hhmm" or "+hh:mm". Up to 24
+ * fraction digits fill the sub-second fields. The precision mask records
+ * which fields were present, tz_offset_min the designator, and weekday and
+ * yearday are derived when a day is present. Hand-written; no scanf.
+ *
+ * @param text Null-terminated input; all of it must be consumed.
+ * @param out  Receives the parsed date.
+ * @return 0 on success, -1 on malformed input or out-of-range fields.
+ */
+int fossil_time_date_parse(
+    const char *text,
+    fossil_time_date_t *out
+);
+
 /**
  * @brief Format a fossil_time_date_t structure in a context-aware, human-friendly way.
  *
@@ -310,6 +390,16 @@ int fossil_time_date_format_relative(
  * Relative expressions (require @p now):
  *   "past", "future", "before today", "after now",
  *   "in the past", "in the future"
+ * 
+ * Relative windows (require @p now, see fossil_time_query_compile):
+ *   "yesterday", "this week", "this month", "previous quarter",
+ *   "last 7 days", "next 3 hours"
+ * 
+ * Calendar facts (see fossil_time_query_compile):
+ *   "business day", "holiday us", "last business day of month", "quarter = 2"
+ *
+ * Compound queries joining any of the above with "and":
+ *   "weekday and hour >= 9 and last 30 days"
  *
  * Field comparison expressions using symbolic or English operators:
  *   "year = 2025"
@@ -561,6 +651,15 @@ namespace fossil {
                 fossil_time_date_from_unix_seconds(seconds, &raw);
             }
 
+            /**
+             * @brief Populate this Date object from Unix time in nanoseconds.
+             * Fills calendar, clock and sub-second fields down to nanoseconds.
+             * @param nanoseconds Number of nanoseconds since the Unix epoch.
+             */
+            inline void from_unix_nanoseconds(int64_t nanoseconds) {
+                fossil_time_date_from_unix_nanoseconds(nanoseconds, &raw);
+            }
+
             /* ======================================================
              * Formatting
              * ====================================================== */
@@ -582,6 +681,30 @@ namespace fossil {
                 return fossil_time_date_format(&raw, buffer, buffer_size, format_id);
             }
 
+            /**
+             * @brief Format this Date object as ISO 8601 with a custom suffix.
+             * @param buffer Output buffer for the formatted string.
+             * @param buffer_size Size of the output buffer in bytes.
+             * @param suffix Text after the time part, or nullptr for the offset designator.
+             * @return Number of characters the full string needs, or -1 on error.
+             */
+            inline int format_iso(
+            char *buffer,
+            size_t buffer_size,
+            const char *suffix = nullptr
+            ) const {
+                return fossil_time_date_format_iso(&raw, buffer, buffer_size, suffix);
+            }
+
+            /**
+             * @brief Populate this Date object from an ISO 8601 string.
+             * @param text Null-terminated input.
+             * @return true if the whole string parsed.
+             */
+            inline bool parse(const char *text) {
+                return fossil_time_date_parse(text, &raw) == 0;
+            }
+
             /**
              * @brief Format this Date object in a context-aware, human-friendly way.
              * Produces a context-sensitive string relative to the provided "now" date/time.
@@ -635,6 +758,16 @@ namespace fossil {
              * Relative expressions (require @p now):
              *   "past", "future", "before today", "after now",
              *   "in the past", "in the future"
+             * 
+             * Relative windows (require @p now, see fossil_time_query_compile):
+             *   "yesterday", "this week", "this month", "previous quarter",
+             *   "last 7 days", "next 3 hours"
+             * 
+             * Calendar facts (see fossil_time_query_compile):
+             *   "business day", "holiday us", "last business day of month", "quarter = 2"
+             *
+             * Compound queries joining any of the above with "and":
+             *   "weekday and hour >= 9 and last 30 days"
              *
              * Field comparison expressions using symbolic or English operators:
              *   "year = 2025"
@@ -32,5 +32,10 @@
 #include "span.h"
 #include "season.h"
 #include "holiday.h"
+#include "index.h"
+#include "query.h"
+#include "zone.h"
+#include "leap.h"
+#include "clock.h"
 
 #endif /* FOSSIL_TIME_FRAMEWORK_H */
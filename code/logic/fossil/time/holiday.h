@@ -115,6 +115,17 @@ int fossil_holiday_is(const fossil_time_date_t *date, const char **out_name);
  */
 int fossil_holiday_list(int year, fossil_time_date_t *out_dates, size_t max_entries, size_t *out_count);
 
+/**
+ * @brief Number of registered holidays.
+ *
+ * The registry only grows, so the count also identifies its current
+ * contents; callers caching derived holiday data can compare it to
+ * detect new registrations.
+ *
+ * @return Number of holidays in the registry.
+ */
+size_t fossil_holiday_count(void);
+
 #ifdef __cplusplus
 } /* extern "C" */
 
@@ -230,6 +241,15 @@ namespace fossil::time {
             vec.resize(count);
             return vec;
         }
+
+        /**
+         * @brief Number of registered holidays.
+         *
+         * @return Number of holidays in the fossil holiday registry.
+         */
+        static size_t count() {
+            return fossil_holiday_count();
+        }
     };
 
 } /* namespace fossil */
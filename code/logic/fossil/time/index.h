@@ -0,0 +1,240 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_TIME_INDEX_H
+#define FOSSIL_TIME_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "date.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ======================================================
+ * Fossil Time — Sorted Timestamp Index
+ * ====================================================== */
+
+/*
+ * Read-only search index over a sorted column of epoch-ns timestamps.
+ *
+ * Keys are stored in Eytzinger (BFS) order so the first levels of every
+ * search share the same few cache lines, and the descent is branchless
+ * with the next levels prefetched ahead of the comparisons. Lookups
+ * return ranks, i.e. positions in the original sorted input, so callers
+ * can index their own parallel arrays directly.
+ */
+typedef struct fossil_time_index_t {
+    int64_t *keys;    /* Eytzinger-ordered keys, 1-based (keys[0] unused) */
+    size_t  *ranks;   /* sorted position of each Eytzinger slot */
+    size_t   count;   /* number of indexed timestamps */
+    void    *storage; /* single backing allocation */
+} fossil_time_index_t;
+
+/* ======================================================
+ * C API — Construction
+ * ====================================================== */
+
+/**
+ * @brief Build an index from a sorted array of epoch-ns timestamps.
+ *
+ * The input must be sorted in non-decreasing order; duplicates are allowed.
+ * The values are copied, so the source array may be released afterwards.
+ * Any previous contents of @p index are released first.
+ *
+ * @param index    Pointer to the index to build.
+ * @param epoch_ns Sorted array of nanoseconds since the Unix epoch.
+ * @param count    Number of elements in @p epoch_ns.
+ * @return 0 on success, -1 on invalid or unsorted input or allocation failure.
+ */
+int fossil_time_index_build(
+    fossil_time_index_t *index,
+    const int64_t *epoch_ns,
+    size_t count
+);
+
+/**
+ * @brief Build an index from a sorted array of fossil_time_date_t structures.
+ *
+ * Each date is converted with fossil_time_date_to_unix_nanoseconds, so the
+ * timezone offset and sub-second precision of every element are honored.
+ * The converted values must be in non-decreasing order.
+ *
+ * @param index Pointer to the index to build.
+ * @param dates Sorted array of dates.
+ * @param count Number of elements in @p dates.
+ * @return 0 on success, -1 on invalid or unsorted input or allocation failure.
+ */
+int fossil_time_index_build_dates(
+    fossil_time_index_t *index,
+    const fossil_time_date_t *dates,
+    size_t count
+);
+
+/**
+ * @brief Release all memory held by an index and reset it to empty.
+ *
+ * @param index Pointer to the index to release (may be NULL).
+ */
+void fossil_time_index_free(
+    fossil_time_index_t *index
+);
+
+/* ======================================================
+ * C API — Lookup
+ * ====================================================== */
+
+/**
+ * @brief Find the first timestamp not less than a key.
+ *
+ * Equivalent to std::lower_bound over the original sorted input.
+ *
+ * @param index    Pointer to a built index.
+ * @param epoch_ns Key in nanoseconds since the Unix epoch.
+ * @return Rank of the first element >= key, or index->count if none.
+ */
+size_t fossil_time_index_lower_bound(
+    const fossil_time_index_t *index,
+    int64_t epoch_ns
+);
+
+/**
+ * @brief Find the first timestamp greater than a key.
+ *
+ * Equivalent to std::upper_bound over the original sorted input. An as-of
+ * lookup (latest element at or before the key) is the returned rank minus
+ * one, when the returned rank is nonzero.
+ *
+ * @param index    Pointer to a built index.
+ * @param epoch_ns Key in nanoseconds since the Unix epoch.
+ * @return Rank of the first element > key, or index->count if none.
+ */
+size_t fossil_time_index_upper_bound(
+    const fossil_time_index_t *index,
+    int64_t epoch_ns
+);
+
+/**
+ * @brief Find the timestamp closest to a key.
+ *
+ * When two elements are equally distant the earlier one wins; among equal
+ * keys the first occurrence is returned.
+ *
+ * @param index    Pointer to a built index.
+ * @param epoch_ns Key in nanoseconds since the Unix epoch.
+ * @return Rank of the nearest element, or index->count if the index is empty.
+ */
+size_t fossil_time_index_nearest(
+    const fossil_time_index_t *index,
+    int64_t epoch_ns
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/* ======================================================
+ * C++ Wrapper — Thin, Inline
+ * ====================================================== */
+
+#ifdef __cplusplus
+namespace fossil {
+namespace time {
+
+class Index {
+public:
+    fossil_time_index_t raw;
+
+    /**
+     * Default constructor.
+     * Initializes an empty index.
+     */
+    Index() : raw() { }
+
+    /**
+     * Destructor.
+     * Releases the memory held by the index.
+     */
+    ~Index() {
+        fossil_time_index_free(&raw);
+    }
+
+    Index(const Index &) = delete;
+    Index &operator=(const Index &) = delete;
+
+    /**
+     * Build the index from a sorted array of epoch-ns timestamps.
+     * Returns true on success, false on unsorted input or allocation failure.
+     */
+    inline bool build(const int64_t *epoch_ns, size_t count) {
+        return fossil_time_index_build(&raw, epoch_ns, count) == 0;
+    }
+
+    /**
+     * Build the index from a sorted array of dates.
+     * Returns true on success, false on unsorted input or allocation failure.
+     */
+    inline bool build(const Date *dates, size_t count) {
+        static_assert(sizeof(Date) == sizeof(fossil_time_date_t),
+                      "Date must wrap fossil_time_date_t without padding");
+        return fossil_time_index_build_dates(
+            &raw, reinterpret_cast<const fossil_time_date_t *>(dates), count
+        ) == 0;
+    }
+
+    /**
+     * Number of indexed timestamps.
+     */
+    inline size_t size() const {
+        return raw.count;
+    }
+
+    /**
+     * Rank of the first element not less than the key, or size() if none.
+     */
+    inline size_t lower_bound(int64_t epoch_ns) const {
+        return fossil_time_index_lower_bound(&raw, epoch_ns);
+    }
+
+    /**
+     * Rank of the first element greater than the key, or size() if none.
+     */
+    inline size_t upper_bound(int64_t epoch_ns) const {
+        return fossil_time_index_upper_bound(&raw, epoch_ns);
+    }
+
+    /**
+     * Rank of the element closest to the key, or size() if empty.
+     */
+    inline size_t nearest(int64_t epoch_ns) const {
+        return fossil_time_index_nearest(&raw, epoch_ns);
+    }
+};
+
+} /* namespace time */
+} /* namespace fossil */
+#endif
+
+#endif /* FOSSIL_TIME_INDEX_H */
@@ -0,0 +1,313 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_TIME_LEAP_H
+#define FOSSIL_TIME_LEAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "date.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ======================================================
+ * Fossil Time — Leap Seconds and Time Scales
+ * ====================================================== */
+
+/*
+ * The leap-second table lists each instant (Unix seconds, UTC) from which
+ * a new TAI−UTC offset applies: 10 s from 1972-01-01, 37 s since
+ * 2017-01-01. A built-in copy ships with the library and an updated
+ * leap-seconds.list (IERS/NIST format) can be loaded at run time.
+ *
+ * Epoch-ns values on the three scales:
+ *   - UTC: POSIX nanoseconds since 1970-01-01T00:00:00Z, leap seconds not
+ *          counted (what fossil_time_date_to_unix_nanoseconds returns)
+ *   - TAI: UTC + (TAI−UTC), the CLOCK_TAI convention
+ *   - GPS: nanoseconds since the GPS epoch 1980-01-06T00:00:00Z; TAI − 19 s
+ *
+ * POSIX time cannot name an inserted leap second: converting an instant
+ * inside one to UTC repeats the 23:59:59 second before it, as the Linux
+ * kernel clock does. Instants before 1972 use the 1972 offset.
+ *
+ * Smearing is opt-in: with a window set, each leap second is spread
+ * linearly over that many seconds centred on it, so the smeared clock
+ * never repeats a second or shows :60. It then also applies to
+ * fossil_time_date_now and the fossil_time_date unix conversions, which
+ * read unix timestamps as POSIX UTC and dates as smeared civil time.
+ */
+
+typedef enum fossil_time_scale_t {
+    FOSSIL_TIME_SCALE_UTC = 0,
+    FOSSIL_TIME_SCALE_TAI,
+    FOSSIL_TIME_SCALE_GPS,
+    FOSSIL_TIME_SCALE_SMEAR  /* UTC smeared over the configured window; UTC when off */
+} fossil_time_scale_t;
+
+/* ======================================================
+ * C API — Table
+ * ====================================================== */
+
+/**
+ * @brief Load a leap-seconds.list file, replacing the current table.
+ *
+ * Reads data lines ("<NTP seconds> <TAI-UTC>") and the "#@" expiry line.
+ * Readers running concurrently keep using the table they started with.
+ *
+ * @param path Path to the file, e.g. "/usr/share/zoneinfo/leap-seconds.list".
+ * @return Number of entries loaded, or -1 if the file is missing or malformed.
+ */
+int fossil_time_leap_load(const char *path);
+
+/**
+ * @brief Restore the table built into the library.
+ */
+void fossil_time_leap_reset(void);
+
+/**
+ * @brief Number of entries in the current table.
+ */
+size_t fossil_time_leap_count(void);
+
+/**
+ * @brief Unix seconds after which the current table is no longer known good.
+ *
+ * @return Expiry in Unix seconds, or 0 if the loaded file did not state one.
+ */
+int64_t fossil_time_leap_expires(void);
+
+/**
+ * @brief TAI−UTC in seconds at a UTC instant.
+ *
+ * @param utc_seconds Unix seconds.
+ * @return Offset in seconds (10 before 1972, 37 since 2017).
+ */
+int32_t fossil_time_leap_tai_offset(int64_t utc_seconds);
+
+/**
+ * @brief Find the first leap second taking effect strictly after a UTC instant.
+ *
+ * @param utc_seconds Unix seconds.
+ * @param out_utc     Receives the Unix second from which the new offset applies
+ *                    (the midnight following the leap second).
+ * @param out_delta   Receives the change: +1 for an inserted second, -1 for a removed one.
+ * @return 0 on success, -1 if the table has no later leap second.
+ */
+int fossil_time_leap_next(int64_t utc_seconds, int64_t *out_utc, int32_t *out_delta);
+
+/**
+ * @brief Find the last leap second taking effect at or before a UTC instant.
+ *
+ * The 1972 start of the table is not a leap second and is never returned.
+ *
+ * @param utc_seconds Unix seconds.
+ * @param out_utc     Receives the Unix second from which that offset applies.
+ * @param out_delta   Receives the change: +1 for an inserted second, -1 for a removed one.
+ * @return 0 on success, -1 if no leap second precedes the instant.
+ */
+int fossil_time_leap_prev(int64_t utc_seconds, int64_t *out_utc, int32_t *out_delta);
+
+/**
+ * @brief Whether a date with second == 60 names a leap second that happened.
+ *
+ * The date is read in its own offset (tz_offset_min), so 23:59:60Z and
+ * 00:59:60+01:00 on 2016-12-31 both qualify.
+ *
+ * @param dt Date to check.
+ * @return Nonzero if it is an inserted leap second, 0 otherwise.
+ */
+int fossil_time_leap_second_valid(const fossil_time_date_t *dt);
+
+/* ======================================================
+ * C API — Smearing
+ * ====================================================== */
+
+/**
+ * @brief Turn leap smearing on or off for the whole process.
+ *
+ * A 24 h window (86400) matches the common public smear. While a window
+ * is set, fossil_time_date_now and the fossil_time_date unix conversions
+ * go through FOSSIL_TIME_SCALE_SMEAR.
+ *
+ * @param window_seconds Smear length from 2 s to 7 days, or 0 to turn it off.
+ * @return 0 on success, -1 if the window is out of range.
+ */
+int fossil_time_leap_set_smear(int64_t window_seconds);
+
+/**
+ * @brief Current smear window in seconds, or 0 when smearing is off.
+ */
+int64_t fossil_time_leap_smear_window(void);
+
+/**
+ * @brief Smear a reading of the system realtime clock.
+ *
+ * Converts UTC to FOSSIL_TIME_SCALE_SMEAR, except that inside a smear
+ * window a reading never returns less than an earlier one in this process.
+ * This hides the kernel replaying 23:59:59 during an inserted second,
+ * which shows as a one-second pause instead of a step back.
+ *
+ * @param utc_ns Realtime clock reading, epoch nanoseconds.
+ * @return Smeared epoch nanoseconds, or @p utc_ns when smearing is off.
+ */
+int64_t fossil_time_leap_smear_clock(int64_t utc_ns);
+
+/* ======================================================
+ * C API — Conversions
+ * ====================================================== */
+
+/**
+ * @brief Convert epoch nanoseconds between time scales.
+ *
+ * @param ns   Nanoseconds on the @p from scale.
+ * @param from Source scale.
+ * @param to   Target scale.
+ * @return Nanoseconds on the @p to scale, or INT64_MIN for an unknown scale
+ *         or when the result (or the TAI instant between) leaves the int64
+ *         range.
+ */
+int64_t fossil_time_leap_convert(int64_t ns, fossil_time_scale_t from, fossil_time_scale_t to);
+
+/**
+ * @brief Convert a column of epoch nanoseconds between time scales.
+ *
+ * Keeps the current table segment across rows, so sorted input only
+ * searches the table when it crosses a leap second. @p in and @p out may
+ * be the same array.
+ *
+ * @param in    Nanoseconds on the @p from scale.
+ * @param count Number of elements.
+ * @param from  Source scale.
+ * @param to    Target scale.
+ * @param out   Receives nanoseconds on the @p to scale; rows whose result
+ *              leaves the int64 range receive INT64_MIN, as in
+ *              fossil_time_leap_convert.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_time_leap_convert_batch(
+    const int64_t *in,
+    size_t count,
+    fossil_time_scale_t from,
+    fossil_time_scale_t to,
+    int64_t *out
+);
+
+/** @brief UTC epoch-ns to TAI epoch-ns. */
+int64_t fossil_time_leap_utc_to_tai(int64_t utc_ns);
+
+/** @brief TAI epoch-ns to UTC epoch-ns. */
+int64_t fossil_time_leap_tai_to_utc(int64_t tai_ns);
+
+/** @brief UTC epoch-ns to nanoseconds since the GPS epoch. */
+int64_t fossil_time_leap_utc_to_gps(int64_t utc_ns);
+
+/** @brief Nanoseconds since the GPS epoch to UTC epoch-ns. */
+int64_t fossil_time_leap_gps_to_utc(int64_t gps_ns);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/* ======================================================
+ * C++ Wrapper — Thin, Inline
+ * ====================================================== */
+
+#ifdef __cplusplus
+namespace fossil {
+namespace time {
+
+class Leap {
+public:
+    Leap() = delete; /* static-only utility */
+
+    /**
+     * Load a leap-seconds.list file; returns the entry count or -1.
+     */
+    static inline int load(const char *path) {
+        return fossil_time_leap_load(path);
+    }
+
+    /**
+     * Restore the built-in table.
+     */
+    static inline void reset() {
+        fossil_time_leap_reset();
+    }
+
+    /**
+     * TAI−UTC in seconds at a UTC instant.
+     */
+    static inline int32_t tai_offset(int64_t utc_seconds) {
+        return fossil_time_leap_tai_offset(utc_seconds);
+    }
+
+    /**
+     * Whether a date names a leap second that happened.
+     */
+    static inline bool second_valid(const Date &dt) {
+        return fossil_time_leap_second_valid(&dt.raw) != 0;
+    }
+
+    /**
+     * Convert epoch nanoseconds between time scales.
+     */
+    static inline int64_t convert(int64_t ns, fossil_time_scale_t from, fossil_time_scale_t to) {
+        return fossil_time_leap_convert(ns, from, to);
+    }
+
+    /**
+     * Convert a column between time scales. Returns true on success.
+     */
+    static inline bool convert(const int64_t *in, size_t count, fossil_time_scale_t from,
+                               fossil_time_scale_t to, int64_t *out) {
+        return fossil_time_leap_convert_batch(in, count, from, to, out) == 0;
+    }
+
+    /**
+     * Turn leap smearing on (2 s to 7 days) or off (0).
+     */
+    static inline bool set_smear(int64_t window_seconds) {
+        return fossil_time_leap_set_smear(window_seconds) == 0;
+    }
+
+    /**
+     * Current smear window in seconds, 0 when off.
+     */
+    static inline int64_t smear_window() {
+        return fossil_time_leap_smear_window();
+    }
+
+    static inline int64_t utc_to_tai(int64_t utc_ns) { return fossil_time_leap_utc_to_tai(utc_ns); }
+    static inline int64_t tai_to_utc(int64_t tai_ns) { return fossil_time_leap_tai_to_utc(tai_ns); }
+    static inline int64_t utc_to_gps(int64_t utc_ns) { return fossil_time_leap_utc_to_gps(utc_ns); }
+    static inline int64_t gps_to_utc(int64_t gps_ns) { return fossil_time_leap_gps_to_utc(gps_ns); }
+};
+
+} /* namespace time */
+} /* namespace fossil */
+#endif
+
+#endif /* FOSSIL_TIME_LEAP_H */
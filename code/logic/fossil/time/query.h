@@ -0,0 +1,506 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_TIME_QUERY_H
+#define FOSSIL_TIME_QUERY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "date.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ======================================================
+ * Fossil Time — Compiled Date Queries
+ * ====================================================== */
+
+/*
+ * A compiled query is the search DSL of fossil_time_date_search resolved
+ * once into flat clauses. Relative windows ("last 7 days", "this month")
+ * become concrete [start, end) epoch-ns ranges for a given "now", and
+ * field tests become half-open integer intervals, so evaluating a record
+ * is a couple of integer comparisons per clause with no string handling.
+ *
+ * Clauses are joined with "and"; a record matches when every clause does.
+ * The clauses are held inline and may be copied freely; the optional
+ * profiling counters are borrowed, so copies of a profiled query update the
+ * same fossil_time_query_stats_t. Those updates are not atomic: detach the
+ * counters (fossil_time_query_profile with NULL) on a copy evaluated on
+ * another thread, or give it counters of its own.
+ */
+
+#define FOSSIL_TIME_QUERY_MAX_CLAUSES 8
+
+/**
+ * @brief Kind of a compiled clause.
+ */
+typedef enum fossil_time_query_kind_t {
+    FOSSIL_TIME_QUERY_RANGE = 0,     /* epoch ns in [lo, hi) */
+    FOSSIL_TIME_QUERY_FIELD,         /* field value in [lo, hi), optionally negated */
+    FOSSIL_TIME_QUERY_LEAP_YEAR,     /* year is a leap year */
+    FOSSIL_TIME_QUERY_LAST_OF_MONTH, /* day is the last day of its month */
+    FOSSIL_TIME_QUERY_CALENDAR       /* day is in calendar set lo for region hi */
+} fossil_time_query_kind_t;
+
+/**
+ * @brief Date field referenced by a field clause.
+ */
+typedef enum fossil_time_query_field_t {
+    FOSSIL_TIME_QUERY_FIELD_YEAR = 0,
+    FOSSIL_TIME_QUERY_FIELD_MONTH,
+    FOSSIL_TIME_QUERY_FIELD_DAY,
+    FOSSIL_TIME_QUERY_FIELD_HOUR,
+    FOSSIL_TIME_QUERY_FIELD_MINUTE,
+    FOSSIL_TIME_QUERY_FIELD_SECOND,
+    FOSSIL_TIME_QUERY_FIELD_WEEKDAY,
+    FOSSIL_TIME_QUERY_FIELD_YEARDAY,
+    FOSSIL_TIME_QUERY_FIELD_MILLISECOND,
+    FOSSIL_TIME_QUERY_FIELD_MICROSECOND,
+    FOSSIL_TIME_QUERY_FIELD_NANOSECOND,
+    FOSSIL_TIME_QUERY_FIELD_TZ_OFFSET,
+    FOSSIL_TIME_QUERY_FIELD_QUARTER
+} fossil_time_query_field_t;
+
+/**
+ * @brief Calendar day set referenced by a calendar clause.
+ *
+ * Sets are precomputed per year as 366-bit day bitmaps, so a calendar
+ * clause costs one bit test on the record's day of the year.
+ */
+typedef enum fossil_time_query_calendar_t {
+    FOSSIL_TIME_QUERY_CALENDAR_WEEKEND = 0,
+    FOSSIL_TIME_QUERY_CALENDAR_HOLIDAY,
+    FOSSIL_TIME_QUERY_CALENDAR_BUSINESS_DAY,            /* not weekend, not holiday */
+    FOSSIL_TIME_QUERY_CALENDAR_FIRST_BUSINESS_OF_MONTH,
+    FOSSIL_TIME_QUERY_CALENDAR_LAST_BUSINESS_OF_MONTH
+} fossil_time_query_calendar_t;
+
+/**
+ * @brief Holiday source of a calendar clause (stored in the clause's hi).
+ */
+typedef enum fossil_time_query_region_t {
+    FOSSIL_TIME_QUERY_REGION_REGISTRY = 0,  /* fossil_holiday_* registry */
+    FOSSIL_TIME_QUERY_REGION_US,            /* fossil_time_calendar "us" */
+    FOSSIL_TIME_QUERY_REGION_UK,            /* fossil_time_calendar "uk" */
+    FOSSIL_TIME_QUERY_REGION_CA             /* fossil_time_calendar "ca" */
+} fossil_time_query_region_t;
+
+/**
+ * @brief One compiled clause.
+ */
+typedef struct fossil_time_query_clause_t {
+    fossil_time_query_kind_t  kind;
+    fossil_time_query_field_t field;  /* for FOSSIL_TIME_QUERY_FIELD */
+    int32_t negate;                   /* nonzero inverts the clause */
+    int64_t lo;                       /* inclusive lower bound */
+    int64_t hi;                       /* exclusive upper bound */
+} fossil_time_query_clause_t;
+
+/**
+ * @brief Profiling counters of one clause.
+ *
+ * Clauses are evaluated in order and evaluation stops at the first clause
+ * that fails, so a clause's evaluations equal the records that passed
+ * every clause before it. Selectivity is passed / evaluations.
+ */
+typedef struct fossil_time_query_clause_stats_t {
+    uint64_t evaluations;
+    uint64_t passed;
+    uint64_t elapsed_ns;              /* cumulative, via fossil_time_timer_t */
+} fossil_time_query_clause_stats_t;
+
+/**
+ * @brief Profiling counters of a compiled query.
+ */
+typedef struct fossil_time_query_stats_t {
+    uint64_t records;
+    uint64_t matched;
+    uint64_t elapsed_ns;              /* sum of the clause times */
+    fossil_time_query_clause_stats_t clauses[FOSSIL_TIME_QUERY_MAX_CLAUSES];
+} fossil_time_query_stats_t;
+
+/**
+ * @brief A compiled query: a conjunction of clauses.
+ *
+ * When @c stats is non-NULL (see fossil_time_query_profile) every
+ * evaluation updates it. Copies of a profiled query share the counters.
+ */
+typedef struct fossil_time_query_t {
+    size_t clause_count;
+    fossil_time_query_clause_t clauses[FOSSIL_TIME_QUERY_MAX_CLAUSES];
+    fossil_time_query_stats_t *stats;
+} fossil_time_query_t;
+
+/* ======================================================
+ * C API — Compilation
+ * ====================================================== */
+
+/**
+ * @brief Compile a query string into flat clauses.
+ *
+ * Accepts everything fossil_time_date_search accepts, clauses joined with
+ * "and", plus relative windows that are resolved against @p now:
+ *
+ * Calendar-aligned periods (unit = minute, hour, day, week, month,
+ * quarter, year; weeks start on Monday):
+ *   "this week", "current month", "last quarter", "previous year",
+ *   "next month", "today", "yesterday", "tomorrow"
+ *
+ * Rolling windows ending or starting at @p now:
+ *   "last 7 days", "past 24 hours", "previous 3 months",
+ *   "next 15 minutes", "next 2 weeks"
+ *
+ * Open windows:
+ *   "past", "future", "before now", "after now"
+ *
+ * Calendar facts, optionally followed by a region ("us", "uk", "ca";
+ * without one the fossil_holiday registry is used) and optionally
+ * prefixed with "not":
+ *   "holiday", "holiday us", "business day", "not business day uk",
+ *   "first business day of month", "last business day of month"
+ * and the quarter field: "quarter = 2", "quarter in 1..2".
+ *
+ * Periods are computed in the wall-clock frame of @p now, honoring its
+ * tz_offset_min. Matching is case-insensitive.
+ *
+ * @param query Pointer to the query to fill.
+ * @param text  Query string.
+ * @param now   Reference date/time for relative windows (may be NULL when
+ *              the query has none).
+ * @return 0 on success, -1 if the query is malformed, unsupported, has too
+ *         many clauses, or needs @p now and none was given.
+ */
+int fossil_time_query_compile(
+    fossil_time_query_t *query,
+    const char *text,
+    const fossil_time_date_t *now
+);
+
+/* ======================================================
+ * C API — Evaluation
+ * ====================================================== */
+
+/**
+ * @brief Evaluate a compiled query against a date structure.
+ *
+ * Range clauses use fossil_time_date_to_unix_nanoseconds of @p dt; field
+ * clauses read the structure fields directly, as fossil_time_date_search does.
+ *
+ * @param query Pointer to a compiled query.
+ * @param dt    Pointer to the date to test.
+ * @return Nonzero if every clause matches; 0 otherwise.
+ */
+int fossil_time_query_match(
+    const fossil_time_query_t *query,
+    const fossil_time_date_t *dt
+);
+
+/**
+ * @brief Evaluate a compiled query against a UTC epoch-ns timestamp.
+ *
+ * Range clauses are two integer comparisons. Field clauses are evaluated
+ * on the UTC civil breakdown of the timestamp.
+ *
+ * @param query    Pointer to a compiled query.
+ * @param epoch_ns Nanoseconds since the Unix epoch.
+ * @return Nonzero if every clause matches; 0 otherwise.
+ */
+int fossil_time_query_match_ns(
+    const fossil_time_query_t *query,
+    int64_t epoch_ns
+);
+
+/**
+ * @brief Intersect all range clauses of a compiled query.
+ *
+ * Useful for narrowing a scan with a sorted index before evaluating the
+ * remaining clauses. A query without range clauses yields the full range.
+ *
+ * @param query     Pointer to a compiled query.
+ * @param out_start Receives the inclusive start in epoch ns.
+ * @param out_end   Receives the exclusive end in epoch ns.
+ * @return Nonzero if the range is non-empty; 0 if it is empty or on error.
+ */
+int fossil_time_query_bounds(
+    const fossil_time_query_t *query,
+    int64_t *out_start,
+    int64_t *out_end
+);
+
+/* ======================================================
+ * C API — Bulk evaluation
+ * ====================================================== */
+
+/*
+ * Bulk scans split the input into contiguous chunks, one per worker, and
+ * evaluate the compiled query on each chunk in parallel. Chunk boundaries
+ * are multiples of 64 rows, so every worker owns whole bitmap words and
+ * results are identical, and identically ordered, for any worker count.
+ *
+ * Bitmaps hold (count + 63) / 64 words; bit (i % 64) of word (i / 64) is
+ * set when row i matches. A worker count of 0 uses one worker per online
+ * processor. Small inputs use fewer workers than requested.
+ */
+
+/**
+ * @brief Evaluate a compiled query over a column of epoch-ns timestamps.
+ *
+ * @param query      Pointer to a compiled query.
+ * @param epoch_ns   Array of nanoseconds since the Unix epoch.
+ * @param count      Number of elements in @p epoch_ns.
+ * @param workers    Number of worker threads, or 0 for one per processor.
+ * @param out_bitmap Output bitmap of (count + 63) / 64 words.
+ * @return Number of matching rows, or -1 on invalid arguments.
+ */
+int64_t fossil_time_query_scan_ns(
+    const fossil_time_query_t *query,
+    const int64_t *epoch_ns,
+    size_t count,
+    size_t workers,
+    uint64_t *out_bitmap
+);
+
+/**
+ * @brief Evaluate a compiled query over an array of dates.
+ *
+ * @param query      Pointer to a compiled query.
+ * @param dates      Array of dates.
+ * @param count      Number of elements in @p dates.
+ * @param workers    Number of worker threads, or 0 for one per processor.
+ * @param out_bitmap Output bitmap of (count + 63) / 64 words.
+ * @return Number of matching rows, or -1 on invalid arguments.
+ */
+int64_t fossil_time_query_scan_dates(
+    const fossil_time_query_t *query,
+    const fossil_time_date_t *dates,
+    size_t count,
+    size_t workers,
+    uint64_t *out_bitmap
+);
+
+/**
+ * @brief Collect the positions of matching epoch-ns timestamps.
+ *
+ * Positions are written in ascending order. @p out_index must have room
+ * for @p count entries, since every row may match.
+ *
+ * @param query     Pointer to a compiled query.
+ * @param epoch_ns  Array of nanoseconds since the Unix epoch.
+ * @param count     Number of elements in @p epoch_ns.
+ * @param workers   Number of worker threads, or 0 for one per processor.
+ * @param out_index Output array of matching row positions.
+ * @return Number of positions written, or -1 on invalid arguments.
+ */
+int64_t fossil_time_query_select_ns(
+    const fossil_time_query_t *query,
+    const int64_t *epoch_ns,
+    size_t count,
+    size_t workers,
+    size_t *out_index
+);
+
+/**
+ * @brief Collect the positions of matching dates.
+ *
+ * Positions are written in ascending order. @p out_index must have room
+ * for @p count entries, since every row may match.
+ *
+ * @param query     Pointer to a compiled query.
+ * @param dates     Array of dates.
+ * @param count     Number of elements in @p dates.
+ * @param workers   Number of worker threads, or 0 for one per processor.
+ * @param out_index Output array of matching row positions.
+ * @return Number of positions written, or -1 on invalid arguments.
+ */
+int64_t fossil_time_query_select_dates(
+    const fossil_time_query_t *query,
+    const fossil_time_date_t *dates,
+    size_t count,
+    size_t workers,
+    size_t *out_index
+);
+
+/* ======================================================
+ * C API — Profiling
+ * ====================================================== */
+
+/**
+ * @brief Enable or disable profiling of a compiled query.
+ *
+ * Resets @p stats and attaches it to @p query; every later evaluation,
+ * including bulk scans, counts each clause's evaluations and passes and
+ * times it with fossil_time_timer_t. Bulk scans keep per-worker counters
+ * and add them to @p stats when the scan completes. Profiling costs a
+ * monotonic clock read per clause, so leave it off in production paths.
+ *
+ * Compiling a query detaches its counters.
+ *
+ * @param query Pointer to a compiled query.
+ * @param stats Counters to attach, or NULL to disable profiling.
+ * @return 0 on success, -1 if @p query is NULL.
+ */
+int fossil_time_query_profile(
+    fossil_time_query_t *query,
+    fossil_time_query_stats_t *stats
+);
+
+/**
+ * @brief Describe a compiled query and its profiling counters.
+ *
+ * Writes one line per clause with its plan and, when profiling is enabled,
+ * its evaluations, selectivity, cumulative and average time, followed by a
+ * summary line. Output is truncated to fit @p buffer_size, as snprintf does.
+ *
+ * Example:
+ *   clause 0: range [1717200000000000000, 1717804800000000000) evals=1000 pass=120 (12.00%) 5400 ns (5.4 ns/eval)
+ *   clause 1: field hour in [9, 17) evals=120 pass=40 (33.33%) 900 ns (7.5 ns/eval)
+ *   total: records=1000 matched=40 (4.00%) 6300 ns
+ *
+ * @param query       Pointer to a compiled query.
+ * @param buffer      Output buffer (may be NULL when @p buffer_size is 0).
+ * @param buffer_size Size of the output buffer.
+ * @return Length of the full description, or -1 on error.
+ */
+int fossil_time_query_explain(
+    const fossil_time_query_t *query,
+    char *buffer,
+    size_t buffer_size
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/* ======================================================
+ * C++ Wrapper — Thin, Inline
+ * ====================================================== */
+
+#ifdef __cplusplus
+#include <string>
+
+namespace fossil {
+namespace time {
+
+class Query {
+public:
+    fossil_time_query_t raw;
+
+    /**
+     * Default constructor.
+     * Initializes an empty query that matches everything.
+     */
+    Query() : raw() { }
+
+    /**
+     * Compile a query without a reference time.
+     * Returns true on success.
+     */
+    inline bool compile(const char *text) {
+        return fossil_time_query_compile(&raw, text, nullptr) == 0;
+    }
+
+    /**
+     * Compile a query, resolving relative windows against now.
+     * Returns true on success.
+     */
+    inline bool compile(const char *text, const Date &now) {
+        return fossil_time_query_compile(&raw, text, &now.raw) == 0;
+    }
+
+    /**
+     * Evaluate the query against a Date.
+     */
+    inline bool match(const Date &dt) const {
+        return fossil_time_query_match(&raw, &dt.raw) != 0;
+    }
+
+    /**
+     * Evaluate the query against a UTC epoch-ns timestamp.
+     */
+    inline bool match_ns(int64_t epoch_ns) const {
+        return fossil_time_query_match_ns(&raw, epoch_ns) != 0;
+    }
+
+    /**
+     * Intersect the range clauses into [start, end).
+     * Returns true if the range is non-empty.
+     */
+    inline bool bounds(int64_t &start, int64_t &end) const {
+        return fossil_time_query_bounds(&raw, &start, &end) != 0;
+    }
+
+    /**
+     * Evaluate the query over a column of epoch-ns timestamps into a bitmap.
+     * Returns the number of matching rows, or -1 on error.
+     */
+    inline int64_t scan_ns(
+        const int64_t *epoch_ns,
+        size_t count,
+        uint64_t *out_bitmap,
+        size_t workers = 0
+    ) const {
+        return fossil_time_query_scan_ns(&raw, epoch_ns, count, workers, out_bitmap);
+    }
+
+    /**
+     * Collect the ascending positions of matching epoch-ns timestamps.
+     * Returns the number of positions written, or -1 on error.
+     */
+    inline int64_t select_ns(
+        const int64_t *epoch_ns,
+        size_t count,
+        size_t *out_index,
+        size_t workers = 0
+    ) const {
+        return fossil_time_query_select_ns(&raw, epoch_ns, count, workers, out_index);
+    }
+
+    /**
+     * Attach (and reset) profiling counters, or detach them with nullptr.
+     * Copies of this Query keep pointing at the same counters.
+     */
+    inline void profile(fossil_time_query_stats_t *stats) {
+        fossil_time_query_profile(&raw, stats);
+    }
+
+    /**
+     * Describe the compiled plan and its profiling counters.
+     */
+    inline std::string explain() const {
+        int len = fossil_time_query_explain(&raw, nullptr, 0);
+        if (len <= 0) return std::string();
+        std::string out((size_t)len + 1, '\0');
+        fossil_time_query_explain(&raw, &out[0], out.size());
+        out.resize((size_t)len);
+        return out;
+    }
+};
+
+} /* namespace time */
+} /* namespace fossil */
+#endif
+
+#endif /* FOSSIL_TIME_QUERY_H */
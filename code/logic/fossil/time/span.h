@@ -83,6 +83,23 @@ typedef struct fossil_time_span_t {
 #define FOSSIL_TIME_SPAN_PRECISION_ZEPTO    (1ULL << 10)
 #define FOSSIL_TIME_SPAN_PRECISION_YOCTO    (1ULL << 11)
 
+/* ======================================================
+ * Canonical Form
+ * ====================================================== */
+
+/*
+ * A span as one signed 128-bit count of yoctoseconds (10^-24 s), two's
+ * complement across two 64-bit words. It covers about ±5.4 million years
+ * at full precision, so add, subtract and compare are single wide-integer
+ * operations and the field view is only built when needed (formatting).
+ * Work that only needs nanoseconds can use the 64-bit form from
+ * fossil_time_span_to_nanoseconds / fossil_time_span_from_nanoseconds.
+ */
+typedef struct fossil_time_span_ticks_t {
+    int64_t  hi;
+    uint64_t lo;
+} fossil_time_span_ticks_t;
+
 /* ======================================================
  * C API — Core
  * ====================================================== */
@@ -104,9 +121,18 @@ int fossil_time_span_validate(const fossil_time_span_t *span);
  * Normalize the span fields, carrying overflow from lower units to higher units
  * (e.g., 1000 milliseconds becomes 1 second), and updating the precision mask accordingly.
  * This ensures the span is in canonical form.
+ *
+ * Every field from days down to yoctoseconds is carried, whatever the mask.
+ * The result has a single sign: -1 s + 500 ms becomes -500 ms, never
+ * -1 s and +500 ms. Bits for fields left non-zero are added to the mask.
  */
 void fossil_time_span_normalize(fossil_time_span_t *span);
 
+/*
+ * Normalize an array of spans in place, as fossil_time_span_normalize.
+ */
+void fossil_time_span_normalize_batch(fossil_time_span_t *spans, size_t count);
+
 /* ======================================================
  * C API — Construction
  * ====================================================== */
@@ -238,153 +264,1475 @@ int64_t fossil_time_span_to_nanoseconds(
     const fossil_time_span_t *span
 );
 
+/**
+ * Set a span from a 64-bit nanosecond count.
+ *
+ * The span receives the field view of the count (see
+ * fossil_time_span_from_ticks).
+ *
+ * Parameters:
+ *   span        - Pointer to the span structure to set.
+ *   nanoseconds - Signed nanosecond count.
+ */
+void fossil_time_span_from_nanoseconds(
+    fossil_time_span_t *span,
+    int64_t nanoseconds
+);
+
+/**
+ * Convert a span to a whole count of any unit, exactly.
+ *
+ * The total (see fossil_time_span_to_ticks) is divided by the unit with a
+ * single 128-bit division, rounded toward zero.
+ *
+ * Parameters:
+ *   span      - Pointer to the span structure to convert.
+ *   unit_id   - "days", "hours", "minutes", "seconds", "ms", "us", "ns",
+ *               "ps", "fs", "as", "zs" or "ys".
+ *   count     - Receives the signed 128-bit count of unit_id.
+ *   remainder - Receives what is left over in yoctoseconds, with the sign
+ *               of the span; may be NULL.
+ *
+ * Returns:
+ *   0 on success, -1 on invalid arguments or an unknown unit.
+ */
+int fossil_time_span_to_unit(
+    const fossil_time_span_t *span,
+    const char *unit_id,
+    fossil_time_span_ticks_t *count,
+    fossil_time_span_ticks_t *remainder
+);
+
+/**
+ * Set a span from a signed 128-bit count of any unit, exactly.
+ *
+ * Unlike fossil_time_span_from_unit, the count is not stored in a single
+ * field: the span receives the field view of the total (see
+ * fossil_time_span_from_ticks).
+ *
+ * Returns:
+ *   0 on success, -1 on an unknown unit or a total beyond the tick range.
+ */
+int fossil_time_span_from_unit_exact(
+    fossil_time_span_t *span,
+    fossil_time_span_ticks_t count,
+    const char *unit_id
+);
+
+/**
+ * Convert a signed 128-bit count between any two units, exactly.
+ *
+ * Each pair of units is one entry of a precomputed conversion table, so a
+ * conversion is one multiply (to a finer unit) or one division (to a
+ * coarser one, rounded toward zero).
+ *
+ * Parameters:
+ *   count     - Count of from_unit.
+ *   from_unit - Unit of count (as for fossil_time_span_to_unit).
+ *   to_unit   - Unit of the result.
+ *   out       - Receives the count of to_unit.
+ *   remainder - Receives what is left over in from_unit, with the sign of
+ *               count; may be NULL.
+ *
+ * Returns:
+ *   0 on success, -1 on invalid arguments, an unknown unit or a result
+ *   beyond 128 bits.
+ */
+int fossil_time_span_convert_unit(
+    fossil_time_span_ticks_t count,
+    const char *from_unit,
+    const char *to_unit,
+    fossil_time_span_ticks_t *out,
+    fossil_time_span_ticks_t *remainder
+);
+
 /* ======================================================
- * C API — Formatting
+ * C API — Canonical Ticks
  * ====================================================== */
 
 /**
- * Format a time span as a string.
+ * Convert a span to its canonical tick count.
  *
- * This function converts the given fossil_time_span_t structure into a
- * human-readable string representation, according to the specified format_id.
- * The formatted string is written to the provided buffer, which must be at
- * least buffer_size bytes in length. The output is always null-terminated
- * unless buffer_size is zero.
+ * Sums every field indicated by the precision mask, down to yoctoseconds.
+ * Fields need not be normalized and may carry mixed signs.
  *
- * Supported format_id values include:
- *   "short"   - Compact notation (e.g., "5s", "2h 30m").
- *   "human"   - Human-friendly words (e.g., "5 seconds", "2 hours, 30 minutes").
- *   "precise" - High-precision decimal (e.g., "5.000000000 s").
- *   "ai"      - AI/semantic-friendly format (implementation-defined).
+ * Parameters:
+ *   span - Pointer to the span structure to convert (NULL gives zero).
+ *
+ * Returns:
+ *   The span in yoctoseconds.
+ */
+fossil_time_span_ticks_t fossil_time_span_to_ticks(
+    const fossil_time_span_t *span
+);
+
+/**
+ * Build the field view of a tick count.
+ *
+ * Every field takes the sign of the count, hours/minutes/seconds are
+ * below 24/60/60 and sub-second fields below 1000. The precision mask
+ * covers days through seconds, plus the sub-second units down to the
+ * finest non-zero one.
  *
  * Parameters:
- *   span        - Pointer to the span structure to format.
- *   buffer      - Pointer to the character buffer to receive the formatted string.
- *   buffer_size - Size of the buffer in bytes.
- *   format_id   - String identifier for the desired output format.
+ *   span  - Pointer to the span structure to fill.
+ *   ticks - Yoctosecond count.
+ */
+void fossil_time_span_from_ticks(
+    fossil_time_span_t *span,
+    fossil_time_span_ticks_t ticks
+);
+
+/**
+ * Add two tick counts (wraps on overflow past ±5.4 million years).
+ */
+fossil_time_span_ticks_t fossil_time_span_ticks_add(
+    fossil_time_span_ticks_t a,
+    fossil_time_span_ticks_t b
+);
+
+/**
+ * Subtract tick count b from a (wraps on overflow past ±5.4 million years).
+ */
+fossil_time_span_ticks_t fossil_time_span_ticks_sub(
+    fossil_time_span_ticks_t a,
+    fossil_time_span_ticks_t b
+);
+
+/**
+ * Compare two tick counts.
  *
  * Returns:
- *   The number of characters written (excluding the null terminator), or a negative
- *   value if an error occurred (e.g., invalid format_id or insufficient buffer).
+ *   -1, 0 or 1 as a is less than, equal to or greater than b.
  */
-int fossil_time_span_format(
-    const fossil_time_span_t *span,
-    char *buffer,
-    size_t buffer_size,
-    const char *format_id
+int fossil_time_span_ticks_cmp(
+    fossil_time_span_ticks_t a,
+    fossil_time_span_ticks_t b
 );
 
-#ifdef __cplusplus
-} /* extern "C" */
-#endif
+/**
+ * Compare two spans by their total length, whatever their field layout.
+ *
+ * Returns:
+ *   -1, 0 or 1 as a is shorter than, equal to or longer than b.
+ */
+int fossil_time_span_compare(
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+);
 
 /* ======================================================
- * C++ Wrapper — Thin, Inline
+ * C API — Aggregates
  * ====================================================== */
 
-#ifdef __cplusplus
-namespace fossil {
-namespace time {
+/*
+ * Summaries over arrays of spans or of their tick counts. Spans are summed
+ * by their masked fields, so they need not be normalized. Sums are carried
+ * in 192 bits and only the final value is range-checked.
+ *
+ * Returns (all functions):
+ *   0 on success, -1 on invalid arguments, an empty array (except for the
+ *   sums, which give zero) or a result beyond the tick range.
+ */
 
-class Span {
-public:
-    fossil_time_span_t raw;
+/**
+ * Total of all elements. A span result is in its field view
+ * (see fossil_time_span_from_ticks).
+ */
+int fossil_time_span_sum(
+    const fossil_time_span_t *spans,
+    size_t count,
+    fossil_time_span_t *out
+);
 
-    /**
-     * Default constructor.
-     * Initializes the Span object without modifying its contents.
-     */
-    Span() { }
+/**
+ * Shortest element, copied as stored. Ties keep the first.
+ */
+int fossil_time_span_min(
+    const fossil_time_span_t *spans,
+    size_t count,
+    fossil_time_span_t *out
+);
 
-    /**
-     * Clear all fields of the span, including the precision mask.
-     * Useful for initializing or resetting the span.
-     */
-    inline void clear() {
-        fossil_time_span_clear(&raw);
-    }
+/**
+ * Longest element, copied as stored. Ties keep the first.
+ */
+int fossil_time_span_max(
+    const fossil_time_span_t *spans,
+    size_t count,
+    fossil_time_span_t *out
+);
 
-    /**
-     * Validate the contents of the span.
-     * Returns true if all fields are within expected ranges.
-     */
-    inline bool validate() const {
-        return fossil_time_span_validate(&raw) != 0;
-    }
+/**
+ * Arithmetic mean, exact to the yoctosecond and rounded toward zero.
+ */
+int fossil_time_span_mean(
+    const fossil_time_span_t *spans,
+    size_t count,
+    fossil_time_span_t *out
+);
 
-    /**
-     * Normalize the span fields, carrying overflow from lower units to higher units.
-     * Updates the precision mask accordingly.
-     */
-    inline void normalize() {
-        fossil_time_span_normalize(&raw);
-    }
+/**
+ * Population variance in seconds squared, around the exact mean.
+ */
+int fossil_time_span_variance(
+    const fossil_time_span_t *spans,
+    size_t count,
+    double *out
+);
 
-    /**
-     * Set the span using a value and unit string.
-     * Only the specified unit field is set; others are zeroed.
-     * Updates the precision mask.
-     */
-    inline void from_unit(int64_t value, const char *unit_id) {
-        fossil_time_span_from_unit(&raw, value, unit_id);
-    }
+/** Tick-array form of fossil_time_span_sum. */
+int fossil_time_span_ticks_sum(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    fossil_time_span_ticks_t *out
+);
 
-    /**
-     * Set the span using a semantic or AI-friendly hint string.
-     * The mapping of hints to durations is implementation-defined.
-     */
-    inline void from_ai(const char *hint_id) {
-        fossil_time_span_from_ai(&raw, hint_id);
-    }
+/** Tick-array form of fossil_time_span_min. */
+int fossil_time_span_ticks_min(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    fossil_time_span_ticks_t *out
+);
 
-    /**
-     * Convert the span to total seconds.
-     * Aggregates all fields into a single integer value in seconds.
-     */
-    inline int64_t to_seconds() const {
-        return fossil_time_span_to_seconds(&raw);
-    }
+/** Tick-array form of fossil_time_span_max. */
+int fossil_time_span_ticks_max(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    fossil_time_span_ticks_t *out
+);
 
-    /**
-     * Convert the span to total nanoseconds.
-     * Aggregates all fields into a single integer value in nanoseconds.
-     */
-    inline int64_t to_nanoseconds() const {
-        return fossil_time_span_to_nanoseconds(&raw);
-    }
+/** Tick-array form of fossil_time_span_mean. */
+int fossil_time_span_ticks_mean(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    fossil_time_span_ticks_t *out
+);
 
-    /**
-     * Format the span as a string according to the specified format.
-     * Writes the formatted string to the provided buffer.
-     * Returns the number of characters written, or negative on error.
-     */
-    inline int format(
-        char *buffer,
-        size_t buffer_size,
-        const char *format_id
-    ) const {
-        return fossil_time_span_format(&raw, buffer, buffer_size, format_id);
-    }
+/** Tick-array form of fossil_time_span_variance. */
+int fossil_time_span_ticks_variance(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    double *out
+);
 
-    /**
-     * Add two spans together.
-     * Returns a new Span representing the sum.
-     * The result is not automatically normalized.
-     */
-    static inline Span add(const Span &a, const Span &b) {
-        Span out;
-        fossil_time_span_add(&out.raw, &a.raw, &b.raw);
-        return out;
-    }
+/* ======================================================
+ * C API — Checked and Saturating Arithmetic
+ * ====================================================== */
 
-    /**
-     * Subtract one span from another.
-     * Returns a new Span representing the difference.
-     * The result is not automatically normalized.
-     */
-    static inline Span sub(const Span &a, const Span &b) {
-        Span out;
-        fossil_time_span_sub(&out.raw, &a.raw, &b.raw);
+/*
+ * The checked forms work field by field like fossil_time_span_add/_sub/
+ * _from_unit/_to_nanoseconds, and fail instead of wrapping an int32 or
+ * int64 field. The saturating forms give the exact value, clamped to the
+ * tick range (about ±5.4 million years): the result keeps the field-wise
+ * layout when no field overflows and is otherwise the field view of the
+ * total (see fossil_time_span_from_ticks). A timeout computed with them can
+ * never wrap to a negative or tiny value.
+ */
+
+/**
+ * Field-wise a + b.
+ *
+ * Returns:
+ *   0 on success, -1 on invalid arguments or if any field overflows
+ *   (result is then left unchanged).
+ */
+int fossil_time_span_add_checked(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+);
+
+/**
+ * Field-wise a - b. Returns as fossil_time_span_add_checked.
+ */
+int fossil_time_span_sub_checked(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+);
+
+/**
+ * Every field multiplied by factor. Returns as fossil_time_span_add_checked.
+ */
+int fossil_time_span_scale_checked(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t factor
+);
+
+/**
+ * fossil_time_span_from_unit without truncation.
+ *
+ * A value that fits its unit's field is stored there as by
+ * fossil_time_span_from_unit; a larger one is carried into the field view.
+ *
+ * Returns:
+ *   0 on success, -1 on an unknown unit or a value beyond the tick range.
+ */
+int fossil_time_span_from_unit_checked(
+    fossil_time_span_t *span,
+    int64_t value,
+    const char *unit_id
+);
+
+/**
+ * fossil_time_span_to_nanoseconds without wrapping.
+ *
+ * Returns:
+ *   0 on success, -1 on invalid arguments or a total beyond int64.
+ */
+int fossil_time_span_to_nanoseconds_checked(
+    const fossil_time_span_t *span,
+    int64_t *out
+);
+
+/**
+ * a + b, clamped to the tick range.
+ */
+void fossil_time_span_add_saturating(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+);
+
+/**
+ * a - b, clamped to the tick range.
+ */
+void fossil_time_span_sub_saturating(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+);
+
+/**
+ * span * factor, clamped to the tick range.
+ */
+void fossil_time_span_scale_saturating(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t factor
+);
+
+/**
+ * fossil_time_span_to_nanoseconds, clamped to INT64_MIN..INT64_MAX.
+ */
+int64_t fossil_time_span_to_nanoseconds_saturating(
+    const fossil_time_span_t *span
+);
+
+/* ======================================================
+ * C API — Scaling and Division
+ * ====================================================== */
+
+/*
+ * Exact operations on the total (see fossil_time_span_to_ticks). Span
+ * results are in the field view (see fossil_time_span_from_ticks). Unless
+ * stated otherwise each returns 0 on success and -1 on invalid arguments,
+ * division by zero, or a result beyond the tick range.
+ */
+
+/**
+ * ticks * factor.
+ */
+int fossil_time_span_ticks_mul(
+    fossil_time_span_ticks_t ticks,
+    int64_t factor,
+    fossil_time_span_ticks_t *out
+);
+
+/**
+ * ticks / divisor, rounded toward zero.
+ */
+int fossil_time_span_ticks_div(
+    fossil_time_span_ticks_t ticks,
+    int64_t divisor,
+    fossil_time_span_ticks_t *out
+);
+
+/**
+ * Floored division: quotient = floor(a / b) and remainder = a - quotient * b,
+ * which has the sign of b. Either output may be NULL.
+ */
+int fossil_time_span_ticks_divmod(
+    fossil_time_span_ticks_t a,
+    fossil_time_span_ticks_t b,
+    fossil_time_span_ticks_t *quotient,
+    fossil_time_span_ticks_t *remainder
+);
+
+/**
+ * span * factor.
+ */
+int fossil_time_span_mul(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t factor
+);
+
+/**
+ * span / divisor, rounded toward zero at the yoctosecond.
+ */
+int fossil_time_span_div(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t divisor
+);
+
+/**
+ * a modulo b, floored: for a positive b the result is in [0, b), so it is
+ * the phase of a within repeating periods of b.
+ */
+int fossil_time_span_mod(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+);
+
+/**
+ * How many b fit in a, as a double.
+ *
+ * The whole part is computed exactly, so only the fraction is rounded.
+ *
+ * Returns:
+ *   a / b; an infinity or NaN if b is zero, 0.0 for NULL arguments.
+ */
+double fossil_time_span_ratio(
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+);
+
+/**
+ * a / b as an exact fraction in lowest terms.
+ *
+ * Parameters:
+ *   numerator   - Receives the numerator, carrying the sign.
+ *   denominator - Receives the positive denominator.
+ */
+int fossil_time_span_ratio_exact(
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b,
+    fossil_time_span_ticks_t *numerator,
+    fossil_time_span_ticks_t *denominator
+);
+
+/* ======================================================
+ * C API — Rounding
+ * ====================================================== */
+
+/*
+ * Round a span's total to a whole number of steps, where a step is
+ * multiple * unit_id (e.g. 15 "minutes", 100 "us"; units as for
+ * fossil_time_span_to_unit). The step may be any size up to the tick range.
+ * Results are in the field view (see fossil_time_span_from_ticks).
+ *
+ * Returns (single span):
+ *   0 on success, -1 on invalid arguments, an unknown unit, a multiple
+ *   below 1, or a result beyond the tick range.
+ *
+ * Returns (batch forms, spans and out may be the same array):
+ *   The number of rows whose result left the tick range (those rows are
+ *   zeroed), or -1 on invalid arguments.
+ */
+
+/**
+ * Round toward negative infinity.
+ */
+int fossil_time_span_floor(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t multiple,
+    const char *unit_id
+);
+
+/**
+ * Round toward positive infinity.
+ */
+int fossil_time_span_ceil(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t multiple,
+    const char *unit_id
+);
+
+/**
+ * Round to the nearest step; halfway cases go away from zero.
+ */
+int fossil_time_span_round(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t multiple,
+    const char *unit_id
+);
+
+/** Array form of fossil_time_span_floor. */
+int fossil_time_span_floor_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    int64_t multiple,
+    const char *unit_id,
+    fossil_time_span_t *out
+);
+
+/** Array form of fossil_time_span_ceil. */
+int fossil_time_span_ceil_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    int64_t multiple,
+    const char *unit_id,
+    fossil_time_span_t *out
+);
+
+/** Array form of fossil_time_span_round. */
+int fossil_time_span_round_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    int64_t multiple,
+    const char *unit_id,
+    fossil_time_span_t *out
+);
+
+/* ======================================================
+ * C API — Parsing
+ * ====================================================== */
+
+/**
+ * Parse a duration string.
+ *
+ * Accepts, with an optional leading '+' or '-':
+ *   ISO 8601 - "P3DT4H5M6.789S", "PT0,5S", "P2W". Designators in order;
+ *              years and months are rejected (no fixed length).
+ *   Compact  - Go-style number/unit pairs: "1h30m", "250ms", "1.5us", "0".
+ *              Units: w, d, h, m, s, ms, us (or µs), ns, ps, fs, as, zs, ys.
+ *
+ * Any component may carry a decimal fraction; it is exact down to a
+ * yoctosecond. No memory is allocated.
+ *
+ * Parameters:
+ *   text - NUL-terminated input.
+ *   out  - Receives the span as a field view (see fossil_time_span_from_ticks),
+ *          or zero on failure.
+ *
+ * Returns:
+ *   0 on success, -1 on a syntax error or a value beyond the tick range.
+ */
+int fossil_time_span_parse(
+    const char *text,
+    fossil_time_span_t *out
+);
+
+/**
+ * Parse an array of duration strings.
+ *
+ * Parameters:
+ *   texts - Input strings; a NULL entry counts as a failure.
+ *   count - Number of strings.
+ *   out   - Receives one span per string; failed rows are zeroed.
+ *
+ * Returns:
+ *   The number of rows that failed, or -1 on invalid arguments.
+ */
+int fossil_time_span_parse_batch(
+    const char *const *texts,
+    size_t count,
+    fossil_time_span_t *out
+);
+
+/* ======================================================
+ * C API — Formatting
+ * ====================================================== */
+
+/**
+ * Format a time span as a string.
+ *
+ * This function converts the given fossil_time_span_t structure into a
+ * human-readable string representation, according to the specified format_id.
+ * The formatted string is written to the provided buffer, which must be at
+ * least buffer_size bytes in length. The output is always null-terminated
+ * unless buffer_size is zero.
+ *
+ * Supported format_id values include:
+ *   "short"   - Stored day/hour/minute/second fields (e.g., "0d 2h 30m 0s").
+ *   "human"   - The same fields in words (e.g., "0 days, 2 hours, 30 minutes, 0 seconds").
+ *   "iso"     - ISO 8601 duration of the exact value (e.g., "P1DT2H3M4.005S", "PT0S").
+ *   "compact" - Go-style notation (e.g., "26h3m4.005s", "1.5ms", "0s").
+ *   "precise" - Exact total seconds, at least nine decimals (e.g., "5.000000000 s").
+ *
+ * "iso", "compact" and "precise" print the exact tick value (see
+ * fossil_time_span_to_ticks) with trailing fraction zeros dropped, so unnormalized
+ * fields and sub-nanosecond units are rendered exactly. No allocation is made;
+ * the length is measured first and the text written once.
+ *
+ * Parameters:
+ *   span        - Pointer to the span structure to format.
+ *   buffer      - Pointer to the character buffer to receive the formatted string.
+ *   buffer_size - Size of the buffer in bytes.
+ *   format_id   - String identifier for the desired output format.
+ *
+ * Returns:
+ *   The length of the full string (excluding the null terminator), as snprintf;
+ *   a smaller buffer receives a truncated, terminated prefix. -1 on invalid
+ *   arguments, an unknown format_id, or a span whose total lies outside the
+ *   tick range in a total-based style ("iso", "compact", "precise"); the
+ *   buffer then holds an empty string.
+ */
+int fossil_time_span_format(
+    const fossil_time_span_t *span,
+    char *buffer,
+    size_t buffer_size,
+    const char *format_id
+);
+
+/**
+ * Exact length of a formatted span.
+ *
+ * Parameters:
+ *   span      - Span to measure.
+ *   format_id - As for fossil_time_span_format.
+ *
+ * Returns:
+ *   The number of characters fossil_time_span_format would produce, excluding
+ *   the null terminator, or -1 where it would return -1.
+ */
+int fossil_time_span_format_length(
+    const fossil_time_span_t *span,
+    const char *format_id
+);
+
+/**
+ * Format an array of spans into fixed-width rows.
+ *
+ * Row i is written to buffer + i * stride exactly as fossil_time_span_format
+ * would write it into a buffer of stride bytes. The format is resolved once.
+ *
+ * Parameters:
+ *   spans     - Array of spans.
+ *   count     - Number of elements.
+ *   buffer    - Output buffer of count * stride bytes.
+ *   stride    - Bytes per row, including the null terminator.
+ *   format_id - As for fossil_time_span_format.
+ *
+ * Returns:
+ *   0 on success, -1 on invalid arguments or an unknown format_id. Rows that
+ *   cannot be formatted are left empty and also make the result -1; the other
+ *   rows are still written.
+ */
+int fossil_time_span_format_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    char *buffer,
+    size_t stride,
+    const char *format_id
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/* ======================================================
+ * C++ Wrapper — Thin, Inline
+ * ====================================================== */
+
+#ifdef __cplusplus
+#include <chrono>
+#include <type_traits>
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+#include <compare>
+#define FOSSIL_SPAN_HAVE_SPACESHIP 1
+#endif
+
+namespace fossil {
+namespace time {
+
+/*
+ * Constexpr mirrors of the tick routines in span.c, so spans built from
+ * constants fold at compile time. Results match the C functions exactly.
+ * A ticks_t here is either a signed count or a magnitude, by context.
+ */
+namespace span_detail {
+
+typedef fossil_time_span_ticks_t ticks_t;
+
+constexpr ticks_t make(uint64_t hi, uint64_t lo) {
+    return ticks_t{ static_cast<int64_t>(hi), lo };
+}
+
+constexpr ticks_t from_i64(int64_t v) {
+    return make(v < 0 ? ~0ULL : 0, static_cast<uint64_t>(v));
+}
+
+constexpr bool is_zero(ticks_t t) {
+    return t.hi == 0 && t.lo == 0;
+}
+
+constexpr ticks_t add(ticks_t a, ticks_t b) {
+    uint64_t lo = a.lo + b.lo;
+    return make(static_cast<uint64_t>(a.hi) + static_cast<uint64_t>(b.hi) + (lo < a.lo), lo);
+}
+
+constexpr ticks_t negate(ticks_t t) {
+    uint64_t lo = ~t.lo + 1;
+    return make(~static_cast<uint64_t>(t.hi) + (lo == 0), lo);
+}
+
+constexpr ticks_t sub(ticks_t a, ticks_t b) {
+    return add(a, negate(b));
+}
+
+constexpr ticks_t magnitude(ticks_t t) {
+    return t.hi < 0 ? negate(t) : t;
+}
+
+constexpr int cmp(ticks_t a, ticks_t b) {
+    if (a.hi != b.hi) return a.hi < b.hi ? -1 : 1;
+    if (a.lo != b.lo) return a.lo < b.lo ? -1 : 1;
+    return 0;
+}
+
+/* Unsigned compare of two magnitudes */
+constexpr int ucmp(ticks_t a, ticks_t b) {
+    uint64_t ah = static_cast<uint64_t>(a.hi), bh = static_cast<uint64_t>(b.hi);
+    if (ah != bh) return ah < bh ? -1 : 1;
+    if (a.lo != b.lo) return a.lo < b.lo ? -1 : 1;
+    return 0;
+}
+
+/* Full 64x64 -> 128 product from 32-bit halves */
+constexpr ticks_t umul(uint64_t a, uint64_t b) {
+    uint64_t a0 = a & 0xFFFFFFFFULL, a1 = a >> 32;
+    uint64_t b0 = b & 0xFFFFFFFFULL, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFFULL) + (p10 & 0xFFFFFFFFULL);
+    return make(p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32), (mid << 32) | (p00 & 0xFFFFFFFFULL));
+}
+
+/* Low 128 bits of a magnitude product */
+constexpr ticks_t umul(ticks_t a, ticks_t b) {
+    ticks_t r = umul(a.lo, b.lo);
+    return make(static_cast<uint64_t>(r.hi) + static_cast<uint64_t>(a.hi) * b.lo + a.lo * static_cast<uint64_t>(b.hi), r.lo);
+}
+
+/* Signed t * k, wrapping like fossil_time_span_ticks_add */
+constexpr ticks_t mul(ticks_t t, int64_t k) {
+    uint64_t mk = k < 0 ? 0 - static_cast<uint64_t>(k) : static_cast<uint64_t>(k);
+    ticks_t r = umul(magnitude(t), make(0, mk));
+    return ((t.hi < 0) != (k < 0)) ? negate(r) : r;
+}
+
+/* Divide a magnitude in place by d, returning the remainder */
+constexpr uint32_t udiv32(ticks_t &m, uint32_t d) {
+    uint64_t w[4] = {
+        static_cast<uint64_t>(m.hi) >> 32, static_cast<uint64_t>(m.hi) & 0xFFFFFFFFULL,
+        m.lo >> 32, m.lo & 0xFFFFFFFFULL
+    };
+    uint64_t r = 0;
+    for (int i = 0; i < 4; i++) {
+        uint64_t cur = (r << 32) | w[i];
+        w[i] = cur / d;
+        r = cur % d;
+    }
+    m = make((w[0] << 32) | w[1], (w[2] << 32) | w[3]);
+    return static_cast<uint32_t>(r);
+}
+
+struct divmod_t {
+    ticks_t q;
+    ticks_t r;
+};
+
+/* Magnitude n / d; d must be non-zero */
+constexpr divmod_t udivmod(ticks_t n, ticks_t d) {
+    divmod_t out{ make(0, 0), make(0, 0) };
+
+    if (d.hi == 0 && d.lo <= 0xFFFFFFFFULL) {
+        out.q = n;
+        out.r = make(0, udiv32(out.q, static_cast<uint32_t>(d.lo)));
+        return out;
+    }
+
+    /* Shift-subtract, starting at the top set bit of n */
+    int top = 127;
+    while (top >= 0 && !((top >= 64 ? static_cast<uint64_t>(n.hi) >> (top - 64) : n.lo >> top) & 1))
+        top--;
+    for (int i = top; i >= 0; i--) {
+        uint64_t bit = (i >= 64 ? static_cast<uint64_t>(n.hi) >> (i - 64) : n.lo >> i) & 1;
+        out.r = make((static_cast<uint64_t>(out.r.hi) << 1) | (out.r.lo >> 63), (out.r.lo << 1) | bit);
+        if (ucmp(out.r, d) >= 0) {
+            out.r = sub(out.r, d);
+            if (i >= 64) out.q.hi = static_cast<int64_t>(static_cast<uint64_t>(out.q.hi) | (1ULL << (i - 64)));
+            else         out.q.lo |= 1ULL << i;
+        }
+    }
+    return out;
+}
+
+/* Signed a / b, truncated toward zero; b must be non-zero */
+constexpr divmod_t sdivmod(ticks_t a, ticks_t b) {
+    divmod_t m = udivmod(magnitude(a), magnitude(b));
+    if ((a.hi < 0) != (b.hi < 0)) m.q = negate(m.q);
+    if (a.hi < 0) m.r = negate(m.r);
+    return m;
+}
+
+constexpr ticks_t pow10(int e) {
+    ticks_t r = make(0, 1);
+    for (; e >= 9; e -= 9) r = umul(r, make(0, 1000000000ULL));
+    for (; e > 0; e--)     r = umul(r, make(0, 10));
+    return r;
+}
+
+constexpr ticks_t to_ticks(const fossil_time_span_t &s) {
+    uint64_t m = s.precision_mask;
+    uint64_t secs = 0;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_DAYS)    secs += static_cast<uint64_t>(s.days) * 86400;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_HOURS)   secs += static_cast<uint64_t>(static_cast<int64_t>(s.hours) * 3600);
+    if (m & FOSSIL_TIME_SPAN_PRECISION_MINUTES) secs += static_cast<uint64_t>(static_cast<int64_t>(s.minutes) * 60);
+    if (m & FOSSIL_TIME_SPAN_PRECISION_SECONDS) secs += static_cast<uint64_t>(static_cast<int64_t>(s.seconds));
+
+    int64_t ns = 0, as = 0, ys = 0;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_MILLI) ns += static_cast<int64_t>(s.milliseconds) * 1000000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_MICRO) ns += static_cast<int64_t>(s.microseconds) * 1000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_NANO)  ns += s.nanoseconds;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_PICO)  as += static_cast<int64_t>(s.picoseconds) * 1000000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_FEMTO) as += static_cast<int64_t>(s.femtoseconds) * 1000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_ATTO)  as += s.attoseconds;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_ZEPTO) ys += static_cast<int64_t>(s.zeptoseconds) * 1000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_YOCTO) ys += s.yoctoseconds;
+
+    ticks_t t = from_i64(static_cast<int64_t>(secs));
+    t = add(mul(t, 1000000000), from_i64(ns));
+    t = add(mul(t, 1000000000), from_i64(as));
+    return add(mul(t, 1000000), from_i64(ys));
+}
+
+constexpr fossil_time_span_t from_ticks(ticks_t ticks) {
+    fossil_time_span_t s{};
+    bool neg = ticks.hi < 0;
+    ticks_t m = magnitude(ticks);
+    int32_t f[8] = { 0, 0, 0, 0, 0, 0, 0, 0 }; /* ys, zs, as, fs, ps, ns, us, ms */
+    uint32_t r = 0;
+
+    r = udiv32(m, 1000000000U);
+    f[0] = static_cast<int32_t>(r % 1000); f[1] = static_cast<int32_t>(r / 1000 % 1000); f[2] = static_cast<int32_t>(r / 1000000);
+    r = udiv32(m, 1000000U);
+    f[3] = static_cast<int32_t>(r % 1000); f[4] = static_cast<int32_t>(r / 1000);
+    r = udiv32(m, 1000000000U);
+    f[5] = static_cast<int32_t>(r % 1000); f[6] = static_cast<int32_t>(r / 1000 % 1000); f[7] = static_cast<int32_t>(r / 1000000);
+
+    uint64_t secs = m.lo;
+    int32_t sign = neg ? -1 : 1;
+
+    s.days         = static_cast<int64_t>(secs / 86400) * sign;
+    s.hours        = static_cast<int32_t>(secs / 3600 % 24) * sign;
+    s.minutes      = static_cast<int32_t>(secs / 60 % 60) * sign;
+    s.seconds      = static_cast<int32_t>(secs % 60) * sign;
+    s.milliseconds = f[7] * sign;
+    s.microseconds = f[6] * sign;
+    s.nanoseconds  = f[5] * sign;
+    s.picoseconds  = f[4] * sign;
+    s.femtoseconds = f[3] * sign;
+    s.attoseconds  = f[2] * sign;
+    s.zeptoseconds = f[1] * sign;
+    s.yoctoseconds = f[0] * sign;
+
+    s.precision_mask =
+        FOSSIL_TIME_SPAN_PRECISION_DAYS    |
+        FOSSIL_TIME_SPAN_PRECISION_HOURS   |
+        FOSSIL_TIME_SPAN_PRECISION_MINUTES |
+        FOSSIL_TIME_SPAN_PRECISION_SECONDS;
+
+    for (int i = 0; i < 8; i++) {
+        if (f[i] != 0) {
+            for (int j = 7; j >= i; j--)
+                s.precision_mask |= FOSSIL_TIME_SPAN_PRECISION_MILLI << (7 - j);
+            break;
+        }
+    }
+    return s;
+}
+
+/* Trailing decimal zeros of a non-zero magnitude */
+constexpr int count_tens(ticks_t f) {
+    int e = 0;
+    while (!is_zero(f)) {
+        ticks_t q = f;
+        if (udiv32(q, 10) != 0) break;
+        f = q;
+        e++;
+    }
+    return e;
+}
+
+/*
+ * Yoctoseconds per tick of a std::ratio period. Every standard period
+ * (nano through years) is a whole number of ys; the factor is then split
+ * into 10^tens * rest so conversions back divide by u32 limbs only.
+ */
+template <class Period>
+struct chrono_scale {
+    static_assert(Period::num > 0 && Period::den > 0, "span: negative chrono period");
+
+    static constexpr ticks_t ys_num = umul(make(0, static_cast<uint64_t>(Period::num)), pow10(24));
+    static constexpr ticks_t den = make(0, static_cast<uint64_t>(Period::den));
+    static constexpr bool whole = is_zero(udivmod(ys_num, den).r);
+    static constexpr ticks_t factor = udivmod(ys_num, den).q;
+    static constexpr int tens = whole ? count_tens(factor) : 0;
+    static constexpr ticks_t rest = udivmod(factor, pow10(tens)).q;
+};
+
+/* count periods -> ticks; non-decimal periods round to the nearest ys */
+template <class Period>
+constexpr ticks_t chrono_to_ticks(int64_t count) {
+    typedef chrono_scale<Period> S;
+    uint64_t mag = count < 0 ? 0 - static_cast<uint64_t>(count) : static_cast<uint64_t>(count);
+    ticks_t t = make(0, 0);
+
+    if (S::whole) {
+        t = umul(make(0, mag), S::factor);
+    } else {
+        /* count * num = q * den + r, then r * 10^24 / den in three 10^8 steps */
+        divmod_t x = udivmod(umul(mag, static_cast<uint64_t>(Period::num)), S::den);
+        t = umul(x.q, pow10(24));
+        ticks_t frac = make(0, 0);
+        for (int i = 0; i < 3; i++) {
+            divmod_t d = udivmod(umul(x.r, make(0, 100000000ULL)), S::den);
+            frac = add(umul(frac, make(0, 100000000ULL)), d.q);
+            x.r = d.r;
+        }
+        if (ucmp(add(x.r, x.r), S::den) >= 0)
+            frac = add(frac, make(0, 1));
+        t = add(t, frac);
+    }
+    return count < 0 ? negate(t) : t;
+}
+
+/*
+ * ticks -> count periods, rounded toward zero like duration_cast. For
+ * non-decimal periods a span within half a ys of a whole count is that
+ * count, undoing the rounding of chrono_to_ticks so round trips are exact.
+ */
+template <class Period>
+constexpr int64_t ticks_to_chrono(ticks_t ticks) {
+    typedef chrono_scale<Period> S;
+    ticks_t m = magnitude(ticks);
+
+    if (S::whole) {
+        int e = S::tens;
+        for (; e >= 9; e -= 9) udiv32(m, 1000000000U);
+        if (e > 0) udiv32(m, static_cast<uint32_t>(pow10(e).lo));
+        m = udivmod(m, S::rest).q;
+    } else {
+        /* m = q * N + b, N = num * 10^24; then b * den / N 16 bits of den at a time */
+        divmod_t x = udivmod(m, S::ys_num);
+        ticks_t q = umul(x.q, S::den);
+        ticks_t acc = make(0, 0), rem = make(0, 0);
+        for (int shift = 48; shift >= 0; shift -= 16) {
+            uint64_t chunk = (static_cast<uint64_t>(Period::den) >> shift) & 0xFFFFULL;
+            ticks_t num = add(umul(rem, make(0, 65536)), umul(x.r, make(0, chunk)));
+            divmod_t d = udivmod(num, S::ys_num);
+            acc = add(umul(acc, make(0, 65536)), d.q);
+            rem = d.r;
+        }
+        ticks_t gap = sub(S::ys_num, rem);
+        if (ucmp(add(gap, gap), S::den) <= 0)
+            acc = add(acc, make(0, 1));
+        m = add(q, acc);
+    }
+
+    uint64_t v = ticks.hi < 0 ? 0 - m.lo : m.lo;
+    return static_cast<int64_t>(v);
+}
+
+constexpr double to_double(ticks_t t) {
+    ticks_t m = magnitude(t);
+    double d = static_cast<double>(static_cast<uint64_t>(m.hi)) * 18446744073709551616.0 + static_cast<double>(m.lo);
+    return t.hi < 0 ? -d : d;
+}
+
+} /* namespace span_detail */
+
+class Span {
+public:
+    fossil_time_span_t raw;
+
+    /**
+     * Default constructor.
+     * Initializes the span to zero with an empty precision mask.
+     */
+    constexpr Span() : raw{} { }
+
+    /**
+     * Wrap an existing C span.
+     */
+    explicit constexpr Span(const fossil_time_span_t &span) : raw(span) { }
+
+    /**
+     * Implicit conversion from any integral std::chrono::duration.
+     * Non-decimal periods (e.g. 1/60 s) are rounded to the nearest ys and
+     * convert back to the same count.
+     */
+    template <class Rep, class Period>
+    constexpr Span(const std::chrono::duration<Rep, Period> &d)
+        : raw(span_detail::from_ticks(span_detail::chrono_to_ticks<Period>(static_cast<int64_t>(d.count())))) {
+        static_assert(std::is_integral<Rep>::value,
+            "Span: duration_cast floating durations to an integral Rep first");
+    }
+
+    /**
+     * Implicit conversion to any std::chrono::duration, rounded toward zero
+     * like duration_cast. Integral counts wrap outside the Rep range.
+     */
+    template <class Rep, class Period>
+    constexpr operator std::chrono::duration<Rep, Period>() const {
+        if constexpr (std::is_floating_point<Rep>::value) {
+            return std::chrono::duration<Rep, Period>(static_cast<Rep>(
+                span_detail::to_double(span_detail::to_ticks(raw)) / 1e24
+                * static_cast<double>(Period::den) / static_cast<double>(Period::num)));
+        } else {
+            return std::chrono::duration<Rep, Period>(static_cast<Rep>(
+                span_detail::ticks_to_chrono<Period>(span_detail::to_ticks(raw))));
+        }
+    }
+
+    /**
+     * Constexpr unit constructors. Like from_unit, the value lands in its
+     * own field; values past the int32 field range fall back to the
+     * canonical tick layout so nothing is truncated.
+     */
+    static constexpr Span days(int64_t n)         { return unit(n, 0); }
+    static constexpr Span hours(int64_t n)        { return unit(n, 1); }
+    static constexpr Span minutes(int64_t n)      { return unit(n, 2); }
+    static constexpr Span seconds(int64_t n)      { return unit(n, 3); }
+    static constexpr Span milliseconds(int64_t n) { return unit(n, 4); }
+    static constexpr Span microseconds(int64_t n) { return unit(n, 5); }
+    static constexpr Span nanoseconds(int64_t n)  { return unit(n, 6); }
+    static constexpr Span picoseconds(int64_t n)  { return unit(n, 7); }
+    static constexpr Span femtoseconds(int64_t n) { return unit(n, 8); }
+    static constexpr Span attoseconds(int64_t n)  { return unit(n, 9); }
+    static constexpr Span zeptoseconds(int64_t n) { return unit(n, 10); }
+    static constexpr Span yoctoseconds(int64_t n) { return unit(n, 11); }
+
+    /**
+     * Clear all fields of the span, including the precision mask.
+     * Useful for initializing or resetting the span.
+     */
+    inline void clear() {
+        fossil_time_span_clear(&raw);
+    }
+
+    /**
+     * Validate the contents of the span.
+     * Returns true if all fields are within expected ranges.
+     */
+    inline bool validate() const {
+        return fossil_time_span_validate(&raw) != 0;
+    }
+
+    /**
+     * Normalize the span fields, carrying overflow from lower units to higher units.
+     * Updates the precision mask accordingly.
+     */
+    inline void normalize() {
+        fossil_time_span_normalize(&raw);
+    }
+
+    /**
+     * Normalize an array of spans in place.
+     */
+    static inline void normalize(fossil_time_span_t *spans, size_t count) {
+        fossil_time_span_normalize_batch(spans, count);
+    }
+
+    /**
+     * Set the span using a value and unit string.
+     * Only the specified unit field is set; others are zeroed.
+     * Updates the precision mask.
+     */
+    inline void from_unit(int64_t value, const char *unit_id) {
+        fossil_time_span_from_unit(&raw, value, unit_id);
+    }
+
+    /**
+     * Set the span using a semantic or AI-friendly hint string.
+     * The mapping of hints to durations is implementation-defined.
+     */
+    inline void from_ai(const char *hint_id) {
+        fossil_time_span_from_ai(&raw, hint_id);
+    }
+
+    /**
+     * Convert the span to total seconds.
+     * Aggregates all fields into a single integer value in seconds.
+     */
+    inline int64_t to_seconds() const {
+        return fossil_time_span_to_seconds(&raw);
+    }
+
+    /**
+     * Convert the span to total nanoseconds.
+     * Aggregates all fields into a single integer value in nanoseconds.
+     */
+    inline int64_t to_nanoseconds() const {
+        return fossil_time_span_to_nanoseconds(&raw);
+    }
+
+    /**
+     * Set the span from a 64-bit nanosecond count.
+     */
+    inline void from_nanoseconds(int64_t nanoseconds) {
+        fossil_time_span_from_nanoseconds(&raw, nanoseconds);
+    }
+
+    /**
+     * Whole count of unit_id in the span, rounded toward zero.
+     * Returns false on an unknown unit.
+     */
+    inline bool to_unit(
+        const char *unit_id,
+        fossil_time_span_ticks_t &count,
+        fossil_time_span_ticks_t *remainder = nullptr
+    ) const {
+        return fossil_time_span_to_unit(&raw, unit_id, &count, remainder) == 0;
+    }
+
+    /**
+     * Set the span from a 128-bit count of unit_id, exactly.
+     * Returns false on an unknown unit or a total beyond the tick range.
+     */
+    inline bool from_unit_exact(fossil_time_span_ticks_t count, const char *unit_id) {
+        return fossil_time_span_from_unit_exact(&raw, count, unit_id) == 0;
+    }
+
+    /**
+     * The span as a canonical yoctosecond count.
+     */
+    constexpr fossil_time_span_ticks_t ticks() const {
+        return span_detail::to_ticks(raw);
+    }
+
+    /**
+     * Build a span from a canonical yoctosecond count.
+     */
+    static constexpr Span from_ticks(fossil_time_span_ticks_t ticks) {
+        return Span(span_detail::from_ticks(ticks));
+    }
+
+    /**
+     * Compare total lengths: -1, 0 or 1.
+     */
+    constexpr int compare(const Span &other) const {
+        return span_detail::cmp(span_detail::to_ticks(raw), span_detail::to_ticks(other.raw));
+    }
+
+    /**
+     * Total of an array of spans. Returns true unless the sum leaves the tick range.
+     */
+    static inline bool sum(const fossil_time_span_t *spans, size_t count, Span &out) {
+        return fossil_time_span_sum(spans, count, &out.raw) == 0;
+    }
+
+    /**
+     * Shortest span of a non-empty array.
+     */
+    static inline bool minimum(const fossil_time_span_t *spans, size_t count, Span &out) {
+        return fossil_time_span_min(spans, count, &out.raw) == 0;
+    }
+
+    /**
+     * Longest span of a non-empty array.
+     */
+    static inline bool maximum(const fossil_time_span_t *spans, size_t count, Span &out) {
+        return fossil_time_span_max(spans, count, &out.raw) == 0;
+    }
+
+    /**
+     * Exact mean of a non-empty array, rounded toward zero.
+     */
+    static inline bool mean(const fossil_time_span_t *spans, size_t count, Span &out) {
+        return fossil_time_span_mean(spans, count, &out.raw) == 0;
+    }
+
+    /**
+     * Population variance of a non-empty array in seconds squared.
+     */
+    static inline bool variance(const fossil_time_span_t *spans, size_t count, double &out) {
+        return fossil_time_span_variance(spans, count, &out) == 0;
+    }
+
+    /**
+     * Parse an ISO 8601 or compact duration. Returns true on success.
+     */
+    inline bool parse(const char *text) {
+        return fossil_time_span_parse(text, &raw) == 0;
+    }
+
+    /**
+     * Format the span as a string according to the specified format.
+     * Writes the formatted string to the provided buffer.
+     * Returns the number of characters written, or negative on error.
+     */
+    inline int format(
+        char *buffer,
+        size_t buffer_size,
+        const char *format_id
+    ) const {
+        return fossil_time_span_format(&raw, buffer, buffer_size, format_id);
+    }
+
+    /**
+     * Exact length of the formatted span, or -1 on an unknown format.
+     */
+    inline int format_length(const char *format_id) const {
+        return fossil_time_span_format_length(&raw, format_id);
+    }
+
+    /**
+     * Format an array of spans into rows of stride bytes.
+     * Returns 0 on success, -1 on invalid arguments.
+     */
+    static inline int format(
+        const fossil_time_span_t *spans,
+        size_t count,
+        char *buffer,
+        size_t stride,
+        const char *format_id
+    ) {
+        return fossil_time_span_format_batch(spans, count, buffer, stride, format_id);
+    }
+
+    /**
+     * Saturating a + b: the exact total, clamped to the tick range.
+     */
+    static inline Span add_saturating(const Span &a, const Span &b) {
+        Span out;
+        fossil_time_span_add_saturating(&out.raw, &a.raw, &b.raw);
+        return out;
+    }
+
+    /**
+     * Saturating a - b: the exact total, clamped to the tick range.
+     */
+    static inline Span sub_saturating(const Span &a, const Span &b) {
+        Span out;
+        fossil_time_span_sub_saturating(&out.raw, &a.raw, &b.raw);
+        return out;
+    }
+
+    /**
+     * Saturating span * factor.
+     */
+    inline Span scale_saturating(int64_t factor) const {
+        Span out;
+        fossil_time_span_scale_saturating(&out.raw, &raw, factor);
+        return out;
+    }
+
+    /**
+     * Exact span * factor into out. Returns false past the tick range.
+     */
+    inline bool mul(int64_t factor, Span &out) const {
+        return fossil_time_span_mul(&out.raw, &raw, factor) == 0;
+    }
+
+    /**
+     * Exact span / divisor into out. Returns false for a zero divisor.
+     */
+    inline bool div(int64_t divisor, Span &out) const {
+        return fossil_time_span_div(&out.raw, &raw, divisor) == 0;
+    }
+
+    /**
+     * Floored span modulo period into out. Returns false for a zero period.
+     */
+    inline bool mod(const Span &period, Span &out) const {
+        return fossil_time_span_mod(&out.raw, &raw, &period.raw) == 0;
+    }
+
+    /**
+     * The span rounded down to a multiple of (multiple * unit_id),
+     * or zero if the step is invalid or the result leaves the tick range.
+     */
+    inline Span floor(int64_t multiple, const char *unit_id) const {
+        Span out;
+        out.clear();
+        fossil_time_span_floor(&out.raw, &raw, multiple, unit_id);
+        return out;
+    }
+
+    /**
+     * The span rounded up to a multiple of (multiple * unit_id).
+     */
+    inline Span ceil(int64_t multiple, const char *unit_id) const {
+        Span out;
+        out.clear();
+        fossil_time_span_ceil(&out.raw, &raw, multiple, unit_id);
+        return out;
+    }
+
+    /**
+     * The span rounded to the nearest multiple of (multiple * unit_id).
+     */
+    inline Span round(int64_t multiple, const char *unit_id) const {
+        Span out;
+        out.clear();
+        fossil_time_span_round(&out.raw, &raw, multiple, unit_id);
+        return out;
+    }
+
+    /**
+     * How many of other fit in this span.
+     */
+    inline double ratio(const Span &other) const {
+        return fossil_time_span_ratio(&raw, &other.raw);
+    }
+
+    /**
+     * Field-wise a + b into out. Returns false if a field would overflow.
+     */
+    static inline bool add_checked(const Span &a, const Span &b, Span &out) {
+        return fossil_time_span_add_checked(&out.raw, &a.raw, &b.raw) == 0;
+    }
+
+    /**
+     * Field-wise a - b into out. Returns false if a field would overflow.
+     */
+    static inline bool sub_checked(const Span &a, const Span &b, Span &out) {
+        return fossil_time_span_sub_checked(&out.raw, &a.raw, &b.raw) == 0;
+    }
+
+    /**
+     * Set from a value and unit without truncation. Returns false if it does not fit.
+     */
+    inline bool from_unit_checked(int64_t value, const char *unit_id) {
+        return fossil_time_span_from_unit_checked(&raw, value, unit_id) == 0;
+    }
+
+    /**
+     * Total nanoseconds, clamped to the int64 range.
+     */
+    inline int64_t to_nanoseconds_saturating() const {
+        return fossil_time_span_to_nanoseconds_saturating(&raw);
+    }
+
+    /**
+     * Add two spans together.
+     * Returns a new Span representing the sum.
+     * The result is not automatically normalized.
+     */
+    static inline Span add(const Span &a, const Span &b) {
+        Span out;
+        fossil_time_span_add(&out.raw, &a.raw, &b.raw);
+        return out;
+    }
+
+    /**
+     * Subtract one span from another.
+     * Returns a new Span representing the difference.
+     * The result is not automatically normalized.
+     */
+    static inline Span sub(const Span &a, const Span &b) {
+        Span out;
+        fossil_time_span_sub(&out.raw, &a.raw, &b.raw);
+        return out;
+    }
+
+    /*
+     * Value operators. Unlike add/sub these work on exact tick totals and
+     * return the canonical layout; past +/-5.4 million years they wrap.
+     * Division by zero yields zero.
+     */
+    friend constexpr Span operator+(const Span &a, const Span &b) {
+        return from_ticks(span_detail::add(a.ticks(), b.ticks()));
+    }
+
+    friend constexpr Span operator-(const Span &a, const Span &b) {
+        return from_ticks(span_detail::sub(a.ticks(), b.ticks()));
+    }
+
+    friend constexpr Span operator-(const Span &a) {
+        return from_ticks(span_detail::negate(a.ticks()));
+    }
+
+    friend constexpr Span operator*(const Span &a, int64_t k) {
+        return from_ticks(span_detail::mul(a.ticks(), k));
+    }
+
+    friend constexpr Span operator*(int64_t k, const Span &a) {
+        return from_ticks(span_detail::mul(a.ticks(), k));
+    }
+
+    friend constexpr Span operator/(const Span &a, int64_t k) {
+        if (k == 0) return Span::from_ticks(span_detail::from_i64(0));
+        return from_ticks(span_detail::sdivmod(a.ticks(), span_detail::from_i64(k)).q);
+    }
+
+    /**
+     * Whole number of b in a, rounded toward zero like chrono. Quotients
+     * past int64 (1 day / 1 ys) saturate at INT64_MIN or INT64_MAX.
+     */
+    friend constexpr int64_t operator/(const Span &a, const Span &b) {
+        span_detail::ticks_t d = b.ticks();
+        if (span_detail::is_zero(d)) return 0;
+
+        span_detail::ticks_t q = span_detail::sdivmod(a.ticks(), d).q;
+        if (span_detail::cmp(q, span_detail::from_i64(INT64_MAX)) > 0) return INT64_MAX;
+        if (span_detail::cmp(q, span_detail::from_i64(INT64_MIN)) < 0) return INT64_MIN;
+        return static_cast<int64_t>(q.lo);
+    }
+
+    constexpr Span &operator+=(const Span &other) { return *this = *this + other; }
+    constexpr Span &operator-=(const Span &other) { return *this = *this - other; }
+    constexpr Span &operator*=(int64_t k)         { return *this = *this * k; }
+    constexpr Span &operator/=(int64_t k)         { return *this = *this / k; }
+
+    friend constexpr bool operator==(const Span &a, const Span &b) {
+        return a.compare(b) == 0;
+    }
+
+#ifdef FOSSIL_SPAN_HAVE_SPACESHIP
+    friend constexpr std::strong_ordering operator<=>(const Span &a, const Span &b) {
+        return a.compare(b) <=> 0;
+    }
+#else
+    friend constexpr bool operator!=(const Span &a, const Span &b) { return a.compare(b) != 0; }
+    friend constexpr bool operator<(const Span &a, const Span &b)  { return a.compare(b) < 0; }
+    friend constexpr bool operator<=(const Span &a, const Span &b) { return a.compare(b) <= 0; }
+    friend constexpr bool operator>(const Span &a, const Span &b)  { return a.compare(b) > 0; }
+    friend constexpr bool operator>=(const Span &a, const Span &b) { return a.compare(b) >= 0; }
+#endif
+
+private:
+    /* Single-field span like from_unit; index runs days (0) to ys (11) */
+    static constexpr Span unit(int64_t n, int index) {
+        if (index == 0) {
+            Span out;
+            out.raw.days = n;
+            out.raw.precision_mask = FOSSIL_TIME_SPAN_PRECISION_DAYS;
+            return out;
+        }
+        if (n < INT32_MIN || n > INT32_MAX) {
+            span_detail::ticks_t per = index < 4
+                ? span_detail::mul(span_detail::pow10(24), index == 1 ? 3600 : index == 2 ? 60 : 1)
+                : span_detail::pow10(33 - 3 * index);
+            return from_ticks(span_detail::mul(per, n));
+        }
+
+        Span out;
+        int32_t v = static_cast<int32_t>(n);
+        switch (index) {
+            case 1:  out.raw.hours        = v; break;
+            case 2:  out.raw.minutes      = v; break;
+            case 3:  out.raw.seconds      = v; break;
+            case 4:  out.raw.milliseconds = v; break;
+            case 5:  out.raw.microseconds = v; break;
+            case 6:  out.raw.nanoseconds  = v; break;
+            case 7:  out.raw.picoseconds  = v; break;
+            case 8:  out.raw.femtoseconds = v; break;
+            case 9:  out.raw.attoseconds  = v; break;
+            case 10: out.raw.zeptoseconds = v; break;
+            default: out.raw.yoctoseconds = v; break;
+        }
+        out.raw.precision_mask = FOSSIL_TIME_SPAN_PRECISION_DAYS << index;
         return out;
     }
 };
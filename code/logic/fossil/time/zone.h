@@ -0,0 +1,574 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_TIME_ZONE_H
+#define FOSSIL_TIME_ZONE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "date.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ======================================================
+ * Fossil Time — Time Zone Database
+ * ====================================================== */
+
+/*
+ * Zones are read from compiled TZif files (RFC 8536), as installed in
+ * /usr/share/zoneinfo. A file is memory-mapped and its transition table
+ * is used in place: opening a zone validates the header and records
+ * pointers into the mapping, and lookups decode the big-endian entries
+ * directly, so they never allocate. Instants after the last transition
+ * follow the POSIX TZ rule stored in the file's footer.
+ *
+ * All times in this API are UTC; offsets are seconds east of UTC.
+ */
+
+/**
+ * @brief Opaque handle to an opened time zone.
+ */
+typedef struct fossil_time_zone_t fossil_time_zone_t;
+
+/**
+ * @brief One interval during which a zone's offset is constant.
+ */
+typedef struct fossil_time_zone_period_t {
+    int64_t begin;          /* first UTC second of the period (INT64_MIN if unbounded) */
+    int64_t end;            /* first UTC second after it (INT64_MAX if unbounded) */
+    int32_t offset_sec;     /* UT offset, seconds east of UTC */
+    int32_t is_dst;         /* nonzero during daylight saving time */
+    const char *abbrev;     /* e.g. "CEST"; valid while the zone is open */
+} fossil_time_zone_period_t;
+
+/*
+ * How a local wall-clock time is resolved when a transition makes it
+ * ambiguous (repeated by a backward transition) or nonexistent (skipped
+ * by a forward one).
+ */
+typedef enum fossil_time_zone_policy_t {
+    FOSSIL_TIME_ZONE_SHIFT_FORWARD = 0, /* repeated: earlier; skipped: moved forward by the gap */
+    FOSSIL_TIME_ZONE_EARLIEST,          /* repeated: earlier; skipped: moved back by the gap */
+    FOSSIL_TIME_ZONE_LATEST,            /* repeated: later; skipped: moved forward by the gap */
+    FOSSIL_TIME_ZONE_REJECT             /* either case is an error */
+} fossil_time_zone_policy_t;
+
+/* ======================================================
+ * C API — Database
+ * ====================================================== */
+
+/**
+ * @brief Set the directory zone names are resolved against.
+ *
+ * Defaults to $TZDIR when set, otherwise /usr/share/zoneinfo. Call it
+ * before opening zones; already opened zones are unaffected.
+ *
+ * @param directory Directory path, or NULL to restore the default.
+ * @return 0 on success, -1 if the path is too long.
+ */
+int fossil_time_zone_set_directory(const char *directory);
+
+/**
+ * @brief Get the directory zone names are resolved against.
+ *
+ * @return The current zoneinfo directory.
+ */
+const char *fossil_time_zone_directory(void);
+
+/* ======================================================
+ * C API — Zones
+ * ====================================================== */
+
+/**
+ * @brief Open a zone by its IANA name, e.g. "Europe/Berlin".
+ *
+ * The TZif file is memory-mapped, not copied. Names may not be absolute
+ * or contain ".." components. When the library is built with embedded
+ * zones, those are consulted first unless a directory was set with
+ * fossil_time_zone_set_directory.
+ *
+ * @param name IANA zone name relative to the zoneinfo directory.
+ * @return Zone handle, or NULL if the zone is unknown or its file is invalid.
+ */
+fossil_time_zone_t *fossil_time_zone_open(const char *name);
+
+/**
+ * @brief Open a zone from the database compiled into the library.
+ *
+ * Available when built with the embedded_zones meson option. The zone is
+ * decoded from a read-only blob: no file I/O, and nothing is done until
+ * a zone is first opened.
+ *
+ * @param name IANA zone name, e.g. "Europe/Berlin".
+ * @return Zone handle, or NULL if the zone was not embedded.
+ */
+fossil_time_zone_t *fossil_time_zone_open_embedded(const char *name);
+
+/**
+ * @brief Open a zone from TZif data already in memory.
+ *
+ * The data is used in place and must outlive the zone.
+ *
+ * @param name Name reported by fossil_time_zone_name.
+ * @param data TZif file contents.
+ * @param size Size of @p data in bytes.
+ * @return Zone handle, or NULL if the data is not valid TZif.
+ */
+fossil_time_zone_t *fossil_time_zone_open_memory(
+    const char *name,
+    const void *data,
+    size_t size
+);
+
+/**
+ * @brief Release a reference to a zone; the last one unmaps its data.
+ *
+ * Zones from fossil_time_zone_open start with one reference, as does
+ * each handle returned by fossil_time_zone_get or fossil_time_zone_retain.
+ *
+ * @param zone Zone handle (NULL is ignored).
+ */
+void fossil_time_zone_close(fossil_time_zone_t *zone);
+
+/**
+ * @brief Get the name a zone was opened with.
+ *
+ * @param zone Zone handle.
+ * @return Zone name, or NULL if @p zone is NULL.
+ */
+const char *fossil_time_zone_name(const fossil_time_zone_t *zone);
+
+/* ======================================================
+ * C API — Shared zones
+ * ====================================================== */
+
+/**
+ * @brief Get the process-wide shared zone for a name.
+ *
+ * The first call for a name opens it (as fossil_time_zone_open does) and
+ * publishes it; later calls from any thread return the same immutable
+ * zone without locking, so many threads share one copy of the data.
+ * Each call returns a new reference to release with fossil_time_zone_close.
+ * Threads should keep the handle rather than call this per lookup.
+ *
+ * @param name IANA zone name.
+ * @return Shared zone handle, or NULL if the zone cannot be opened.
+ */
+fossil_time_zone_t *fossil_time_zone_get(const char *name);
+
+/**
+ * @brief Take another reference to a zone.
+ *
+ * @param zone Zone handle (NULL is ignored).
+ * @return @p zone.
+ */
+fossil_time_zone_t *fossil_time_zone_retain(fossil_time_zone_t *zone);
+
+/**
+ * @brief Reload shared zones, e.g. after a tzdata update.
+ *
+ * Each zone is loaded again and swapped in atomically: later calls to
+ * fossil_time_zone_get return the new version, while handles already
+ * held keep the old one until they are released. Readers never block;
+ * the caller waits only for gets racing with the swap. A zone that fails
+ * to load keeps its current data.
+ *
+ * @param name Zone to reload, or NULL for every shared zone.
+ * @return Number of zones reloaded.
+ */
+int fossil_time_zone_reload(const char *name);
+
+/* ======================================================
+ * C API — Lookups
+ * ====================================================== */
+
+/**
+ * @brief Find the period containing a UTC instant.
+ *
+ * A binary search over the transition table, or an evaluation of the
+ * footer rule past its end. Never allocates.
+ *
+ * @param zone        Zone handle.
+ * @param utc_seconds Seconds since the Unix epoch.
+ * @param out         Receives the period.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_time_zone_lookup(
+    const fossil_time_zone_t *zone,
+    int64_t utc_seconds,
+    fossil_time_zone_period_t *out
+);
+
+/**
+ * @brief Find the period containing a UTC instant, using a per-thread cache.
+ *
+ * Each thread remembers the last period returned for a few recently used
+ * zones. Consecutive instants within the same period, such as a run of
+ * timestamps in one DST season, are answered with two comparisons; other
+ * instants fall back to fossil_time_zone_lookup and refill the cache.
+ *
+ * @param zone        Zone handle.
+ * @param utc_seconds Seconds since the Unix epoch.
+ * @param out         Receives the period.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_time_zone_lookup_cached(
+    const fossil_time_zone_t *zone,
+    int64_t utc_seconds,
+    fossil_time_zone_period_t *out
+);
+
+/**
+ * @brief Get a zone's UT offset at a UTC instant.
+ *
+ * Uses the per-thread period cache.
+ *
+ * @param zone   Zone handle.
+ * @param utc_ns Nanoseconds since the Unix epoch.
+ * @return Offset in seconds east of UTC (0 if @p zone is NULL).
+ */
+int32_t fossil_time_zone_offset(
+    const fossil_time_zone_t *zone,
+    int64_t utc_ns
+);
+
+/**
+ * @brief Convert a UTC instant to local wall-clock time in a zone.
+ *
+ * Fills every field down to nanoseconds and sets tz_offset_min, using the
+ * per-thread period cache. Historic offsets that are not whole minutes
+ * (local mean time) are truncated in tz_offset_min; the wall-clock fields
+ * are exact.
+ *
+ * @param zone   Zone handle.
+ * @param utc_ns Nanoseconds since the Unix epoch.
+ * @param out    Receives the local date/time.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_time_zone_to_local(
+    const fossil_time_zone_t *zone,
+    int64_t utc_ns,
+    fossil_time_date_t *out
+);
+
+/**
+ * @brief Convert a local wall-clock time in a zone to UTC.
+ *
+ * Resolved from the zone's transition table without going through the C
+ * library's mktime or the process TZ. Fields are read as in
+ * fossil_time_zone_to_utc_batch; tz_offset_min is ignored.
+ *
+ * @param zone       Zone handle.
+ * @param local      Local date.
+ * @param policy     Resolution of repeated and skipped wall times.
+ * @param out_utc_ns Receives nanoseconds since the Unix epoch.
+ * @return 0 on success, -1 on invalid arguments, when the policy rejects, or
+ *         when the instant lies outside the int64 nanosecond range
+ *         (before 1677 or after 2262).
+ */
+int fossil_time_zone_to_utc(
+    const fossil_time_zone_t *zone,
+    const fossil_time_date_t *local,
+    fossil_time_zone_policy_t policy,
+    int64_t *out_utc_ns
+);
+
+/* ======================================================
+ * C API — Batch conversion
+ * ====================================================== */
+
+/**
+ * @brief Convert a column of UTC instants to local wall-clock time.
+ *
+ * Equivalent to fossil_time_zone_to_local per element, but built for
+ * columns: the current period is kept across rows, so sorted input only
+ * searches the transition table when it crosses a transition (a merge of
+ * the column with the table), and rows falling on the same local day
+ * reuse its calendar breakdown. Unsorted input is correct, just slower.
+ *
+ * @param zone   Zone handle.
+ * @param utc_ns Array of nanoseconds since the Unix epoch.
+ * @param count  Number of elements.
+ * @param out    Receives one local date per element.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_time_zone_to_local_batch(
+    const fossil_time_zone_t *zone,
+    const int64_t *utc_ns,
+    size_t count,
+    fossil_time_date_t *out
+);
+
+/**
+ * @brief Convert a column of local wall-clock times in a zone to UTC.
+ *
+ * Reads the calendar, clock and sub-second fields of each date (as
+ * fossil_time_date_to_unix_nanoseconds does) and ignores tz_offset_min;
+ * the offset comes from the zone. Repeated and skipped wall times are
+ * resolved by the policy; rows it rejects, and rows whose instant lies
+ * outside the int64 nanosecond range, receive INT64_MIN. Rows well inside
+ * the previous row's period skip the table entirely.
+ *
+ * @param zone       Zone handle.
+ * @param local      Array of local dates.
+ * @param count      Number of elements.
+ * @param policy     Resolution of repeated and skipped wall times.
+ * @param out_utc_ns Receives nanoseconds since the Unix epoch per element.
+ * @return Number of rejected rows (0 when all converted), -1 on invalid arguments.
+ */
+int fossil_time_zone_to_utc_batch(
+    const fossil_time_zone_t *zone,
+    const fossil_time_date_t *local,
+    size_t count,
+    fossil_time_zone_policy_t policy,
+    int64_t *out_utc_ns
+);
+
+/* ======================================================
+ * C API — Formatting
+ * ====================================================== */
+
+/**
+ * @brief Format a UTC instant as local ISO 8601 time in a zone.
+ *
+ * Formats:
+ *   - "iso":  offset designator, e.g. "2024-07-01T14:00:00+02:00"; the
+ *             same text fossil_time_date_format writes for the local date
+ *   - "abbr": zone abbreviation, e.g. "2024-07-01T14:00:00 CEST"
+ *
+ * @param zone        Zone handle.
+ * @param utc_ns      Nanoseconds since the Unix epoch.
+ * @param buffer      Output buffer for the formatted string.
+ * @param buffer_size Size of the output buffer in bytes.
+ * @param format_id   "iso" or "abbr".
+ * @return Number of characters the full string needs (excluding null terminator),
+ *         or -1 on invalid arguments or an unknown format.
+ */
+int fossil_time_zone_format(
+    const fossil_time_zone_t *zone,
+    int64_t utc_ns,
+    char *buffer,
+    size_t buffer_size,
+    const char *format_id
+);
+
+/**
+ * @brief Format a column of UTC instants as local time into fixed-width rows.
+ *
+ * Row i is written to buffer + i * stride as fossil_time_zone_format would
+ * write it into a buffer of stride bytes. The offset or abbreviation text
+ * is rendered once per period and reused for every row inside it, and the
+ * local conversion keeps the period across rows as
+ * fossil_time_zone_to_local_batch does.
+ *
+ * @param zone      Zone handle.
+ * @param utc_ns    Array of nanoseconds since the Unix epoch.
+ * @param count     Number of elements.
+ * @param buffer    Output buffer of count * stride bytes.
+ * @param stride    Bytes per row, including the null terminator.
+ * @param format_id "iso" or "abbr".
+ * @return 0 on success, -1 on invalid arguments or an unknown format.
+ */
+int fossil_time_zone_format_batch(
+    const fossil_time_zone_t *zone,
+    const int64_t *utc_ns,
+    size_t count,
+    char *buffer,
+    size_t stride,
+    const char *format_id
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/* ======================================================
+ * C++ Wrapper — Thin, Inline
+ * ====================================================== */
+
+#ifdef __cplusplus
+namespace fossil {
+namespace time {
+
+class Zone {
+public:
+    fossil_time_zone_t *raw;
+
+    /**
+     * Default constructor.
+     * Initializes a closed zone.
+     */
+    Zone() : raw(nullptr) { }
+
+    /**
+     * Open a zone by IANA name; check is_open() for success.
+     */
+    explicit Zone(const char *name) : raw(fossil_time_zone_open(name)) { }
+
+    /**
+     * Destructor.
+     * Closes the zone.
+     */
+    ~Zone() {
+        fossil_time_zone_close(raw);
+    }
+
+    Zone(const Zone &) = delete;
+    Zone &operator=(const Zone &) = delete;
+
+    /**
+     * Open a zone by IANA name, closing any zone held before.
+     * Returns true on success.
+     */
+    inline bool open(const char *name) {
+        fossil_time_zone_close(raw);
+        raw = fossil_time_zone_open(name);
+        return raw != nullptr;
+    }
+
+    /**
+     * Take a reference to the process-wide shared zone for a name,
+     * releasing any zone held before. Returns true on success.
+     */
+    inline bool get(const char *name) {
+        fossil_time_zone_close(raw);
+        raw = fossil_time_zone_get(name);
+        return raw != nullptr;
+    }
+
+    /**
+     * Reload shared zones; NULL reloads all. Returns the number reloaded.
+     */
+    static inline int reload(const char *name = nullptr) {
+        return fossil_time_zone_reload(name);
+    }
+
+    /**
+     * Open a zone from the database compiled into the library, closing
+     * any zone held before. Returns true on success.
+     */
+    inline bool open_embedded(const char *name) {
+        fossil_time_zone_close(raw);
+        raw = fossil_time_zone_open_embedded(name);
+        return raw != nullptr;
+    }
+
+    /**
+     * Whether a zone is open.
+     */
+    inline bool is_open() const {
+        return raw != nullptr;
+    }
+
+    /**
+     * Name the zone was opened with.
+     */
+    inline const char *name() const {
+        return fossil_time_zone_name(raw);
+    }
+
+    /**
+     * Find the period containing a UTC instant.
+     * Returns true on success.
+     */
+    inline bool lookup(int64_t utc_seconds, fossil_time_zone_period_t &out) const {
+        return fossil_time_zone_lookup(raw, utc_seconds, &out) == 0;
+    }
+
+    /**
+     * Find the period containing a UTC instant via the per-thread cache.
+     * Returns true on success.
+     */
+    inline bool lookup_cached(int64_t utc_seconds, fossil_time_zone_period_t &out) const {
+        return fossil_time_zone_lookup_cached(raw, utc_seconds, &out) == 0;
+    }
+
+    /**
+     * UT offset in seconds east of UTC at a UTC instant.
+     */
+    inline int32_t offset(int64_t utc_ns) const {
+        return fossil_time_zone_offset(raw, utc_ns);
+    }
+
+    /**
+     * Local wall-clock time of a UTC instant.
+     */
+    inline Date to_local(int64_t utc_ns) const {
+        fossil_time_date_t dt{};
+        fossil_time_zone_to_local(raw, utc_ns, &dt);
+        return Date(dt);
+    }
+
+    /**
+     * Local wall-clock times of a column of UTC instants.
+     * Returns true on success.
+     */
+    inline bool to_local(const int64_t *utc_ns, size_t count, fossil_time_date_t *out) const {
+        return fossil_time_zone_to_local_batch(raw, utc_ns, count, out) == 0;
+    }
+
+    /**
+     * Format a UTC instant as local time: "iso" or "abbr".
+     * Returns the length of the full string, or -1 on error.
+     */
+    inline int format(int64_t utc_ns, char *buffer, size_t buffer_size,
+                      const char *format_id = "iso") const {
+        return fossil_time_zone_format(raw, utc_ns, buffer, buffer_size, format_id);
+    }
+
+    /**
+     * Format a column of UTC instants into rows of stride bytes.
+     * Returns true on success.
+     */
+    inline bool format(const int64_t *utc_ns, size_t count, char *buffer, size_t stride,
+                       const char *format_id = "iso") const {
+        return fossil_time_zone_format_batch(raw, utc_ns, count, buffer, stride, format_id) == 0;
+    }
+
+    /**
+     * UTC instant of a local wall-clock time.
+     * Returns true on success, false when the policy rejects it.
+     */
+    inline bool to_utc(const Date &local, int64_t &out_utc_ns,
+                       fossil_time_zone_policy_t policy = FOSSIL_TIME_ZONE_SHIFT_FORWARD) const {
+        return fossil_time_zone_to_utc(raw, &local.raw, policy, &out_utc_ns) == 0;
+    }
+
+    /**
+     * UTC instants of a column of local wall-clock times.
+     * Returns true when every row converted.
+     */
+    inline bool to_utc(const fossil_time_date_t *local, size_t count, int64_t *out_utc_ns,
+                       fossil_time_zone_policy_t policy = FOSSIL_TIME_ZONE_SHIFT_FORWARD) const {
+        return fossil_time_zone_to_utc_batch(raw, local, count, policy, out_utc_ns) == 0;
+    }
+};
+
+} /* namespace time */
+} /* namespace fossil */
+#endif
+
+#endif /* FOSSIL_TIME_ZONE_H */
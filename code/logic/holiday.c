@@ -197,6 +197,11 @@ int fossil_holiday_list(int year,
     return 0;
 }
 
+size_t fossil_holiday_count(void)
+{
+    return g_holiday_count;
+}
+
 /* ======================================================
  * Default U.S. Federal Holidays
  * ====================================================== */
@@ -0,0 +1,261 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/time/index.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#  include <xmmintrin.h>
+#endif
+
+/* ======================================================
+ * Internal helpers
+ * ====================================================== */
+
+/* Keys per 64-byte cache line; the block eight slots below k is one line */
+#define FOSSIL_INDEX_LINE_KEYS 8
+#define FOSSIL_INDEX_ALIGN     64
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define FOSSIL_INDEX_PREFETCH(p) __builtin_prefetch((const void *)(p))
+#elif defined(_MSC_VER)
+#  define FOSSIL_INDEX_PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#  define FOSSIL_INDEX_PREFETCH(p) ((void)0)
+#endif
+
+/* Number of trailing one bits, plus one: undoes the final descent */
+static unsigned fossil_index_unwind(size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(~(unsigned long long)k) + 1;
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long bit;
+    _BitScanForward64(&bit, ~(unsigned long long)k);
+    return (unsigned)bit + 1;
+#else
+    unsigned n = 1;
+    while (k & 1) {
+        k >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static size_t fossil_index_fill(
+    fossil_time_index_t *index,
+    const int64_t *sorted,
+    size_t i,
+    size_t k
+) {
+    if (k <= index->count) {
+        i = fossil_index_fill(index, sorted, i, 2 * k);
+        index->keys[k]  = sorted[i];
+        index->ranks[k] = i;
+        i++;
+        i = fossil_index_fill(index, sorted, i, 2 * k + 1);
+    }
+    return i;
+}
+
+static int fossil_index_alloc(fossil_time_index_t *index, size_t count) {
+    size_t key_bytes = (count + 1) * sizeof(int64_t);
+    size_t rank_bytes = (count + 1) * sizeof(size_t);
+
+    if (count > (SIZE_MAX - FOSSIL_INDEX_ALIGN) / (sizeof(int64_t) + sizeof(size_t)) - 1)
+        return -1;
+
+    unsigned char *base = (unsigned char *)malloc(
+        key_bytes + rank_bytes + FOSSIL_INDEX_ALIGN
+    );
+    if (!base)
+        return -1;
+
+    /* Align keys[0] so each block of eight descendants is one cache line */
+    uintptr_t addr = (uintptr_t)base;
+    size_t pad = (FOSSIL_INDEX_ALIGN - (addr % FOSSIL_INDEX_ALIGN)) % FOSSIL_INDEX_ALIGN;
+
+    index->storage = base;
+    index->keys    = (int64_t *)(void *)(base + pad);
+    index->ranks   = (size_t *)(void *)(base + pad + key_bytes);
+    index->count   = count;
+    index->keys[0]  = 0;
+    index->ranks[0] = count;
+    return 0;
+}
+
+/*
+ * Branchless Eytzinger descent. Returns the slot of the first key for which
+ * (key < x) is false (strict != 0) or (key <= x) is false (strict == 0),
+ * or 0 when every key qualifies.
+ */
+static size_t fossil_index_descend(
+    const fossil_time_index_t *index,
+    int64_t x,
+    int strict
+) {
+    const int64_t *keys = index->keys;
+    size_t n = index->count;
+    size_t k = 1;
+
+    if (strict) {
+        while (k <= n) {
+            FOSSIL_INDEX_PREFETCH(keys + k * FOSSIL_INDEX_LINE_KEYS);
+            k = 2 * k + (size_t)(keys[k] < x);
+        }
+    } else {
+        while (k <= n) {
+            FOSSIL_INDEX_PREFETCH(keys + k * FOSSIL_INDEX_LINE_KEYS);
+            k = 2 * k + (size_t)(keys[k] <= x);
+        }
+    }
+
+    return k >> fossil_index_unwind(k);
+}
+
+/* In-order predecessor of slot k (0 = past the end), or 0 if none */
+static size_t fossil_index_prev(const fossil_time_index_t *index, size_t k) {
+    size_t n = index->count;
+
+    if (k == 0) {
+        k = 1;
+        while (2 * k + 1 <= n)
+            k = 2 * k + 1;
+        return k;
+    }
+
+    if (2 * k <= n) {
+        k = 2 * k;
+        while (2 * k + 1 <= n)
+            k = 2 * k + 1;
+        return k;
+    }
+
+    while ((k & 1) == 0)
+        k >>= 1;
+    return k >> 1;
+}
+
+/* ======================================================
+ * C API — Construction
+ * ====================================================== */
+
+int fossil_time_index_build(
+    fossil_time_index_t *index,
+    const int64_t *epoch_ns,
+    size_t count
+) {
+    if (!index || (!epoch_ns && count > 0))
+        return -1;
+
+    fossil_time_index_free(index);
+
+    for (size_t i = 1; i < count; ++i) {
+        if (epoch_ns[i] < epoch_ns[i - 1])
+            return -1;
+    }
+
+    if (fossil_index_alloc(index, count) != 0)
+        return -1;
+
+    fossil_index_fill(index, epoch_ns, 0, 1);
+    return 0;
+}
+
+int fossil_time_index_build_dates(
+    fossil_time_index_t *index,
+    const fossil_time_date_t *dates,
+    size_t count
+) {
+    if (!index || (!dates && count > 0))
+        return -1;
+
+    int64_t *tmp = (int64_t *)malloc((count ? count : 1) * sizeof(int64_t));
+    if (!tmp)
+        return -1;
+
+    for (size_t i = 0; i < count; ++i)
+        tmp[i] = fossil_time_date_to_unix_nanoseconds(&dates[i]);
+
+    int rc = fossil_time_index_build(index, tmp, count);
+    free(tmp);
+    return rc;
+}
+
+void fossil_time_index_free(
+    fossil_time_index_t *index
+) {
+    if (!index) return;
+    free(index->storage);
+    memset(index, 0, sizeof(*index));
+}
+
+/* ======================================================
+ * C API — Lookup
+ * ====================================================== */
+
+size_t fossil_time_index_lower_bound(
+    const fossil_time_index_t *index,
+    int64_t epoch_ns
+) {
+    if (!index || index->count == 0)
+        return 0;
+    return index->ranks[fossil_index_descend(index, epoch_ns, 1)];
+}
+
+size_t fossil_time_index_upper_bound(
+    const fossil_time_index_t *index,
+    int64_t epoch_ns
+) {
+    if (!index || index->count == 0)
+        return 0;
+    return index->ranks[fossil_index_descend(index, epoch_ns, 0)];
+}
+
+size_t fossil_time_index_nearest(
+    const fossil_time_index_t *index,
+    int64_t epoch_ns
+) {
+    if (!index || index->count == 0)
+        return 0;
+
+    size_t hi = fossil_index_descend(index, epoch_ns, 1);
+    size_t lo = fossil_index_prev(index, hi);
+
+    if (lo != 0 && hi != 0) {
+        /* Compare distances as unsigned to stay defined across the full range */
+        uint64_t below = (uint64_t)epoch_ns - (uint64_t)index->keys[lo];
+        uint64_t above = (uint64_t)index->keys[hi] - (uint64_t)epoch_ns;
+
+        if (above < below)
+            return index->ranks[hi];
+    } else if (lo == 0) {
+        return index->ranks[hi];
+    }
+
+    /* The predecessor may sit inside a run of equal keys; report its first */
+    return index->ranks[fossil_index_descend(index, index->keys[lo], 1)];
+}
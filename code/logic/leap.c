@@ -0,0 +1,590 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/time/leap.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#endif
+
+/* ======================================================
+ * Internal helpers
+ * ====================================================== */
+
+#define FOSSIL_LEAP_NS_PER_SEC 1000000000LL
+#define FOSSIL_LEAP_NTP_TO_UNIX 2208988800LL     /* 1900-01-01 to 1970-01-01 */
+#define FOSSIL_LEAP_GPS_EPOCH 315964800LL        /* 1980-01-06T00:00:00Z */
+#define FOSSIL_LEAP_GPS_TAI 19LL                 /* TAI − GPS, fixed */
+#define FOSSIL_LEAP_MAX_LINE 256
+#define FOSSIL_LEAP_SMEAR_MIN 2LL
+#define FOSSIL_LEAP_SMEAR_MAX (7 * 86400LL)      /* far below the gap between leap seconds */
+
+#if defined(_MSC_VER)
+#  define FOSSIL_LEAP_LOAD_PTR(p)     InterlockedCompareExchangePointer((PVOID volatile *)(p), NULL, NULL)
+#  define FOSSIL_LEAP_STORE_PTR(p, v) (void)InterlockedExchangePointer((PVOID volatile *)(p), (PVOID)(v))
+#  define FOSSIL_LEAP_LOAD64(p)       InterlockedCompareExchange64((p), 0, 0)
+#  define FOSSIL_LEAP_STORE64(p, v)   (void)InterlockedExchange64((p), (v))
+#  define FOSSIL_LEAP_CAS64(p, e, v)  (InterlockedCompareExchange64((p), (v), (e)) == (e))
+#else
+#  define FOSSIL_LEAP_LOAD_PTR(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#  define FOSSIL_LEAP_STORE_PTR(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#  define FOSSIL_LEAP_LOAD64(p)       __atomic_load_n((p), __ATOMIC_RELAXED)
+#  define FOSSIL_LEAP_STORE64(p, v)   __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#  define FOSSIL_LEAP_CAS64(p, e, v) \
+        __atomic_compare_exchange_n((p), &(e), (v), 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#endif
+
+typedef struct fossil_leap_entry_t {
+    int64_t utc;     /* Unix second from which offset applies */
+    int32_t offset;  /* TAI − UTC */
+} fossil_leap_entry_t;
+
+typedef struct fossil_leap_table_t {
+    size_t count;
+    int64_t expires;
+    const fossil_leap_entry_t *entries;
+} fossil_leap_table_t;
+
+/* A run of seconds on one scale sharing a single offset: [lo, hi) */
+typedef struct fossil_leap_segment_t {
+    int64_t lo;
+    int64_t hi;
+    int64_t offset_ns;
+    int tai;          /* scale of lo and hi: 0 = UTC, 1 = TAI */
+} fossil_leap_segment_t;
+
+/* IERS Bulletin C 71, valid until 2026-06-28 */
+static const fossil_leap_entry_t g_builtin_entries[] = {
+    {   63072000, 10 }, {   78796800, 11 }, {   94694400, 12 }, {  126230400, 13 },
+    {  157766400, 14 }, {  189302400, 15 }, {  220924800, 16 }, {  252460800, 17 },
+    {  283996800, 18 }, {  315532800, 19 }, {  362793600, 20 }, {  394329600, 21 },
+    {  425865600, 22 }, {  489024000, 23 }, {  567993600, 24 }, {  631152000, 25 },
+    {  662688000, 26 }, {  709948800, 27 }, {  741484800, 28 }, {  773020800, 29 },
+    {  820454400, 30 }, {  867715200, 31 }, {  915148800, 32 }, { 1136073600, 33 },
+    { 1230768000, 34 }, { 1341100800, 35 }, { 1435708800, 36 }, { 1483228800, 37 }
+};
+
+static const fossil_leap_table_t g_builtin = {
+    sizeof(g_builtin_entries) / sizeof(g_builtin_entries[0]),
+    1782604800,
+    g_builtin_entries
+};
+
+/* Replaced tables are never freed: a reader may still be walking one, and
+ * a process loads a handful at most. */
+static const fossil_leap_table_t *volatile g_table = &g_builtin;
+
+/* Smear window in seconds (0 = off) and the latest smeared clock reading */
+static volatile int64_t g_smear_window = 0;
+static volatile int64_t g_smear_last = INT64_MIN;
+
+static const fossil_leap_table_t *current_table(void) {
+    return (const fossil_leap_table_t *)FOSSIL_LEAP_LOAD_PTR(&g_table);
+}
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0)))
+        q--;
+    return q;
+}
+
+static int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+/* First TAI second of entry i. An inserted second belongs to the old
+ * offset and a removed one never happens, so the boundary uses the
+ * smaller of the two offsets. */
+static int64_t tai_begin(const fossil_leap_table_t *table, size_t i) {
+    const fossil_leap_entry_t *e = &table->entries[i];
+    int32_t offset = e->offset;
+    if (i > 0 && table->entries[i - 1].offset < offset)
+        offset = table->entries[i - 1].offset;
+    return e->utc + offset;
+}
+
+static int64_t entry_begin(const fossil_leap_table_t *table, size_t i, int tai) {
+    return tai ? tai_begin(table, i) : table->entries[i].utc;
+}
+
+/* Index of the last entry whose start is <= sec, or -1 */
+static long entry_find(const fossil_leap_table_t *table, int64_t sec, int tai) {
+    size_t n = table->count;
+    if (n == 0 || sec < entry_begin(table, 0, tai))
+        return -1;
+    if (sec >= entry_begin(table, n - 1, tai))
+        return (long)(n - 1); /* fast path: every instant since 2017 */
+
+    size_t lo = 0, hi = n - 1;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (entry_begin(table, mid, tai) <= sec)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return (long)lo;
+}
+
+static void segment_find(
+    const fossil_leap_table_t *table,
+    int64_t sec,
+    int tai,
+    fossil_leap_segment_t *seg
+) {
+    long i = entry_find(table, sec, tai);
+    size_t n = table->count;
+
+    if (n == 0) {
+        seg->lo = INT64_MIN;
+        seg->hi = INT64_MAX;
+        seg->offset_ns = 0;
+        return;
+    }
+    if (i < 0) {
+        seg->lo = INT64_MIN;
+        seg->hi = entry_begin(table, 0, tai);
+        seg->offset_ns = table->entries[0].offset * FOSSIL_LEAP_NS_PER_SEC;
+        return;
+    }
+    seg->lo = entry_begin(table, (size_t)i, tai);
+    seg->hi = ((size_t)i + 1 < n) ? entry_begin(table, (size_t)i + 1, tai) : INT64_MAX;
+    seg->offset_ns = table->entries[i].offset * FOSSIL_LEAP_NS_PER_SEC;
+}
+
+/* a + b, or INT64_MIN (the conversion error value) past the int64 range */
+static int64_t add_ns(int64_t a, int64_t b) {
+    if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b))
+        return INT64_MIN;
+    return a + b;
+}
+
+/* TAI − UTC in ns at ns on the UTC (tai == 0) or TAI (tai == 1) scale */
+static int64_t segment_offset(
+    const fossil_leap_table_t *table,
+    fossil_leap_segment_t *seg,
+    int64_t ns,
+    int tai
+) {
+    int64_t sec = floor_div(ns, FOSSIL_LEAP_NS_PER_SEC);
+    if (sec < seg->lo || sec >= seg->hi || seg->tai != tai) {
+        segment_find(table, sec, tai, seg);
+        seg->tai = tai;
+    }
+    return seg->offset_ns;
+}
+
+/* One leap second's smear: [start, start + window) on the UTC scale and
+ * [tai_lo, tai_hi) on the TAI scale, all in seconds */
+typedef struct fossil_leap_smear_t {
+    int64_t start;
+    int64_t tai_lo;
+    int64_t tai_hi;
+    int64_t window;
+    int32_t delta;
+} fossil_leap_smear_t;
+
+/* Find the smear covering sec on the UTC (tai == 0) or TAI (tai == 1) scale */
+static int smear_find(
+    const fossil_leap_table_t *table,
+    int64_t window,
+    int64_t sec,
+    int tai,
+    fossil_leap_smear_t *smear
+) {
+    long i = entry_find(table, sec, tai);
+
+    /* Windows are shorter than the gap between leap seconds, so only the
+     * entry in effect and the next one can cover sec */
+    for (long j = (i < 1 ? 1 : i); j <= i + 1 && (size_t)j < table->count; j++) {
+        const fossil_leap_entry_t *e = &table->entries[j];
+        smear->start  = e->utc - window / 2;
+        smear->tai_lo = smear->start + table->entries[j - 1].offset;
+        smear->tai_hi = smear->start + window + e->offset;
+        smear->window = window;
+        smear->delta  = e->offset - table->entries[j - 1].offset;
+
+        int64_t lo = tai ? smear->tai_lo : smear->start;
+        int64_t hi = tai ? smear->tai_hi : smear->start + window;
+        if (sec >= lo && sec < hi)
+            return 1;
+    }
+    return 0;
+}
+
+/* window + delta TAI seconds run as window smeared seconds */
+static int64_t smear_apply(const fossil_leap_smear_t *smear, int64_t tai_ns) {
+    int64_t elapsed = tai_ns - smear->tai_lo * FOSSIL_LEAP_NS_PER_SEC;
+    return smear->start * FOSSIL_LEAP_NS_PER_SEC + elapsed
+         - floor_div(elapsed * smear->delta, smear->window + smear->delta);
+}
+
+static int64_t smear_from_tai(
+    const fossil_leap_table_t *table,
+    fossil_leap_segment_t *seg,
+    int64_t window,
+    int64_t tai_ns,
+    int *in_window
+) {
+    fossil_leap_smear_t smear;
+
+    *in_window = smear_find(table, window, floor_div(tai_ns, FOSSIL_LEAP_NS_PER_SEC), 1, &smear);
+    if (!*in_window)
+        return add_ns(tai_ns, -segment_offset(table, seg, tai_ns, 1));
+    return smear_apply(&smear, tai_ns);
+}
+
+static int64_t smear_to_tai(
+    const fossil_leap_table_t *table,
+    fossil_leap_segment_t *seg,
+    int64_t window,
+    int64_t smeared_ns
+) {
+    fossil_leap_smear_t smear;
+
+    if (!smear_find(table, window, floor_div(smeared_ns, FOSSIL_LEAP_NS_PER_SEC), 0, &smear))
+        return add_ns(smeared_ns, segment_offset(table, seg, smeared_ns, 0));
+
+    /* Invert the rate, then settle on the first TAI instant that smears to
+     * at least smeared_ns; rounding leaves it at most a step or two off */
+    int64_t elapsed = smeared_ns - smear.start * FOSSIL_LEAP_NS_PER_SEC;
+    int64_t lo = smear.tai_lo * FOSSIL_LEAP_NS_PER_SEC;
+    int64_t tai = lo + elapsed + floor_div(elapsed * smear.delta, window);
+
+    while (smear_apply(&smear, tai) < smeared_ns)
+        tai++;
+    while (tai > lo && smear_apply(&smear, tai - 1) >= smeared_ns)
+        tai--;
+    return tai;
+}
+
+static int scale_valid(fossil_time_scale_t scale) {
+    return scale == FOSSIL_TIME_SCALE_UTC ||
+           scale == FOSSIL_TIME_SCALE_TAI ||
+           scale == FOSSIL_TIME_SCALE_GPS ||
+           scale == FOSSIL_TIME_SCALE_SMEAR;
+}
+
+static int64_t convert_one(
+    const fossil_leap_table_t *table,
+    fossil_leap_segment_t *seg,
+    int64_t window,
+    int64_t ns,
+    fossil_time_scale_t from,
+    fossil_time_scale_t to
+) {
+    const int64_t gps_shift = (FOSSIL_LEAP_GPS_EPOCH + FOSSIL_LEAP_GPS_TAI) * FOSSIL_LEAP_NS_PER_SEC;
+    int64_t tai;
+    int in_window;
+
+    if (from == to)
+        return ns;
+
+    /* With smearing off the smeared scale is plain UTC */
+    if (window == 0) {
+        if (from == FOSSIL_TIME_SCALE_SMEAR)
+            from = FOSSIL_TIME_SCALE_UTC;
+        if (to == FOSSIL_TIME_SCALE_SMEAR)
+            to = FOSSIL_TIME_SCALE_UTC;
+        if (from == to)
+            return ns;
+    }
+
+    switch (from) {
+        case FOSSIL_TIME_SCALE_UTC:   tai = add_ns(ns, segment_offset(table, seg, ns, 0)); break;
+        case FOSSIL_TIME_SCALE_GPS:   tai = add_ns(ns, gps_shift); break;
+        case FOSSIL_TIME_SCALE_SMEAR: tai = smear_to_tai(table, seg, window, ns); break;
+        default:                      tai = ns; break;
+    }
+    if (tai == INT64_MIN)
+        return INT64_MIN;
+
+    switch (to) {
+        case FOSSIL_TIME_SCALE_UTC:   return add_ns(tai, -segment_offset(table, seg, tai, 1));
+        case FOSSIL_TIME_SCALE_GPS:   return add_ns(tai, -gps_shift);
+        case FOSSIL_TIME_SCALE_SMEAR: return smear_from_tai(table, seg, window, tai, &in_window);
+        default:                      return tai;
+    }
+}
+
+/* ======================================================
+ * C API — Table
+ * ====================================================== */
+
+int fossil_time_leap_load(const char *path) {
+    if (!path)
+        return -1;
+
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return -1;
+
+    fossil_leap_entry_t *entries = NULL;
+    size_t count = 0, capacity = 0;
+    int64_t expires = 0;
+    int bad = 0;
+    char line[FOSSIL_LEAP_MAX_LINE];
+
+    while (!bad && fgets(line, sizeof(line), file)) {
+        char *end;
+
+        if (line[0] == '#') {
+            if (line[1] == '@') {
+                long long ntp = strtoll(line + 2, &end, 10);
+                if (end == line + 2)
+                    bad = 1;
+                else
+                    expires = (int64_t)ntp - FOSSIL_LEAP_NTP_TO_UNIX;
+            }
+            continue;
+        }
+
+        char *p = line;
+        while (*p == ' ' || *p == '\t')
+            p++;
+        if (*p == '\n' || *p == '\r' || *p == '\0')
+            continue;
+
+        long long ntp = strtoll(p, &end, 10);
+        if (end == p) {
+            bad = 1;
+            break;
+        }
+        p = end;
+        long long offset = strtoll(p, &end, 10);
+        if (end == p || offset < -1000 || offset > 1000) {
+            bad = 1;
+            break;
+        }
+
+        int64_t utc = (int64_t)ntp - FOSSIL_LEAP_NTP_TO_UNIX;
+        if (count > 0 && utc <= entries[count - 1].utc) {
+            bad = 1;
+            break;
+        }
+
+        if (count == capacity) {
+            size_t grown = capacity ? capacity * 2 : 32;
+            fossil_leap_entry_t *next = (fossil_leap_entry_t *)realloc(entries, grown * sizeof(*entries));
+            if (!next) {
+                bad = 1;
+                break;
+            }
+            entries = next;
+            capacity = grown;
+        }
+        entries[count].utc = utc;
+        entries[count].offset = (int32_t)offset;
+        count++;
+    }
+    fclose(file);
+
+    if (bad || count == 0) {
+        free(entries);
+        return -1;
+    }
+
+    /* Table header and entries in one block */
+    fossil_leap_table_t *table = (fossil_leap_table_t *)malloc(
+        sizeof(*table) + count * sizeof(*entries));
+    if (!table) {
+        free(entries);
+        return -1;
+    }
+    fossil_leap_entry_t *copy = (fossil_leap_entry_t *)(table + 1);
+    memcpy(copy, entries, count * sizeof(*entries));
+    free(entries);
+
+    table->count = count;
+    table->expires = expires;
+    table->entries = copy;
+    FOSSIL_LEAP_STORE_PTR(&g_table, table);
+    return (int)count;
+}
+
+void fossil_time_leap_reset(void) {
+    FOSSIL_LEAP_STORE_PTR(&g_table, &g_builtin);
+}
+
+size_t fossil_time_leap_count(void) {
+    return current_table()->count;
+}
+
+int64_t fossil_time_leap_expires(void) {
+    return current_table()->expires;
+}
+
+int32_t fossil_time_leap_tai_offset(int64_t utc_seconds) {
+    const fossil_leap_table_t *table = current_table();
+    long i = entry_find(table, utc_seconds, 0);
+    if (table->count == 0)
+        return 0;
+    return table->entries[i < 0 ? 0 : i].offset;
+}
+
+int fossil_time_leap_next(int64_t utc_seconds, int64_t *out_utc, int32_t *out_delta) {
+    const fossil_leap_table_t *table = current_table();
+    long i = entry_find(table, utc_seconds, 0);
+    size_t next = (size_t)(i < 0 ? 1 : i + 1);
+
+    if (next < 1 || next >= table->count)
+        return -1;
+    if (out_utc)
+        *out_utc = table->entries[next].utc;
+    if (out_delta)
+        *out_delta = table->entries[next].offset - table->entries[next - 1].offset;
+    return 0;
+}
+
+int fossil_time_leap_prev(int64_t utc_seconds, int64_t *out_utc, int32_t *out_delta) {
+    const fossil_leap_table_t *table = current_table();
+    long i = entry_find(table, utc_seconds, 0);
+
+    if (i < 1)
+        return -1;
+    if (out_utc)
+        *out_utc = table->entries[i].utc;
+    if (out_delta)
+        *out_delta = table->entries[i].offset - table->entries[i - 1].offset;
+    return 0;
+}
+
+int fossil_time_leap_second_valid(const fossil_time_date_t *dt) {
+    if (!dt || dt->second != 60 || dt->month < 1 || dt->month > 12)
+        return 0;
+
+    /* The POSIX second after the leap second is the midnight it precedes */
+    int64_t after = days_from_civil(dt->year, (unsigned)dt->month, (unsigned)dt->day) * 86400
+                  + dt->hour * 3600 + dt->minute * 60 + 60
+                  - (int64_t)dt->tz_offset_min * 60;
+
+    const fossil_leap_table_t *table = current_table();
+    long i = entry_find(table, after, 0);
+    return i >= 1 &&
+           table->entries[i].utc == after &&
+           table->entries[i].offset > table->entries[i - 1].offset;
+}
+
+/* ======================================================
+ * C API — Smearing
+ * ====================================================== */
+
+int fossil_time_leap_set_smear(int64_t window_seconds) {
+    if (window_seconds != 0 &&
+        (window_seconds < FOSSIL_LEAP_SMEAR_MIN || window_seconds > FOSSIL_LEAP_SMEAR_MAX))
+        return -1;
+    FOSSIL_LEAP_STORE64(&g_smear_window, window_seconds);
+    return 0;
+}
+
+int64_t fossil_time_leap_smear_window(void) {
+    return FOSSIL_LEAP_LOAD64(&g_smear_window);
+}
+
+int64_t fossil_time_leap_smear_clock(int64_t utc_ns) {
+    int64_t window = FOSSIL_LEAP_LOAD64(&g_smear_window);
+    if (window == 0)
+        return utc_ns;
+
+    const fossil_leap_table_t *table = current_table();
+    fossil_leap_segment_t seg = { 0, 0, 0, 0 };
+    int in_window;
+    int64_t tai = add_ns(utc_ns, segment_offset(table, &seg, utc_ns, 0));
+
+    /* No TAI instant means no leap second near: the smear is plain UTC */
+    if (tai == INT64_MIN)
+        return utc_ns;
+    int64_t smeared = smear_from_tai(table, &seg, window, tai, &in_window);
+
+    if (!in_window)
+        return smeared;
+
+    /* Keep the latest reading so the replayed second cannot step back */
+    for (;;) {
+        int64_t last = FOSSIL_LEAP_LOAD64(&g_smear_last);
+        if (smeared <= last)
+            return last;
+        if (FOSSIL_LEAP_CAS64(&g_smear_last, last, smeared))
+            return smeared;
+    }
+}
+
+/* ======================================================
+ * C API — Conversions
+ * ====================================================== */
+
+int64_t fossil_time_leap_convert(int64_t ns, fossil_time_scale_t from, fossil_time_scale_t to) {
+    if (!scale_valid(from) || !scale_valid(to))
+        return INT64_MIN;
+
+    fossil_leap_segment_t seg = { 0, 0, 0, 0 }; /* empty: forces a lookup */
+    return convert_one(current_table(), &seg, FOSSIL_LEAP_LOAD64(&g_smear_window), ns, from, to);
+}
+
+int fossil_time_leap_convert_batch(
+    const int64_t *in,
+    size_t count,
+    fossil_time_scale_t from,
+    fossil_time_scale_t to,
+    int64_t *out
+) {
+    if ((!in || !out) && count > 0)
+        return -1;
+    if (!scale_valid(from) || !scale_valid(to))
+        return -1;
+
+    const fossil_leap_table_t *table = current_table();
+    int64_t window = FOSSIL_LEAP_LOAD64(&g_smear_window);
+    fossil_leap_segment_t seg = { 0, 0, 0, 0 };
+
+    for (size_t i = 0; i < count; i++)
+        out[i] = convert_one(table, &seg, window, in[i], from, to);
+    return 0;
+}
+
+int64_t fossil_time_leap_utc_to_tai(int64_t utc_ns) {
+    return fossil_time_leap_convert(utc_ns, FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_TAI);
+}
+
+int64_t fossil_time_leap_tai_to_utc(int64_t tai_ns) {
+    return fossil_time_leap_convert(tai_ns, FOSSIL_TIME_SCALE_TAI, FOSSIL_TIME_SCALE_UTC);
+}
+
+int64_t fossil_time_leap_utc_to_gps(int64_t utc_ns) {
+    return fossil_time_leap_convert(utc_ns, FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_GPS);
+}
+
+int64_t fossil_time_leap_gps_to_utc(int64_t gps_ns) {
+    return fossil_time_leap_convert(gps_ns, FOSSIL_TIME_SCALE_GPS, FOSSIL_TIME_SCALE_UTC);
+}
@@ -0,0 +1,1375 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/time/query.h"
+#include "fossil/time/calendar.h"
+#include "fossil/time/holiday.h"
+#include "fossil/time/timer.h"
+#include <string.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <inttypes.h>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+/* ======================================================
+ * Internal helpers
+ * ====================================================== */
+
+#define FOSSIL_QUERY_MAX_TEXT 256
+#define FOSSIL_QUERY_NS_PER_SEC 1000000000LL
+
+/* Parallel scans: keep per-worker chunks large enough to amortize startup */
+#define FOSSIL_QUERY_MIN_ROWS_PER_WORKER 16384
+#define FOSSIL_QUERY_MAX_WORKERS 256
+
+/* Calendar sets: per-thread direct-mapped cache of year bitmaps */
+#define FOSSIL_QUERY_CALENDAR_SETS 5
+#define FOSSIL_QUERY_YEAR_WORDS 6     /* 366 bits */
+#define FOSSIL_QUERY_YEAR_SLOTS 16
+#define FOSSIL_QUERY_MAX_HOLIDAYS 128
+
+#if defined(_MSC_VER)
+#  define FOSSIL_QUERY_TLS __declspec(thread)
+#else
+#  define FOSSIL_QUERY_TLS _Thread_local
+#endif
+
+static int is_leap(int64_t year) {
+    return ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0));
+}
+
+static int days_in_month(int64_t year, int month) {
+    static const int days[] = {
+        31,28,31,30,31,30,31,31,30,31,30,31
+    };
+    if (month < 1 || month > 12) return 0;
+    if (month == 2 && is_leap(year)) return 29;
+    return days[month - 1];
+}
+
+static int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+static void civil_from_days(int64_t z, int64_t *y, int *m, int *d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    *d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *y = (int64_t)yoe + era * 400 + (*m <= 2);
+}
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+    return q;
+}
+
+static int64_t sat_add(int64_t a, int64_t b) {
+    if (b > 0 && a > INT64_MAX - b) return INT64_MAX;
+    if (b < 0 && a < INT64_MIN - b) return INT64_MIN;
+    return a + b;
+}
+
+static int64_t sat_mul(int64_t a, int64_t b) {
+    if (a == 0 || b == 0) return 0;
+    if (a > 0) {
+        if (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a)
+            return (b > 0) ? INT64_MAX : INT64_MIN;
+    } else {
+        if (b > 0 ? a < INT64_MIN / b : a < INT64_MAX / b)
+            return (b > 0) ? INT64_MIN : INT64_MAX;
+    }
+    return a * b;
+}
+
+/* Local wall-clock seconds (epoch-aligned, offset not applied) */
+static int64_t local_seconds(int64_t y, int m, int d, int64_t sod) {
+    return days_from_civil(y, (unsigned)m, (unsigned)d) * 86400 + sod;
+}
+
+/* Convert local wall-clock seconds of "now" to UTC epoch ns */
+static int64_t local_to_ns(int64_t local_sec, const fossil_time_date_t *now) {
+    return sat_mul(sat_add(local_sec, -(int64_t)now->tz_offset_min * 60),
+                   FOSSIL_QUERY_NS_PER_SEC);
+}
+
+static void trim(char **s) {
+    while (**s == ' ') (*s)++;
+    char *e = *s + strlen(*s);
+    while (e > *s && e[-1] == ' ') *--e = '\0';
+}
+
+static int parse_int(const char *s, int64_t *out) {
+    int neg = 0;
+    int64_t value = 0;
+
+    if (*s == '-' || *s == '+') {
+        neg = (*s == '-');
+        s++;
+    }
+    if (!isdigit((unsigned char)*s))
+        return 0;
+    while (*s) {
+        if (!isdigit((unsigned char)*s) || value > 100000000)
+            return 0;
+        value = value * 10 + (*s - '0');
+        s++;
+    }
+    *out = neg ? -value : value;
+    return 1;
+}
+
+/* ======================================================
+ * Internal: vocabulary
+ * ====================================================== */
+
+typedef enum {
+    UNIT_SECOND = 0, UNIT_MINUTE, UNIT_HOUR, UNIT_DAY,
+    UNIT_WEEK, UNIT_MONTH, UNIT_QUARTER, UNIT_YEAR
+} query_unit_t;
+
+static int parse_unit(const char *s, query_unit_t *out) {
+    static const struct { const char *name; query_unit_t unit; } units[] = {
+        {"second", UNIT_SECOND}, {"sec", UNIT_SECOND},
+        {"minute", UNIT_MINUTE}, {"min", UNIT_MINUTE},
+        {"hour", UNIT_HOUR},
+        {"day", UNIT_DAY},
+        {"week", UNIT_WEEK},
+        {"month", UNIT_MONTH},
+        {"quarter", UNIT_QUARTER},
+        {"year", UNIT_YEAR}
+    };
+    size_t len = strlen(s);
+
+    /* Accept plurals */
+    if (len > 1 && s[len - 1] == 's')
+        len--;
+
+    for (size_t i = 0; i < sizeof(units) / sizeof(*units); ++i) {
+        if (strlen(units[i].name) == len && !strncmp(units[i].name, s, len)) {
+            *out = units[i].unit;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int parse_field(const char *s, fossil_time_query_field_t *out) {
+    static const struct { const char *name; fossil_time_query_field_t field; } fields[] = {
+        {"year", FOSSIL_TIME_QUERY_FIELD_YEAR},      {"y", FOSSIL_TIME_QUERY_FIELD_YEAR},
+        {"month", FOSSIL_TIME_QUERY_FIELD_MONTH},    {"mon", FOSSIL_TIME_QUERY_FIELD_MONTH},
+        {"m", FOSSIL_TIME_QUERY_FIELD_MONTH},
+        {"day", FOSSIL_TIME_QUERY_FIELD_DAY},        {"d", FOSSIL_TIME_QUERY_FIELD_DAY},
+        {"hour", FOSSIL_TIME_QUERY_FIELD_HOUR},      {"h", FOSSIL_TIME_QUERY_FIELD_HOUR},
+        {"minute", FOSSIL_TIME_QUERY_FIELD_MINUTE},  {"min", FOSSIL_TIME_QUERY_FIELD_MINUTE},
+        {"second", FOSSIL_TIME_QUERY_FIELD_SECOND},  {"sec", FOSSIL_TIME_QUERY_FIELD_SECOND},
+        {"s", FOSSIL_TIME_QUERY_FIELD_SECOND},
+        {"weekday", FOSSIL_TIME_QUERY_FIELD_WEEKDAY}, {"wday", FOSSIL_TIME_QUERY_FIELD_WEEKDAY},
+        {"dow", FOSSIL_TIME_QUERY_FIELD_WEEKDAY},
+        {"yearday", FOSSIL_TIME_QUERY_FIELD_YEARDAY}, {"yday", FOSSIL_TIME_QUERY_FIELD_YEARDAY},
+        {"millisecond", FOSSIL_TIME_QUERY_FIELD_MILLISECOND}, {"ms", FOSSIL_TIME_QUERY_FIELD_MILLISECOND},
+        {"microsecond", FOSSIL_TIME_QUERY_FIELD_MICROSECOND}, {"us", FOSSIL_TIME_QUERY_FIELD_MICROSECOND},
+        {"nanosecond", FOSSIL_TIME_QUERY_FIELD_NANOSECOND},   {"ns", FOSSIL_TIME_QUERY_FIELD_NANOSECOND},
+        {"tz_offset", FOSSIL_TIME_QUERY_FIELD_TZ_OFFSET}, {"tz", FOSSIL_TIME_QUERY_FIELD_TZ_OFFSET},
+        {"offset", FOSSIL_TIME_QUERY_FIELD_TZ_OFFSET},
+        {"quarter", FOSSIL_TIME_QUERY_FIELD_QUARTER}, {"q", FOSSIL_TIME_QUERY_FIELD_QUARTER}
+    };
+
+    for (size_t i = 0; i < sizeof(fields) / sizeof(*fields); ++i) {
+        if (!strcmp(fields[i].name, s)) {
+            *out = fields[i].field;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void set_field(
+    fossil_time_query_clause_t *c,
+    fossil_time_query_field_t field,
+    int64_t lo,
+    int64_t hi,
+    int negate
+) {
+    c->kind   = FOSSIL_TIME_QUERY_FIELD;
+    c->field  = field;
+    c->negate = negate;
+    c->lo     = lo;
+    c->hi     = hi;
+}
+
+static void set_range(fossil_time_query_clause_t *c, int64_t lo, int64_t hi) {
+    c->kind   = FOSSIL_TIME_QUERY_RANGE;
+    c->field  = FOSSIL_TIME_QUERY_FIELD_YEAR;
+    c->negate = 0;
+    c->lo     = lo;
+    c->hi     = hi;
+}
+
+/* ======================================================
+ * Internal: relative windows
+ * ====================================================== */
+
+/* Calendar-aligned period containing now, shifted by k periods */
+static void period_range(
+    const fossil_time_date_t *now,
+    query_unit_t unit,
+    int64_t k,
+    int64_t *lo,
+    int64_t *hi
+) {
+    int64_t sod = (int64_t)now->hour * 3600 + now->minute * 60 + now->second;
+    int64_t day = days_from_civil(now->year, (unsigned)now->month, (unsigned)now->day);
+    int64_t start = day * 86400 + sod;
+    int64_t end;
+
+    switch (unit) {
+        case UNIT_SECOND:
+        case UNIT_MINUTE:
+        case UNIT_HOUR:
+        case UNIT_DAY:
+        case UNIT_WEEK: {
+            static const int64_t len[] = { 1, 60, 3600, 86400, 604800 };
+            int64_t l = len[unit];
+            if (unit == UNIT_WEEK) {
+                int64_t wd = day - floor_div(day + 4, 7) * 7 + 4; /* 0 = Sunday */
+                start = (day - (wd + 6) % 7) * 86400;
+            } else {
+                start = floor_div(start, l) * l;
+            }
+            start = sat_add(start, sat_mul(k, l));
+            end = sat_add(start, l);
+            break;
+        }
+        default: {
+            int64_t months = (unit == UNIT_MONTH) ? 1 : (unit == UNIT_QUARTER) ? 3 : 12;
+            int64_t base = (int64_t)now->year * 12 + (now->month - 1);
+            int64_t first = base - ((unit == UNIT_MONTH) ? 0 :
+                            (unit == UNIT_QUARTER) ? (now->month - 1) % 3 : now->month - 1);
+            int64_t a = first + k * months;
+            int64_t b = a + months;
+            start = local_seconds(floor_div(a, 12), (int)(a - floor_div(a, 12) * 12) + 1, 1, 0);
+            end   = local_seconds(floor_div(b, 12), (int)(b - floor_div(b, 12) * 12) + 1, 1, 0);
+            break;
+        }
+    }
+
+    *lo = local_to_ns(start, now);
+    *hi = local_to_ns(end, now);
+}
+
+/* Signed distance in ns from now to now shifted by n units (calendar-aware) */
+static int64_t shift_ns(const fossil_time_date_t *now, query_unit_t unit, int64_t n) {
+    static const int64_t len[] = { 1, 60, 3600, 86400, 604800 };
+
+    if (unit <= UNIT_WEEK)
+        return sat_mul(sat_mul(n, len[unit]), FOSSIL_QUERY_NS_PER_SEC);
+
+    int64_t months = n * ((unit == UNIT_MONTH) ? 1 : (unit == UNIT_QUARTER) ? 3 : 12);
+    int64_t a = (int64_t)now->year * 12 + (now->month - 1) + months;
+    int64_t y = floor_div(a, 12);
+    int m = (int)(a - y * 12) + 1;
+    int d = now->day;
+    if (d > days_in_month(y, m))
+        d = days_in_month(y, m);
+
+    int64_t sod = (int64_t)now->hour * 3600 + now->minute * 60 + now->second;
+    int64_t from = local_seconds(now->year, now->month, now->day, sod);
+    int64_t to = local_seconds(y, m, d, sod);
+    return sat_mul(to - from, FOSSIL_QUERY_NS_PER_SEC);
+}
+
+static int compile_relative(
+    fossil_time_query_clause_t *c,
+    char *text,
+    const fossil_time_date_t *now
+) {
+    int64_t now_ns = fossil_time_date_to_unix_nanoseconds(now);
+    int64_t lo, hi;
+
+    if (!strcmp(text, "today") || !strcmp(text, "this day")) {
+        period_range(now, UNIT_DAY, 0, &lo, &hi);
+    } else if (!strcmp(text, "yesterday")) {
+        period_range(now, UNIT_DAY, -1, &lo, &hi);
+    } else if (!strcmp(text, "tomorrow")) {
+        period_range(now, UNIT_DAY, 1, &lo, &hi);
+    } else if (!strcmp(text, "past") || !strcmp(text, "in the past") ||
+               !strcmp(text, "before now") || !strcmp(text, "before today")) {
+        lo = INT64_MIN;
+        hi = now_ns;
+    } else if (!strcmp(text, "future") || !strcmp(text, "in the future") ||
+               !strcmp(text, "after now") || !strcmp(text, "after today")) {
+        lo = sat_add(now_ns, 1);
+        hi = INT64_MAX;
+    } else {
+        char word[16], unit_text[16];
+        int64_t n;
+        query_unit_t unit;
+        char *space = strchr(text, ' ');
+        if (!space || (size_t)(space - text) >= sizeof(word))
+            return 0;
+
+        memcpy(word, text, (size_t)(space - text));
+        word[space - text] = '\0';
+        char *rest = space + 1;
+        trim(&rest);
+
+        int back = !strcmp(word, "last") || !strcmp(word, "previous") ||
+                   !strcmp(word, "prev") || !strcmp(word, "past");
+        int ahead = !strcmp(word, "next");
+        int here = !strcmp(word, "this") || !strcmp(word, "current");
+        if (!back && !ahead && !here)
+            return 0;
+
+        char *gap = strchr(rest, ' ');
+        if (gap) {
+            /* Rolling window: "last 7 days", "next 3 hours" */
+            if (here || (size_t)(gap - rest) >= sizeof(unit_text))
+                return 0;
+            memcpy(unit_text, rest, (size_t)(gap - rest));
+            unit_text[gap - rest] = '\0';
+            if (!parse_int(unit_text, &n) || n < 0)
+                return 0;
+            char *u = gap + 1;
+            trim(&u);
+            if (!parse_unit(u, &unit))
+                return 0;
+            if (back) {
+                lo = sat_add(now_ns, shift_ns(now, unit, -n));
+                hi = now_ns;
+            } else {
+                lo = now_ns;
+                hi = sat_add(now_ns, shift_ns(now, unit, n));
+            }
+        } else {
+            /* Calendar period: "this week", "previous quarter" */
+            if (!strcmp(word, "past") || !parse_unit(rest, &unit))
+                return 0;
+            period_range(now, unit, back ? -1 : ahead ? 1 : 0, &lo, &hi);
+        }
+    }
+
+    set_range(c, lo, hi);
+    return 1;
+}
+
+/* ======================================================
+ * Internal: calendar year bitmaps
+ * ====================================================== */
+
+/*
+ * Each (year, region) pair expands once per thread into one bitmap per
+ * calendar set, indexed by zero-based day of the year. Registry-backed
+ * entries are stamped with fossil_holiday_count() so new registrations
+ * rebuild them.
+ */
+typedef struct fossil_query_year_t {
+    int valid;
+    int32_t year;
+    int32_t region;
+    size_t stamp;
+    uint64_t sets[FOSSIL_QUERY_CALENDAR_SETS][FOSSIL_QUERY_YEAR_WORDS];
+} fossil_query_year_t;
+
+static FOSSIL_QUERY_TLS fossil_query_year_t g_year_cache[FOSSIL_QUERY_YEAR_SLOTS];
+
+static const char *region_id(int32_t region) {
+    switch (region) {
+        case FOSSIL_TIME_QUERY_REGION_US: return "us";
+        case FOSSIL_TIME_QUERY_REGION_UK: return "uk";
+        case FOSSIL_TIME_QUERY_REGION_CA: return "ca";
+        default:                          return NULL;
+    }
+}
+
+static void set_bit(uint64_t *bits, int index) {
+    bits[index >> 6] |= 1ULL << (index & 63);
+}
+
+static int test_bit(const uint64_t *bits, int index) {
+    return (int)((bits[index >> 6] >> (index & 63)) & 1);
+}
+
+static void build_year(fossil_query_year_t *e, int32_t year, int32_t region, size_t stamp) {
+    uint64_t *weekend  = e->sets[FOSSIL_TIME_QUERY_CALENDAR_WEEKEND];
+    uint64_t *holiday  = e->sets[FOSSIL_TIME_QUERY_CALENDAR_HOLIDAY];
+    uint64_t *business = e->sets[FOSSIL_TIME_QUERY_CALENDAR_BUSINESS_DAY];
+    uint64_t *first    = e->sets[FOSSIL_TIME_QUERY_CALENDAR_FIRST_BUSINESS_OF_MONTH];
+    uint64_t *last     = e->sets[FOSSIL_TIME_QUERY_CALENDAR_LAST_BUSINESS_OF_MONTH];
+    int64_t day0 = days_from_civil(year, 1, 1);
+    int wd0 = (int)(day0 - floor_div(day0 + 4, 7) * 7 + 4);
+    const char *id = region_id(region);
+
+    memset(e, 0, sizeof(*e));
+    e->valid = 1;
+    e->year = year;
+    e->region = region;
+    e->stamp = stamp;
+
+    if (!id) {
+        fossil_time_date_t dates[FOSSIL_QUERY_MAX_HOLIDAYS];
+        size_t n = 0;
+
+        fossil_holiday_list(year, dates, FOSSIL_QUERY_MAX_HOLIDAYS, &n);
+        for (size_t i = 0; i < n; ++i) {
+            /* Observed dates pushed outside the month never match */
+            if (dates[i].day < 1 || dates[i].day > days_in_month(year, dates[i].month))
+                continue;
+            set_bit(holiday, (int)(days_from_civil(year, (unsigned)dates[i].month,
+                                                   (unsigned)dates[i].day) - day0));
+        }
+    }
+
+    int yd = 0;
+    for (int m = 1; m <= 12; ++m) {
+        int first_yd = -1, last_yd = -1;
+
+        for (int d = 1; d <= days_in_month(year, m); ++d, ++yd) {
+            int wd = (wd0 + yd) % 7;
+
+            if (id) {
+                fossil_time_date_t dt;
+                memset(&dt, 0, sizeof(dt));
+                dt.year = year;
+                dt.month = (int8_t)m;
+                dt.day = (int8_t)d;
+                dt.weekday = (int8_t)wd;
+                if (fossil_time_calendar_is_holiday(&dt, id))
+                    set_bit(holiday, yd);
+            }
+
+            if (wd == 0 || wd == 6) {
+                set_bit(weekend, yd);
+            } else if (!test_bit(holiday, yd)) {
+                set_bit(business, yd);
+                if (first_yd < 0)
+                    first_yd = yd;
+                last_yd = yd;
+            }
+        }
+
+        if (first_yd >= 0) {
+            set_bit(first, first_yd);
+            set_bit(last, last_yd);
+        }
+    }
+}
+
+static int calendar_test(const fossil_time_query_clause_t *c, const fossil_time_date_t *dt) {
+    int32_t region = (int32_t)c->hi;
+    size_t stamp = region_id(region) ? 0 : fossil_holiday_count();
+    fossil_query_year_t *e;
+
+    if (dt->month < 1 || dt->month > 12 || dt->day < 1 ||
+        dt->day > days_in_month(dt->year, dt->month))
+        return 0;
+
+    e = &g_year_cache[((uint32_t)dt->year * 4u + (uint32_t)region) % FOSSIL_QUERY_YEAR_SLOTS];
+    if (!e->valid || e->year != dt->year || e->region != region || e->stamp != stamp)
+        build_year(e, dt->year, region, stamp);
+
+    int yd = (int)(days_from_civil(dt->year, (unsigned)dt->month, (unsigned)dt->day) -
+                   days_from_civil(dt->year, 1, 1));
+    return test_bit(e->sets[c->lo], yd);
+}
+
+static int parse_region(const char *s, int64_t *out) {
+    static const struct { const char *name; fossil_time_query_region_t region; } regions[] = {
+        {"us", FOSSIL_TIME_QUERY_REGION_US}, {"us_federal", FOSSIL_TIME_QUERY_REGION_US},
+        {"uk", FOSSIL_TIME_QUERY_REGION_UK}, {"gb", FOSSIL_TIME_QUERY_REGION_UK},
+        {"ca", FOSSIL_TIME_QUERY_REGION_CA}, {"canada", FOSSIL_TIME_QUERY_REGION_CA}
+    };
+
+    if (!*s) {
+        *out = FOSSIL_TIME_QUERY_REGION_REGISTRY;
+        return 1;
+    }
+    for (size_t i = 0; i < sizeof(regions) / sizeof(*regions); ++i) {
+        if (!strcmp(regions[i].name, s)) {
+            *out = regions[i].region;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int compile_calendar(fossil_time_query_clause_t *c, const char *text) {
+    static const struct { const char *phrase; fossil_time_query_calendar_t set; } phrases[] = {
+        {"first business day of month", FOSSIL_TIME_QUERY_CALENDAR_FIRST_BUSINESS_OF_MONTH},
+        {"last business day of month",  FOSSIL_TIME_QUERY_CALENDAR_LAST_BUSINESS_OF_MONTH},
+        {"business days", FOSSIL_TIME_QUERY_CALENDAR_BUSINESS_DAY},
+        {"business day",  FOSSIL_TIME_QUERY_CALENDAR_BUSINESS_DAY},
+        {"workday",       FOSSIL_TIME_QUERY_CALENDAR_BUSINESS_DAY},
+        {"holidays",      FOSSIL_TIME_QUERY_CALENDAR_HOLIDAY},
+        {"holiday",       FOSSIL_TIME_QUERY_CALENDAR_HOLIDAY}
+    };
+    int negate = 0;
+    int64_t region;
+
+    if (!strncmp(text, "not ", 4)) {
+        negate = 1;
+        text += 4;
+        while (*text == ' ') text++;
+    }
+
+    for (size_t i = 0; i < sizeof(phrases) / sizeof(*phrases); ++i) {
+        size_t n = strlen(phrases[i].phrase);
+        const char *rest = text + n;
+
+        if (strncmp(text, phrases[i].phrase, n) != 0 || (*rest && *rest != ' '))
+            continue;
+        while (*rest == ' ') rest++;
+        if (!parse_region(rest, &region))
+            return 0;
+
+        memset(c, 0, sizeof(*c));
+        c->kind = FOSSIL_TIME_QUERY_CALENDAR;
+        c->negate = negate;
+        c->lo = phrases[i].set;
+        c->hi = region;
+        return 1;
+    }
+    return 0;
+}
+
+/* ======================================================
+ * Internal: clause compiler
+ * ====================================================== */
+
+static int compile_keyword(fossil_time_query_clause_t *c, const char *text) {
+    static const char *weekdays[] = {
+        "sunday", "monday", "tuesday", "wednesday",
+        "thursday", "friday", "saturday"
+    };
+
+    if (!strcmp(text, "weekend") || !strcmp(text, "is weekend")) {
+        set_field(c, FOSSIL_TIME_QUERY_FIELD_WEEKDAY, 1, 6, 1);
+        return 1;
+    }
+    if (!strcmp(text, "weekday") || !strcmp(text, "is weekday")) {
+        set_field(c, FOSSIL_TIME_QUERY_FIELD_WEEKDAY, 1, 6, 0);
+        return 1;
+    }
+    if (!strcmp(text, "first of month")) {
+        set_field(c, FOSSIL_TIME_QUERY_FIELD_DAY, 1, 2, 0);
+        return 1;
+    }
+    if (!strcmp(text, "leap year")) {
+        memset(c, 0, sizeof(*c));
+        c->kind = FOSSIL_TIME_QUERY_LEAP_YEAR;
+        return 1;
+    }
+    if (!strcmp(text, "last of month")) {
+        memset(c, 0, sizeof(*c));
+        c->kind = FOSSIL_TIME_QUERY_LAST_OF_MONTH;
+        return 1;
+    }
+    for (int i = 0; i < 7; ++i) {
+        if (!strcmp(text, weekdays[i])) {
+            set_field(c, FOSSIL_TIME_QUERY_FIELD_WEEKDAY, i, i + 1, 0);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int compile_comparison(fossil_time_query_clause_t *c, char *text) {
+    static const struct { const char *word; const char *op; } english[] = {
+        {" is not ", "!="}, {" not equals ", "!="}, {" equals ", "="},
+        {" on or before ", "<="}, {" on or after ", ">="},
+        {" before ", "<"}, {" after ", ">"}, {" is ", "="}
+    };
+    fossil_time_query_field_t field;
+    char *lhs = text;
+    char *rhs = NULL;
+    char op[4] = {0};
+    int64_t v, v2;
+
+    /* Range: "year in 2020..2025" */
+    char *in = strstr(text, " in ");
+    char *dots = in ? strstr(in, "..") : NULL;
+    if (in && dots) {
+        *in = '\0';
+        *dots = '\0';
+        char *a = in + 4;
+        char *b = dots + 2;
+        trim(&lhs); trim(&a); trim(&b);
+        if (!parse_field(lhs, &field) || !parse_int(a, &v) || !parse_int(b, &v2))
+            return 0;
+        set_field(c, field, v, v2 + 1, 0);
+        return 1;
+    }
+
+    /* Symbolic operators */
+    char *sym = strpbrk(text, "<>=!");
+    if (sym) {
+        size_t n = strspn(sym, "<>=!");
+        if (n >= sizeof(op))
+            return 0;
+        memcpy(op, sym, n);
+        *sym = '\0';
+        rhs = sym + n;
+    } else {
+        for (size_t i = 0; i < sizeof(english) / sizeof(*english); ++i) {
+            char *hit = strstr(text, english[i].word);
+            if (hit) {
+                strcpy(op, english[i].op);
+                *hit = '\0';
+                rhs = hit + strlen(english[i].word);
+                break;
+            }
+        }
+    }
+
+    if (!rhs)
+        return 0;
+
+    trim(&lhs);
+    trim(&rhs);
+    if (!parse_field(lhs, &field) || !parse_int(rhs, &v))
+        return 0;
+
+    if (!strcmp(op, "=") || !strcmp(op, "=="))
+        set_field(c, field, v, v + 1, 0);
+    else if (!strcmp(op, "!=") || !strcmp(op, "<>"))
+        set_field(c, field, v, v + 1, 1);
+    else if (!strcmp(op, "<"))
+        set_field(c, field, INT64_MIN, v, 0);
+    else if (!strcmp(op, "<="))
+        set_field(c, field, INT64_MIN, v + 1, 0);
+    else if (!strcmp(op, ">"))
+        set_field(c, field, v + 1, INT64_MAX, 0);
+    else if (!strcmp(op, ">="))
+        set_field(c, field, v, INT64_MAX, 0);
+    else
+        return 0;
+
+    return 1;
+}
+
+static int compile_clause(
+    fossil_time_query_clause_t *c,
+    char *text,
+    const fossil_time_date_t *now
+) {
+    if (compile_keyword(c, text) || compile_calendar(c, text))
+        return 1;
+
+    if (now && compile_relative(c, text, now))
+        return 1;
+
+    return compile_comparison(c, text);
+}
+
+/* ======================================================
+ * Internal: evaluation
+ * ====================================================== */
+
+static int64_t field_value(
+    const fossil_time_date_t *dt,
+    fossil_time_query_field_t field
+) {
+    switch (field) {
+        case FOSSIL_TIME_QUERY_FIELD_YEAR:        return dt->year;
+        case FOSSIL_TIME_QUERY_FIELD_MONTH:       return dt->month;
+        case FOSSIL_TIME_QUERY_FIELD_DAY:         return dt->day;
+        case FOSSIL_TIME_QUERY_FIELD_HOUR:        return dt->hour;
+        case FOSSIL_TIME_QUERY_FIELD_MINUTE:      return dt->minute;
+        case FOSSIL_TIME_QUERY_FIELD_SECOND:      return dt->second;
+        case FOSSIL_TIME_QUERY_FIELD_WEEKDAY:     return dt->weekday;
+        case FOSSIL_TIME_QUERY_FIELD_YEARDAY:     return dt->yearday;
+        case FOSSIL_TIME_QUERY_FIELD_MILLISECOND: return dt->millisecond;
+        case FOSSIL_TIME_QUERY_FIELD_MICROSECOND: return dt->microsecond;
+        case FOSSIL_TIME_QUERY_FIELD_NANOSECOND:  return dt->nanosecond;
+        case FOSSIL_TIME_QUERY_FIELD_TZ_OFFSET:   return dt->tz_offset_min;
+        case FOSSIL_TIME_QUERY_FIELD_QUARTER:     return (dt->month - 1) / 3 + 1;
+    }
+    return 0;
+}
+
+static int eval_fields(
+    const fossil_time_query_clause_t *c,
+    const fossil_time_date_t *dt
+) {
+    switch (c->kind) {
+        case FOSSIL_TIME_QUERY_FIELD: {
+            int64_t x = field_value(dt, c->field);
+            return (x >= c->lo && x < c->hi) != (c->negate != 0);
+        }
+        case FOSSIL_TIME_QUERY_LEAP_YEAR:
+            return is_leap(dt->year) != (c->negate != 0);
+        case FOSSIL_TIME_QUERY_LAST_OF_MONTH:
+            return (dt->day == days_in_month(dt->year, dt->month)) != (c->negate != 0);
+        case FOSSIL_TIME_QUERY_CALENDAR:
+            return calendar_test(c, dt) != (c->negate != 0);
+        default:
+            return 0;
+    }
+}
+
+static void breakdown_utc(int64_t epoch_ns, fossil_time_date_t *dt) {
+    int64_t sec = floor_div(epoch_ns, FOSSIL_QUERY_NS_PER_SEC);
+    int64_t sub = epoch_ns - sec * FOSSIL_QUERY_NS_PER_SEC;
+    int64_t days = floor_div(sec, 86400);
+    int64_t sod = sec - days * 86400;
+    int64_t y;
+    int m, d;
+
+    civil_from_days(days, &y, &m, &d);
+
+    memset(dt, 0, sizeof(*dt));
+    dt->year        = (int32_t)y;
+    dt->month       = (int8_t)m;
+    dt->day         = (int8_t)d;
+    dt->hour        = (int8_t)(sod / 3600);
+    dt->minute      = (int8_t)((sod / 60) % 60);
+    dt->second      = (int8_t)(sod % 60);
+    dt->millisecond = (int16_t)(sub / 1000000);
+    dt->microsecond = (int16_t)((sub / 1000) % 1000);
+    dt->nanosecond  = (int16_t)(sub % 1000);
+    dt->weekday     = (int8_t)(days - floor_div(days + 4, 7) * 7 + 4);
+    dt->yearday     = (int16_t)(days - days_from_civil(y, 1, 1) + 1);
+}
+
+/* Instrumented evaluation: dt may be NULL, in which case epoch_ns is used */
+static int match_profiled(
+    const fossil_time_query_t *query,
+    fossil_time_query_stats_t *stats,
+    const fossil_time_date_t *dt,
+    int64_t epoch_ns
+) {
+    fossil_time_timer_t timer;
+    fossil_time_date_t fields;
+    int have_ns = (dt == NULL);
+    int result = 1;
+    uint64_t total = 0;
+
+    fossil_time_timer_start(&timer);
+
+    for (size_t i = 0; i < query->clause_count; ++i) {
+        const fossil_time_query_clause_t *c = &query->clauses[i];
+        fossil_time_query_clause_stats_t *cs = &stats->clauses[i];
+        int pass;
+
+        if (c->kind == FOSSIL_TIME_QUERY_RANGE) {
+            if (!have_ns) {
+                epoch_ns = fossil_time_date_to_unix_nanoseconds(dt);
+                have_ns = 1;
+            }
+            pass = epoch_ns >= c->lo && epoch_ns < c->hi;
+        } else {
+            if (!dt) {
+                breakdown_utc(epoch_ns, &fields);
+                dt = &fields;
+            }
+            pass = eval_fields(c, dt);
+        }
+
+        uint64_t ns = fossil_time_timer_lap_ns(&timer);
+        cs->evaluations++;
+        cs->passed += pass != 0;
+        cs->elapsed_ns += ns;
+        total += ns;
+
+        if (!pass) {
+            result = 0;
+            break;
+        }
+    }
+
+    stats->records++;
+    stats->matched += (uint64_t)result;
+    stats->elapsed_ns += total;
+    return result;
+}
+
+static void stats_add(fossil_time_query_stats_t *into, const fossil_time_query_stats_t *from) {
+    into->records += from->records;
+    into->matched += from->matched;
+    into->elapsed_ns += from->elapsed_ns;
+    for (size_t i = 0; i < FOSSIL_TIME_QUERY_MAX_CLAUSES; ++i) {
+        into->clauses[i].evaluations += from->clauses[i].evaluations;
+        into->clauses[i].passed += from->clauses[i].passed;
+        into->clauses[i].elapsed_ns += from->clauses[i].elapsed_ns;
+    }
+}
+
+/* ======================================================
+ * C API — Compilation
+ * ====================================================== */
+
+int fossil_time_query_compile(
+    fossil_time_query_t *query,
+    const char *text,
+    const fossil_time_date_t *now
+) {
+    char buf[FOSSIL_QUERY_MAX_TEXT];
+    size_t len;
+
+    if (!query || !text)
+        return -1;
+
+    memset(query, 0, sizeof(*query));
+
+    len = strlen(text);
+    if (len == 0 || len >= sizeof(buf))
+        return -1;
+
+    for (size_t i = 0; i <= len; ++i)
+        buf[i] = (char)tolower((unsigned char)text[i]);
+
+    char *cursor = buf;
+    for (;;) {
+        char *next = strstr(cursor, " and ");
+        if (next)
+            *next = '\0';
+
+        char *clause = cursor;
+        trim(&clause);
+
+        if (!*clause || query->clause_count >= FOSSIL_TIME_QUERY_MAX_CLAUSES ||
+            !compile_clause(&query->clauses[query->clause_count], clause, now)) {
+            memset(query, 0, sizeof(*query));
+            return -1;
+        }
+        query->clause_count++;
+
+        if (!next)
+            break;
+        cursor = next + 5;
+    }
+
+    return 0;
+}
+
+/* ======================================================
+ * C API — Evaluation
+ * ====================================================== */
+
+int fossil_time_query_match(
+    const fossil_time_query_t *query,
+    const fossil_time_date_t *dt
+) {
+    int have_ns = 0;
+    int64_t ns = 0;
+
+    if (!query || !dt)
+        return 0;
+
+    if (query->stats)
+        return match_profiled(query, query->stats, dt, 0);
+
+    for (size_t i = 0; i < query->clause_count; ++i) {
+        const fossil_time_query_clause_t *c = &query->clauses[i];
+
+        if (c->kind == FOSSIL_TIME_QUERY_RANGE) {
+            if (!have_ns) {
+                ns = fossil_time_date_to_unix_nanoseconds(dt);
+                have_ns = 1;
+            }
+            if (!(ns >= c->lo && ns < c->hi))
+                return 0;
+        } else if (!eval_fields(c, dt)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int fossil_time_query_match_ns(
+    const fossil_time_query_t *query,
+    int64_t epoch_ns
+) {
+    int have_fields = 0;
+    fossil_time_date_t dt;
+
+    if (!query)
+        return 0;
+
+    if (query->stats)
+        return match_profiled(query, query->stats, NULL, epoch_ns);
+
+    for (size_t i = 0; i < query->clause_count; ++i) {
+        const fossil_time_query_clause_t *c = &query->clauses[i];
+
+        if (c->kind == FOSSIL_TIME_QUERY_RANGE) {
+            if (!(epoch_ns >= c->lo && epoch_ns < c->hi))
+                return 0;
+        } else {
+            if (!have_fields) {
+                breakdown_utc(epoch_ns, &dt);
+                have_fields = 1;
+            }
+            if (!eval_fields(c, &dt))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+int fossil_time_query_bounds(
+    const fossil_time_query_t *query,
+    int64_t *out_start,
+    int64_t *out_end
+) {
+    int64_t lo = INT64_MIN;
+    int64_t hi = INT64_MAX;
+
+    if (!query || !out_start || !out_end)
+        return 0;
+
+    for (size_t i = 0; i < query->clause_count; ++i) {
+        const fossil_time_query_clause_t *c = &query->clauses[i];
+        if (c->kind != FOSSIL_TIME_QUERY_RANGE || c->negate)
+            continue;
+        if (c->lo > lo) lo = c->lo;
+        if (c->hi < hi) hi = c->hi;
+    }
+
+    *out_start = lo;
+    *out_end = hi;
+    return lo < hi;
+}
+
+/* ======================================================
+ * Internal: parallel scans
+ * ====================================================== */
+
+typedef struct fossil_query_task_t {
+    const fossil_time_query_t *query;
+    const int64_t *epoch_ns;          /* one of epoch_ns / dates is set */
+    const fossil_time_date_t *dates;
+    size_t begin;                     /* first row, multiple of 64 */
+    size_t end;                       /* one past the last row */
+    uint64_t *bitmap;                 /* scan output, or NULL */
+    size_t *index;                    /* select output, or NULL */
+    fossil_time_query_stats_t *stats; /* worker-private counters, or NULL */
+    size_t matched;
+} fossil_query_task_t;
+
+static void query_task_run(fossil_query_task_t *t) {
+    size_t matched = 0;
+
+    for (size_t row = t->begin; row < t->end; row += 64) {
+        size_t stop = (t->end - row > 64) ? row + 64 : t->end;
+        uint64_t word = 0;
+
+        for (size_t i = row; i < stop; ++i) {
+            int hit;
+
+            if (t->stats)
+                hit = match_profiled(t->query, t->stats,
+                                     t->dates ? &t->dates[i] : NULL,
+                                     t->epoch_ns ? t->epoch_ns[i] : 0);
+            else if (t->dates)
+                hit = fossil_time_query_match(t->query, &t->dates[i]);
+            else
+                hit = fossil_time_query_match_ns(t->query, t->epoch_ns[i]);
+
+            if (hit) {
+                word |= 1ULL << (i - row);
+                if (t->index)
+                    t->index[t->begin + matched] = i;
+                matched++;
+            }
+        }
+
+        if (t->bitmap)
+            t->bitmap[row / 64] = word;
+    }
+
+    t->matched = matched;
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI query_task_thread(LPVOID arg) {
+    query_task_run((fossil_query_task_t *)arg);
+    return 0;
+}
+#else
+static void *query_task_thread(void *arg) {
+    query_task_run((fossil_query_task_t *)arg);
+    return NULL;
+}
+#endif
+
+static size_t online_workers(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (size_t)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#else
+    return 1;
+#endif
+}
+
+static int64_t query_run_parallel(
+    const fossil_query_task_t *proto,
+    size_t count,
+    size_t workers
+) {
+    fossil_query_task_t tasks[FOSSIL_QUERY_MAX_WORKERS];
+#if defined(_WIN32)
+    HANDLE threads[FOSSIL_QUERY_MAX_WORKERS];
+#else
+    pthread_t threads[FOSSIL_QUERY_MAX_WORKERS];
+#endif
+    int started[FOSSIL_QUERY_MAX_WORKERS];
+    size_t by_rows = count / FOSSIL_QUERY_MIN_ROWS_PER_WORKER + 1;
+
+    if (workers == 0)
+        workers = online_workers();
+    if (workers > by_rows)
+        workers = by_rows;
+    if (workers > FOSSIL_QUERY_MAX_WORKERS)
+        workers = FOSSIL_QUERY_MAX_WORKERS;
+
+    /* Whole 64-row words per worker keep outputs disjoint */
+    size_t chunk = (count + workers - 1) / workers;
+    chunk = (chunk + 63) & ~(size_t)63;
+    if (chunk == 0)
+        chunk = 64;
+
+    size_t n = 0;
+    for (size_t begin = 0; begin < count && n < workers; begin += chunk, ++n) {
+        tasks[n] = *proto;
+        tasks[n].begin = begin;
+        tasks[n].end = (count - begin > chunk) ? begin + chunk : count;
+        tasks[n].matched = 0;
+        started[n] = 0;
+    }
+
+    /* Profiled scans count per worker and merge once the workers finish */
+    fossil_time_query_stats_t *local = NULL;
+    if (proto->query->stats && n > 0) {
+        local = (fossil_time_query_stats_t *)calloc(n, sizeof(*local));
+        if (!local)
+            return -1;
+        for (size_t i = 0; i < n; ++i)
+            tasks[i].stats = &local[i];
+    }
+
+    /* The calling thread takes the first chunk itself */
+    for (size_t i = 1; i < n; ++i) {
+#if defined(_WIN32)
+        threads[i] = CreateThread(NULL, 0, query_task_thread, &tasks[i], 0, NULL);
+        started[i] = threads[i] != NULL;
+#else
+        started[i] = pthread_create(&threads[i], NULL, query_task_thread, &tasks[i]) == 0;
+#endif
+    }
+
+    if (n > 0)
+        query_task_run(&tasks[0]);
+
+    for (size_t i = 1; i < n; ++i) {
+        if (started[i]) {
+#if defined(_WIN32)
+            WaitForSingleObject(threads[i], INFINITE);
+            CloseHandle(threads[i]);
+#else
+            pthread_join(threads[i], NULL);
+#endif
+        } else {
+            query_task_run(&tasks[i]);
+        }
+    }
+
+    /* Merge: chunks are in row order, so compacting them keeps positions sorted */
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (proto->index && total != tasks[i].begin && tasks[i].matched > 0) {
+            memmove(proto->index + total,
+                    proto->index + tasks[i].begin,
+                    tasks[i].matched * sizeof(size_t));
+        }
+        total += tasks[i].matched;
+    }
+
+    if (local) {
+        for (size_t i = 0; i < n; ++i)
+            stats_add(proto->query->stats, &local[i]);
+        free(local);
+    }
+
+    return (int64_t)total;
+}
+
+/* ======================================================
+ * C API — Bulk evaluation
+ * ====================================================== */
+
+int64_t fossil_time_query_scan_ns(
+    const fossil_time_query_t *query,
+    const int64_t *epoch_ns,
+    size_t count,
+    size_t workers,
+    uint64_t *out_bitmap
+) {
+    fossil_query_task_t proto;
+
+    if (!query || (count > 0 && (!epoch_ns || !out_bitmap)))
+        return -1;
+
+    memset(&proto, 0, sizeof(proto));
+    proto.query = query;
+    proto.epoch_ns = epoch_ns;
+    proto.bitmap = out_bitmap;
+    return query_run_parallel(&proto, count, workers);
+}
+
+int64_t fossil_time_query_scan_dates(
+    const fossil_time_query_t *query,
+    const fossil_time_date_t *dates,
+    size_t count,
+    size_t workers,
+    uint64_t *out_bitmap
+) {
+    fossil_query_task_t proto;
+
+    if (!query || (count > 0 && (!dates || !out_bitmap)))
+        return -1;
+
+    memset(&proto, 0, sizeof(proto));
+    proto.query = query;
+    proto.dates = dates;
+    proto.bitmap = out_bitmap;
+    return query_run_parallel(&proto, count, workers);
+}
+
+int64_t fossil_time_query_select_ns(
+    const fossil_time_query_t *query,
+    const int64_t *epoch_ns,
+    size_t count,
+    size_t workers,
+    size_t *out_index
+) {
+    fossil_query_task_t proto;
+
+    if (!query || (count > 0 && (!epoch_ns || !out_index)))
+        return -1;
+
+    memset(&proto, 0, sizeof(proto));
+    proto.query = query;
+    proto.epoch_ns = epoch_ns;
+    proto.index = out_index;
+    return query_run_parallel(&proto, count, workers);
+}
+
+int64_t fossil_time_query_select_dates(
+    const fossil_time_query_t *query,
+    const fossil_time_date_t *dates,
+    size_t count,
+    size_t workers,
+    size_t *out_index
+) {
+    fossil_query_task_t proto;
+
+    if (!query || (count > 0 && (!dates || !out_index)))
+        return -1;
+
+    memset(&proto, 0, sizeof(proto));
+    proto.query = query;
+    proto.dates = dates;
+    proto.index = out_index;
+    return query_run_parallel(&proto, count, workers);
+}
+
+/* ======================================================
+ * Internal: explain
+ * ====================================================== */
+
+typedef struct fossil_query_writer_t {
+    char *buffer;
+    size_t size;
+    size_t length;                    /* full length, even when truncated */
+} fossil_query_writer_t;
+
+static void emit(fossil_query_writer_t *w, const char *fmt, ...) {
+    char *dst = NULL;
+    size_t room = 0;
+    va_list args;
+
+    if (w->buffer && w->length < w->size) {
+        dst = w->buffer + w->length;
+        room = w->size - w->length;
+    }
+
+    va_start(args, fmt);
+    int n = vsnprintf(dst, room, fmt, args);
+    va_end(args);
+
+    if (n > 0)
+        w->length += (size_t)n;
+}
+
+static void emit_bound(fossil_query_writer_t *w, int64_t v) {
+    if (v == INT64_MIN)
+        emit(w, "-inf");
+    else if (v == INT64_MAX)
+        emit(w, "+inf");
+    else
+        emit(w, "%" PRId64, v);
+}
+
+static const char *field_name(fossil_time_query_field_t field) {
+    static const char *names[] = {
+        "year", "month", "day", "hour", "minute", "second", "weekday",
+        "yearday", "millisecond", "microsecond", "nanosecond", "tz_offset",
+        "quarter"
+    };
+    size_t i = (size_t)field;
+    return i < sizeof(names) / sizeof(*names) ? names[i] : "?";
+}
+
+static void emit_clause(fossil_query_writer_t *w, const fossil_time_query_clause_t *c) {
+    static const char *sets[] = {
+        "weekend", "holiday", "business day",
+        "first business day of month", "last business day of month"
+    };
+    static const char *regions[] = { "registry", "us", "uk", "ca" };
+    const char *neg = c->negate ? "not " : "";
+
+    switch (c->kind) {
+        case FOSSIL_TIME_QUERY_RANGE:
+            emit(w, "%srange [", neg);
+            emit_bound(w, c->lo);
+            emit(w, ", ");
+            emit_bound(w, c->hi);
+            emit(w, ")");
+            break;
+        case FOSSIL_TIME_QUERY_FIELD:
+            emit(w, "field %s %sin [", field_name(c->field), neg);
+            emit_bound(w, c->lo);
+            emit(w, ", ");
+            emit_bound(w, c->hi);
+            emit(w, ")");
+            break;
+        case FOSSIL_TIME_QUERY_LEAP_YEAR:
+            emit(w, "%sleap year", neg);
+            break;
+        case FOSSIL_TIME_QUERY_LAST_OF_MONTH:
+            emit(w, "%slast of month", neg);
+            break;
+        case FOSSIL_TIME_QUERY_CALENDAR:
+            emit(w, "calendar %s%s (%s)", neg,
+                 (c->lo >= 0 && c->lo < 5) ? sets[c->lo] : "?",
+                 (c->hi >= 0 && c->hi < 4) ? regions[c->hi] : "?");
+            break;
+        default:
+            emit(w, "?");
+            break;
+    }
+}
+
+static double percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * (double)part / (double)whole : 0.0;
+}
+
+/* ======================================================
+ * C API — Profiling
+ * ====================================================== */
+
+int fossil_time_query_profile(
+    fossil_time_query_t *query,
+    fossil_time_query_stats_t *stats
+) {
+    if (!query)
+        return -1;
+
+    if (stats)
+        memset(stats, 0, sizeof(*stats));
+    query->stats = stats;
+    return 0;
+}
+
+int fossil_time_query_explain(
+    const fossil_time_query_t *query,
+    char *buffer,
+    size_t buffer_size
+) {
+    fossil_query_writer_t w;
+    const fossil_time_query_stats_t *st;
+
+    if (!query || (!buffer && buffer_size > 0))
+        return -1;
+
+    w.buffer = buffer;
+    w.size = buffer_size;
+    w.length = 0;
+    if (buffer && buffer_size > 0)
+        buffer[0] = '\0';
+
+    st = query->stats;
+
+    for (size_t i = 0; i < query->clause_count; ++i) {
+        emit(&w, "clause %zu: ", i);
+        emit_clause(&w, &query->clauses[i]);
+
+        if (st) {
+            const fossil_time_query_clause_stats_t *cs = &st->clauses[i];
+            emit(&w, " evals=%" PRIu64 " pass=%" PRIu64 " (%.2f%%) %" PRIu64 " ns (%.1f ns/eval)",
+                 cs->evaluations, cs->passed, percent(cs->passed, cs->evaluations),
+                 cs->elapsed_ns,
+                 cs->evaluations ? (double)cs->elapsed_ns / (double)cs->evaluations : 0.0);
+        }
+        emit(&w, "\n");
+    }
+
+    if (query->clause_count == 0)
+        emit(&w, "clause -: match all\n");
+
+    if (st) {
+        emit(&w, "total: records=%" PRIu64 " matched=%" PRIu64 " (%.2f%%) %" PRIu64 " ns\n",
+             st->records, st->matched, percent(st->matched, st->records), st->elapsed_ns);
+    } else {
+        emit(&w, "total: profiling disabled\n");
+    }
+
+    if (w.length > (size_t)INT32_MAX)
+        return -1;
+    return (int)w.length;
+}
@@ -24,7 +24,11 @@
  */
 #include "fossil/time/span.h"
 #include <string.h>
-#include <stdio.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define FOSSIL_SPAN_SSE2 1
+#endif
 
 /* ======================================================
  * Internal helpers
@@ -34,10 +38,285 @@ static void fossil_time_span_zero_fields(fossil_time_span_t *span) {
     memset(span, 0, sizeof(*span));
 }
 
+#define FOSSIL_TIME_SPAN_ALL_UNITS ((FOSSIL_TIME_SPAN_PRECISION_YOCTO << 1) - 1)
+
 static int unit_equals(const char *a, const char *b) {
     return a && b && strcmp(a, b) == 0;
 }
 
+/* ======================================================
+ * Internal: 128-bit ticks
+ * ====================================================== */
+
+/*
+ * Ticks are plain two's complement, so add, subtract and the low 128 bits
+ * of a product need no sign handling; only division works on magnitudes.
+ */
+
+static fossil_time_span_ticks_t ticks_from_i64(int64_t value) {
+    fossil_time_span_ticks_t t;
+    t.hi = value < 0 ? -1 : 0;
+    t.lo = (uint64_t)value;
+    return t;
+}
+
+static fossil_time_span_ticks_t ticks_neg(fossil_time_span_ticks_t t) {
+    fossil_time_span_ticks_t r;
+    r.lo = ~t.lo + 1;
+    r.hi = (int64_t)(~(uint64_t)t.hi + (r.lo == 0));
+    return r;
+}
+
+/* 64 x 64 -> 128 unsigned product; returns the low word */
+static uint64_t umul64(uint64_t a, uint64_t b, uint64_t *hi) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 p = (unsigned __int128)a * b;
+    *hi = (uint64_t)(p >> 64);
+    return (uint64_t)p;
+#else
+    uint64_t a0 = a & 0xFFFFFFFFULL, a1 = a >> 32;
+    uint64_t b0 = b & 0xFFFFFFFFULL, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFFULL) + (p10 & 0xFFFFFFFFULL);
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (p00 & 0xFFFFFFFFULL);
+#endif
+}
+
+/* t * f + add, wrapping */
+static fossil_time_span_ticks_t ticks_mul_add(
+    fossil_time_span_ticks_t t,
+    uint64_t f,
+    int64_t add
+) {
+    fossil_time_span_ticks_t r, a = ticks_from_i64(add);
+    uint64_t carry;
+    r.lo = umul64(t.lo, f, &carry);
+    r.hi = (int64_t)((uint64_t)t.hi * f + carry);
+    return fossil_time_span_ticks_add(r, a);
+}
+
+/* Divide a magnitude in place by d < 2^32 and return the remainder.
+ * Schoolbook on 32-bit limbs, so constant divisors become multiplies. */
+static inline uint32_t ticks_udiv_u32(fossil_time_span_ticks_t *t, uint32_t d) {
+    uint64_t hi = (uint64_t)t->hi, lo = t->lo;
+    uint64_t limb[4] = { hi >> 32, hi & 0xFFFFFFFFULL, lo >> 32, lo & 0xFFFFFFFFULL };
+    uint64_t r = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint64_t cur = (r << 32) | limb[i];
+        limb[i] = cur / d;
+        r = cur % d;
+    }
+    t->hi = (int64_t)((limb[0] << 32) | limb[1]);
+    t->lo = (limb[2] << 32) | limb[3];
+    return (uint32_t)r;
+}
+
+/* Non-negative t * f; returns nonzero if the product leaves int128 */
+static int ticks_umul_ov(fossil_time_span_ticks_t t, uint64_t f, fossil_time_span_ticks_t *out) {
+    uint64_t carry, top;
+    uint64_t lo = umul64(t.lo, f, &carry);
+    uint64_t mid = umul64((uint64_t)t.hi, f, &top);
+    uint64_t hi = mid + carry;
+
+    top += hi < mid;
+    out->lo = lo;
+    out->hi = (int64_t)hi;
+    return top != 0 || (hi >> 63) != 0;
+}
+
+static const uint64_t fossil_span_pow10[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+/* Non-negative t * 10^e, checked */
+static int ticks_scale10_ov(fossil_time_span_ticks_t t, int e, fossil_time_span_ticks_t *out) {
+    *out = t;
+    while (e > 0) {
+        int step = e > 19 ? 19 : e;
+        if (ticks_umul_ov(*out, fossil_span_pow10[step], out))
+            return 1;
+        e -= step;
+    }
+    return 0;
+}
+
+/* Unsigned n / d and n % d for magnitudes; d must be non-zero */
+static void ticks_udivmod(
+    fossil_time_span_ticks_t n,
+    fossil_time_span_ticks_t d,
+    fossil_time_span_ticks_t *q,
+    fossil_time_span_ticks_t *r
+) {
+    if (d.hi == 0 && d.lo <= 0xFFFFFFFFULL) {
+        r->hi = 0;
+        r->lo = ticks_udiv_u32(&n, (uint32_t)d.lo);
+        *q = n;
+        return;
+    }
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 un = ((unsigned __int128)(uint64_t)n.hi << 64) | n.lo;
+    __extension__ unsigned __int128 ud = ((unsigned __int128)(uint64_t)d.hi << 64) | d.lo;
+    __extension__ unsigned __int128 uq = un / ud, ur = un % ud;
+    q->hi = (int64_t)(uint64_t)(uq >> 64); q->lo = (uint64_t)uq;
+    r->hi = (int64_t)(uint64_t)(ur >> 64); r->lo = (uint64_t)ur;
+#else
+    uint64_t qh = 0, ql = 0, rh = 0, rl = 0;
+    uint64_t nh = (uint64_t)n.hi, dh = (uint64_t)d.hi;
+
+    for (int i = 127; i >= 0; i--) {
+        uint64_t bit = i >= 64 ? (nh >> (i - 64)) & 1 : (n.lo >> i) & 1;
+        rh = (rh << 1) | (rl >> 63);
+        rl = (rl << 1) | bit;
+        if (rh > dh || (rh == dh && rl >= d.lo)) {
+            rh -= dh + (rl < d.lo);
+            rl -= d.lo;
+            if (i >= 64) qh |= 1ULL << (i - 64);
+            else         ql |= 1ULL << i;
+        }
+    }
+    q->hi = (int64_t)qh; q->lo = ql;
+    r->hi = (int64_t)rh; r->lo = rl;
+#endif
+}
+
+/* Signed n / d rounded toward zero, remainder with the sign of n; d != 0 */
+static void ticks_sdivmod(
+    fossil_time_span_ticks_t n,
+    fossil_time_span_ticks_t d,
+    fossil_time_span_ticks_t *q,
+    fossil_time_span_ticks_t *r
+) {
+    int nneg = n.hi < 0, dneg = d.hi < 0;
+
+    ticks_udivmod(nneg ? ticks_neg(n) : n, dneg ? ticks_neg(d) : d, q, r);
+    if (nneg != dneg)
+        *q = ticks_neg(*q);
+    if (nneg)
+        *r = ticks_neg(*r);
+}
+
+/* a * b for signed ticks; nonzero if the product leaves int128 */
+static int ticks_mul_ov(fossil_time_span_ticks_t a, fossil_time_span_ticks_t b, fossil_time_span_ticks_t *out) {
+    int neg = (a.hi < 0) != (b.hi < 0);
+    fossil_time_span_ticks_t ma = a.hi < 0 ? ticks_neg(a) : a;
+    fossil_time_span_ticks_t mb = b.hi < 0 ? ticks_neg(b) : b;
+    int ov;
+
+    if (ma.hi != 0 && mb.hi != 0)
+        return 1;
+    ov = mb.hi == 0 ? ticks_umul_ov(ma, mb.lo, out) : ticks_umul_ov(mb, ma.lo, out);
+    if (neg)
+        *out = ticks_neg(*out);
+    return ov;
+}
+
+/* ======================================================
+ * Internal: units
+ * ====================================================== */
+
+/* Unit ids, coarsest first; the index is also the field's precision bit */
+static const char *const fossil_span_unit_ids[12] = {
+    "days", "hours", "minutes", "seconds", "ms", "us",
+    "ns", "ps", "fs", "as", "zs", "ys"
+};
+
+#define FOSSIL_SPAN_UNIT_YS 11
+
+/*
+ * Every unit is a whole multiple of each finer one, so the conversion
+ * matrix reduces to one integer per pair: [i][j] is how many of the finer
+ * unit make one of the coarser, whichever of i and j that is. Column
+ * FOSSIL_SPAN_UNIT_YS gives each unit in yoctoseconds.
+ */
+static const fossil_time_span_ticks_t fossil_span_unit_ratio[12][12] = {
+    { /* days */
+        { 0, 1ULL }, { 0, 24ULL }, { 0, 1440ULL },
+        { 0, 86400ULL }, { 0, 86400000ULL }, { 0, 86400000000ULL },
+        { 0, 86400000000000ULL }, { 0, 86400000000000000ULL }, { 0x4LL, 0xAF0A763BB1C00000ULL },
+        { 0x124BLL, 0xC0DDD92E56000000ULL }, { 0x4777E9LL, 0x62985CFFF0000000ULL }, { 0x1172C67A9LL, 0x232B47C180000000ULL }
+    },
+    { /* hours */
+        { 0, 24ULL }, { 0, 1ULL }, { 0, 60ULL },
+        { 0, 3600ULL }, { 0, 3600000ULL }, { 0, 3600000000ULL },
+        { 0, 3600000000000ULL }, { 0, 3600000000000000ULL }, { 0, 3600000000000000000ULL },
+        { 0xC3LL, 0x28093E61EE400000ULL }, { 0x2FA54LL, 0x641BAE8AAA000000ULL }, { 0xBA1D9A7LL, 0xC21CDA810000000ULL }
+    },
+    { /* minutes */
+        { 0, 1440ULL }, { 0, 60ULL }, { 0, 1ULL },
+        { 0, 60ULL }, { 0, 60000ULL }, { 0, 60000000ULL },
+        { 0, 60000000000ULL }, { 0, 60000000000000ULL }, { 0, 60000000000000000ULL },
+        { 0x3LL, 0x40AAD21B3B700000ULL }, { 0xCB4LL, 0x9B44BA602D800000ULL }, { 0x31A17ELL, 0x847807B1BC000000ULL }
+    },
+    { /* seconds */
+        { 0, 86400ULL }, { 0, 3600ULL }, { 0, 60ULL },
+        { 0, 1ULL }, { 0, 1000ULL }, { 0, 1000000ULL },
+        { 0, 1000000000ULL }, { 0, 1000000000000ULL }, { 0, 1000000000000000ULL },
+        { 0, 1000000000000000000ULL }, { 0x36LL, 0x35C9ADC5DEA00000ULL }, { 0xD3C2LL, 0x1BCECCEDA1000000ULL }
+    },
+    { /* ms */
+        { 0, 86400000ULL }, { 0, 3600000ULL }, { 0, 60000ULL },
+        { 0, 1000ULL }, { 0, 1ULL }, { 0, 1000ULL },
+        { 0, 1000000ULL }, { 0, 1000000000ULL }, { 0, 1000000000000ULL },
+        { 0, 1000000000000000ULL }, { 0, 1000000000000000000ULL }, { 0x36LL, 0x35C9ADC5DEA00000ULL }
+    },
+    { /* us */
+        { 0, 86400000000ULL }, { 0, 3600000000ULL }, { 0, 60000000ULL },
+        { 0, 1000000ULL }, { 0, 1000ULL }, { 0, 1ULL },
+        { 0, 1000ULL }, { 0, 1000000ULL }, { 0, 1000000000ULL },
+        { 0, 1000000000000ULL }, { 0, 1000000000000000ULL }, { 0, 1000000000000000000ULL }
+    },
+    { /* ns */
+        { 0, 86400000000000ULL }, { 0, 3600000000000ULL }, { 0, 60000000000ULL },
+        { 0, 1000000000ULL }, { 0, 1000000ULL }, { 0, 1000ULL },
+        { 0, 1ULL }, { 0, 1000ULL }, { 0, 1000000ULL },
+        { 0, 1000000000ULL }, { 0, 1000000000000ULL }, { 0, 1000000000000000ULL }
+    },
+    { /* ps */
+        { 0, 86400000000000000ULL }, { 0, 3600000000000000ULL }, { 0, 60000000000000ULL },
+        { 0, 1000000000000ULL }, { 0, 1000000000ULL }, { 0, 1000000ULL },
+        { 0, 1000ULL }, { 0, 1ULL }, { 0, 1000ULL },
+        { 0, 1000000ULL }, { 0, 1000000000ULL }, { 0, 1000000000000ULL }
+    },
+    { /* fs */
+        { 0x4LL, 0xAF0A763BB1C00000ULL }, { 0, 3600000000000000000ULL }, { 0, 60000000000000000ULL },
+        { 0, 1000000000000000ULL }, { 0, 1000000000000ULL }, { 0, 1000000000ULL },
+        { 0, 1000000ULL }, { 0, 1000ULL }, { 0, 1ULL },
+        { 0, 1000ULL }, { 0, 1000000ULL }, { 0, 1000000000ULL }
+    },
+    { /* as */
+        { 0x124BLL, 0xC0DDD92E56000000ULL }, { 0xC3LL, 0x28093E61EE400000ULL }, { 0x3LL, 0x40AAD21B3B700000ULL },
+        { 0, 1000000000000000000ULL }, { 0, 1000000000000000ULL }, { 0, 1000000000000ULL },
+        { 0, 1000000000ULL }, { 0, 1000000ULL }, { 0, 1000ULL },
+        { 0, 1ULL }, { 0, 1000ULL }, { 0, 1000000ULL }
+    },
+    { /* zs */
+        { 0x4777E9LL, 0x62985CFFF0000000ULL }, { 0x2FA54LL, 0x641BAE8AAA000000ULL }, { 0xCB4LL, 0x9B44BA602D800000ULL },
+        { 0x36LL, 0x35C9ADC5DEA00000ULL }, { 0, 1000000000000000000ULL }, { 0, 1000000000000000ULL },
+        { 0, 1000000000000ULL }, { 0, 1000000000ULL }, { 0, 1000000ULL },
+        { 0, 1000ULL }, { 0, 1ULL }, { 0, 1000ULL }
+    },
+    { /* ys */
+        { 0x1172C67A9LL, 0x232B47C180000000ULL }, { 0xBA1D9A7LL, 0xC21CDA810000000ULL }, { 0x31A17ELL, 0x847807B1BC000000ULL },
+        { 0xD3C2LL, 0x1BCECCEDA1000000ULL }, { 0x36LL, 0x35C9ADC5DEA00000ULL }, { 0, 1000000000000000000ULL },
+        { 0, 1000000000000000ULL }, { 0, 1000000000000ULL }, { 0, 1000000000ULL },
+        { 0, 1000000ULL }, { 0, 1000ULL }, { 0, 1ULL }
+    }
+};
+
+static int fossil_span_unit_index(const char *unit_id) {
+    for (int k = 0; k < 12; k++) {
+        if (unit_equals(unit_id, fossil_span_unit_ids[k]))
+            return k;
+    }
+    return -1;
+}
+
 /* ======================================================
  * Core
  * ====================================================== */
@@ -58,42 +337,54 @@ int fossil_time_span_validate(const fossil_time_span_t *span) {
     return 1;
 }
 
+/* Precision bits of the fields that are non-zero */
+static uint64_t fossil_time_span_used_mask(const fossil_time_span_t *span) {
+    uint64_t m = 0;
+    if (span->days)         m |= FOSSIL_TIME_SPAN_PRECISION_DAYS;
+    if (span->hours)        m |= FOSSIL_TIME_SPAN_PRECISION_HOURS;
+    if (span->minutes)      m |= FOSSIL_TIME_SPAN_PRECISION_MINUTES;
+    if (span->seconds)      m |= FOSSIL_TIME_SPAN_PRECISION_SECONDS;
+    if (span->milliseconds) m |= FOSSIL_TIME_SPAN_PRECISION_MILLI;
+    if (span->microseconds) m |= FOSSIL_TIME_SPAN_PRECISION_MICRO;
+    if (span->nanoseconds)  m |= FOSSIL_TIME_SPAN_PRECISION_NANO;
+    if (span->picoseconds)  m |= FOSSIL_TIME_SPAN_PRECISION_PICO;
+    if (span->femtoseconds) m |= FOSSIL_TIME_SPAN_PRECISION_FEMTO;
+    if (span->attoseconds)  m |= FOSSIL_TIME_SPAN_PRECISION_ATTO;
+    if (span->zeptoseconds) m |= FOSSIL_TIME_SPAN_PRECISION_ZEPTO;
+    if (span->yoctoseconds) m |= FOSSIL_TIME_SPAN_PRECISION_YOCTO;
+    return m;
+}
+
 void fossil_time_span_normalize(fossil_time_span_t *span) {
     if (!span) return;
 
-    /* Carry SI ladder upward */
-    span->microseconds += span->nanoseconds / 1000;
-    span->nanoseconds  %= 1000;
-
-    span->milliseconds += span->microseconds / 1000;
-    span->microseconds %= 1000;
-
-    span->seconds += span->milliseconds / 1000;
-    span->milliseconds %= 1000;
+    /* Carry every field, set or not, through the tick count: the magnitude
+     * is split with floor division and each field takes the total's sign */
+    uint64_t mask = span->precision_mask;
+    fossil_time_span_t all = *span;
+    all.precision_mask = FOSSIL_TIME_SPAN_ALL_UNITS;
 
-    span->minutes += span->seconds / 60;
-    span->seconds %= 60;
+    fossil_time_span_from_ticks(span, fossil_time_span_to_ticks(&all));
+    span->precision_mask = mask | fossil_time_span_used_mask(span);
+}
 
-    span->hours += span->minutes / 60;
-    span->minutes %= 60;
+void fossil_time_span_normalize_batch(fossil_time_span_t *spans, size_t count) {
+    if (!spans) return;
 
-    span->days += span->hours / 24;
-    span->hours %= 24;
+    for (size_t i = 0; i < count; i++)
+        fossil_time_span_normalize(&spans[i]);
 }
 
 /* ======================================================
  * Construction
  * ====================================================== */
 
-void fossil_time_span_from_unit(
+/* Set the one field named by unit_id; -1 if the unit is unknown */
+static inline int fossil_span_set_unit(
     fossil_time_span_t *span,
     int64_t value,
     const char *unit_id
 ) {
-    if (!span || !unit_id) return;
-
-    fossil_time_span_clear(span);
-
     if (unit_equals(unit_id, "days")) {
         span->days = value;
         span->precision_mask = FOSSIL_TIME_SPAN_PRECISION_DAYS;
@@ -130,7 +421,21 @@ void fossil_time_span_from_unit(
     } else if (unit_equals(unit_id, "ys")) {
         span->yoctoseconds = (int32_t)value;
         span->precision_mask = FOSSIL_TIME_SPAN_PRECISION_YOCTO;
+    } else {
+        return -1;
     }
+    return 0;
+}
+
+void fossil_time_span_from_unit(
+    fossil_time_span_t *span,
+    int64_t value,
+    const char *unit_id
+) {
+    if (!span || !unit_id) return;
+
+    fossil_time_span_clear(span);
+    fossil_span_set_unit(span, value, unit_id);
 }
 
 void fossil_time_span_from_ai(
@@ -220,73 +525,1929 @@ void fossil_time_span_sub(
 int64_t fossil_time_span_to_seconds(const fossil_time_span_t *span) {
     if (!span) return 0;
 
-    int64_t total = 0;
+    /* Summed unsigned so out-of-range days wrap instead of overflowing */
+    uint64_t total = 0;
 
     if (span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_DAYS)
-        total += span->days * 86400;
+        total += (uint64_t)span->days * 86400;
 
     if (span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_HOURS)
-        total += span->hours * 3600;
+        total += (uint64_t)((int64_t)span->hours * 3600);
 
     if (span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_MINUTES)
-        total += span->minutes * 60;
+        total += (uint64_t)((int64_t)span->minutes * 60);
 
     if (span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_SECONDS)
-        total += span->seconds;
+        total += (uint64_t)(int64_t)span->seconds;
 
-    return total;
+    return (int64_t)total;
 }
 
 int64_t fossil_time_span_to_nanoseconds(const fossil_time_span_t *span) {
     if (!span) return 0;
 
-    int64_t total = fossil_time_span_to_seconds(span);
-    total *= 1000000000LL;
+    /* Wraps like fossil_time_span_to_seconds; the _checked form reports it */
+    uint64_t total = (uint64_t)fossil_time_span_to_seconds(span) * 1000000000ULL;
 
     if (span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_MILLI)
-        total += (int64_t)span->milliseconds * 1000000LL;
+        total += (uint64_t)((int64_t)span->milliseconds * 1000000LL);
 
     if (span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_MICRO)
-        total += (int64_t)span->microseconds * 1000LL;
+        total += (uint64_t)((int64_t)span->microseconds * 1000LL);
 
     if (span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_NANO)
-        total += span->nanoseconds;
+        total += (uint64_t)(int64_t)span->nanoseconds;
+
+    return (int64_t)total;
+}
+
+void fossil_time_span_from_nanoseconds(
+    fossil_time_span_t *span,
+    int64_t nanoseconds
+) {
+    if (!span) return;
+    fossil_time_span_from_ticks(span, ticks_mul_add(ticks_from_i64(nanoseconds), 1000000000000000ULL, 0));
+}
+
+int fossil_time_span_to_unit(
+    const fossil_time_span_t *span,
+    const char *unit_id,
+    fossil_time_span_ticks_t *count,
+    fossil_time_span_ticks_t *remainder
+) {
+    fossil_time_span_ticks_t q, r;
+    int k = fossil_span_unit_index(unit_id);
+
+    if (!span || !count || k < 0) return -1;
+
+    ticks_sdivmod(fossil_time_span_to_ticks(span), fossil_span_unit_ratio[k][FOSSIL_SPAN_UNIT_YS], &q, &r);
+    *count = q;
+    if (remainder)
+        *remainder = r;
+    return 0;
+}
+
+int fossil_time_span_from_unit_exact(
+    fossil_time_span_t *span,
+    fossil_time_span_ticks_t count,
+    const char *unit_id
+) {
+    fossil_time_span_ticks_t t;
+    int k = fossil_span_unit_index(unit_id);
+
+    if (!span || k < 0) return -1;
+
+    if (ticks_mul_ov(count, fossil_span_unit_ratio[k][FOSSIL_SPAN_UNIT_YS], &t))
+        return -1;
+    fossil_time_span_from_ticks(span, t);
+    return 0;
+}
+
+int fossil_time_span_convert_unit(
+    fossil_time_span_ticks_t count,
+    const char *from_unit,
+    const char *to_unit,
+    fossil_time_span_ticks_t *out,
+    fossil_time_span_ticks_t *remainder
+) {
+    fossil_time_span_ticks_t q, r = ticks_from_i64(0);
+    int i = fossil_span_unit_index(from_unit);
+    int j = fossil_span_unit_index(to_unit);
 
-    return total;
+    if (!out || i < 0 || j < 0) return -1;
+
+    /* One multiply towards finer units, one division towards coarser */
+    if (i <= j) {
+        if (ticks_mul_ov(count, fossil_span_unit_ratio[i][j], &q))
+            return -1;
+    } else {
+        ticks_sdivmod(count, fossil_span_unit_ratio[i][j], &q, &r);
+    }
+    *out = q;
+    if (remainder)
+        *remainder = r;
+    return 0;
 }
 
 /* ======================================================
- * Formatting
+ * Canonical Ticks
  * ====================================================== */
 
-int fossil_time_span_format(
-    const fossil_time_span_t *span,
-    char *buffer,
-    size_t buffer_size,
-    const char *format_id
+fossil_time_span_ticks_t fossil_time_span_to_ticks(const fossil_time_span_t *span) {
+    if (!span) return ticks_from_i64(0);
+
+    uint64_t m = span->precision_mask;
+    int64_t secs = fossil_time_span_to_seconds(span);
+
+    /* Each group fits 64 bits even for unnormalized int32 fields */
+    int64_t ns = 0, as = 0, ys = 0;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_MILLI) ns += (int64_t)span->milliseconds * 1000000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_MICRO) ns += (int64_t)span->microseconds * 1000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_NANO)  ns += span->nanoseconds;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_PICO)  as += (int64_t)span->picoseconds * 1000000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_FEMTO) as += (int64_t)span->femtoseconds * 1000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_ATTO)  as += span->attoseconds;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_ZEPTO) ys += (int64_t)span->zeptoseconds * 1000;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_YOCTO) ys += span->yoctoseconds;
+
+    fossil_time_span_ticks_t t = ticks_from_i64(secs);
+    t = ticks_mul_add(t, 1000000000ULL, ns);
+    t = ticks_mul_add(t, 1000000000ULL, as);
+    return ticks_mul_add(t, 1000000ULL, ys);
+}
+
+void fossil_time_span_from_ticks(
+    fossil_time_span_t *span,
+    fossil_time_span_ticks_t ticks
 ) {
-    if (!span || !buffer || buffer_size == 0 || !format_id)
+    if (!span) return;
+
+    int neg = ticks.hi < 0;
+    fossil_time_span_ticks_t m = neg ? ticks_neg(ticks) : ticks;
+    int32_t f[8]; /* ys, zs, as, fs, ps, ns, us, ms */
+    uint32_t r;
+
+    r = ticks_udiv_u32(&m, 1000000000U);
+    f[0] = (int32_t)(r % 1000); f[1] = (int32_t)(r / 1000 % 1000); f[2] = (int32_t)(r / 1000000);
+    r = ticks_udiv_u32(&m, 1000000U);
+    f[3] = (int32_t)(r % 1000); f[4] = (int32_t)(r / 1000);
+    r = ticks_udiv_u32(&m, 1000000000U);
+    f[5] = (int32_t)(r % 1000); f[6] = (int32_t)(r / 1000 % 1000); f[7] = (int32_t)(r / 1000000);
+
+    /* At most 2^127 ys, so whole seconds now fit the low word */
+    uint64_t secs = m.lo;
+    int64_t sign = neg ? -1 : 1;
+
+    fossil_time_span_zero_fields(span);
+    span->days         = (int64_t)(secs / 86400) * sign;
+    span->hours        = (int32_t)(secs / 3600 % 24) * (int32_t)sign;
+    span->minutes      = (int32_t)(secs / 60 % 60) * (int32_t)sign;
+    span->seconds      = (int32_t)(secs % 60) * (int32_t)sign;
+    span->milliseconds = f[7] * (int32_t)sign;
+    span->microseconds = f[6] * (int32_t)sign;
+    span->nanoseconds  = f[5] * (int32_t)sign;
+    span->picoseconds  = f[4] * (int32_t)sign;
+    span->femtoseconds = f[3] * (int32_t)sign;
+    span->attoseconds  = f[2] * (int32_t)sign;
+    span->zeptoseconds = f[1] * (int32_t)sign;
+    span->yoctoseconds = f[0] * (int32_t)sign;
+
+    span->precision_mask =
+        FOSSIL_TIME_SPAN_PRECISION_DAYS    |
+        FOSSIL_TIME_SPAN_PRECISION_HOURS   |
+        FOSSIL_TIME_SPAN_PRECISION_MINUTES |
+        FOSSIL_TIME_SPAN_PRECISION_SECONDS;
+
+    /* Sub-second bits run from ms down to the finest non-zero unit */
+    for (int i = 0; i < 8; i++) {
+        if (f[i] != 0) {
+            for (int j = 7; j >= i; j--)
+                span->precision_mask |= FOSSIL_TIME_SPAN_PRECISION_MILLI << (7 - j);
+            break;
+        }
+    }
+}
+
+fossil_time_span_ticks_t fossil_time_span_ticks_add(
+    fossil_time_span_ticks_t a,
+    fossil_time_span_ticks_t b
+) {
+    fossil_time_span_ticks_t r;
+    r.lo = a.lo + b.lo;
+    r.hi = (int64_t)((uint64_t)a.hi + (uint64_t)b.hi + (r.lo < a.lo));
+    return r;
+}
+
+fossil_time_span_ticks_t fossil_time_span_ticks_sub(
+    fossil_time_span_ticks_t a,
+    fossil_time_span_ticks_t b
+) {
+    fossil_time_span_ticks_t r;
+    r.lo = a.lo - b.lo;
+    r.hi = (int64_t)((uint64_t)a.hi - (uint64_t)b.hi - (a.lo < b.lo));
+    return r;
+}
+
+int fossil_time_span_ticks_cmp(
+    fossil_time_span_ticks_t a,
+    fossil_time_span_ticks_t b
+) {
+    if (a.hi != b.hi) return a.hi < b.hi ? -1 : 1;
+    if (a.lo != b.lo) return a.lo < b.lo ? -1 : 1;
+    return 0;
+}
+
+int fossil_time_span_compare(
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+) {
+    return fossil_time_span_ticks_cmp(fossil_time_span_to_ticks(a), fossil_time_span_to_ticks(b));
+}
+
+/* ======================================================
+ * Aggregates
+ * ====================================================== */
+
+/*
+ * Sums are kept in 192 bits, so no ordering of in-range inputs can overflow
+ * before the final result is checked. The array loops carry nothing: 64-bit
+ * words are split into 32-bit halves, each summed in its own 64-bit counter
+ * that cannot overflow within FOSSIL_SPAN_AGG_BLOCK elements, and folded
+ * into the accumulator once per block. The tick sum is then a plain
+ * reduction that compilers vectorize at -O3. The per-field span sum is not
+ * (64-byte records mixing int64 and int32), so SSE2 targets sum the eleven
+ * masked int32 fields with intrinsics, as index.c does for its prefetch.
+ */
+
+typedef struct {
+    uint64_t w[3]; /* two's complement, low word first */
+} fossil_span_acc_t;
+
+/* Elements per block: 2^31 int32 values or 32-bit halves stay within 64-bit sums */
+#define FOSSIL_SPAN_AGG_BLOCK ((size_t)1 << 31)
+
+static void fossil_span_acc_add(fossil_span_acc_t *acc, uint64_t w0, uint64_t w1, uint64_t w2) {
+    uint64_t c0, c1;
+    acc->w[0] += w0;
+    c0 = acc->w[0] < w0;
+    acc->w[1] += w1;
+    c1 = acc->w[1] < w1;
+    acc->w[1] += c0;
+    c1 += acc->w[1] < c0;
+    acc->w[2] += w2 + c1;
+}
+
+static int fossil_span_acc_neg(const fossil_span_acc_t *acc) {
+    return (acc->w[2] >> 63) != 0;
+}
+
+static void fossil_span_acc_negate(fossil_span_acc_t *acc) {
+    acc->w[0] = ~acc->w[0] + 1;
+    acc->w[1] = ~acc->w[1] + (acc->w[0] == 0);
+    acc->w[2] = ~acc->w[2] + (acc->w[0] == 0 && acc->w[1] == 0);
+}
+
+/* acc += v * unit for a non-negative unit below 2^127 */
+static void fossil_span_acc_add_scaled(fossil_span_acc_t *acc, int64_t v, fossil_time_span_ticks_t unit) {
+    fossil_span_acc_t p;
+    uint64_t mag = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+    uint64_t c0, c1;
+
+    p.w[0] = umul64(mag, unit.lo, &c0);
+    p.w[1] = umul64(mag, (uint64_t)unit.hi, &c1);
+    p.w[1] += c0;
+    p.w[2] = c1 + (p.w[1] < c0);
+    if (v < 0)
+        fossil_span_acc_negate(&p);
+    fossil_span_acc_add(acc, p.w[0], p.w[1], p.w[2]);
+}
+
+/* The accumulator as ticks; nonzero if it does not fit 128 bits */
+static int fossil_span_acc_ticks(const fossil_span_acc_t *acc, fossil_time_span_ticks_t *out) {
+    uint64_t ext = (acc->w[1] >> 63) ? ~0ULL : 0;
+    out->lo = acc->w[0];
+    out->hi = (int64_t)acc->w[1];
+    return acc->w[2] != ext;
+}
+
+/* Quotient rounded toward zero by d > 0 (shift-subtract, once per call) */
+static void fossil_span_acc_div(fossil_span_acc_t *acc, uint64_t d) {
+    int neg = fossil_span_acc_neg(acc);
+    uint64_t rem = 0;
+
+    if (neg)
+        fossil_span_acc_negate(acc);
+    for (int i = 191; i >= 0; i--) {
+        uint64_t top = rem >> 63;
+        rem = (rem << 1) | ((acc->w[i / 64] >> (i % 64)) & 1);
+        acc->w[i / 64] &= ~(1ULL << (i % 64));
+        if (top || rem >= d) {
+            rem -= d;
+            acc->w[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+    if (neg)
+        fossil_span_acc_negate(acc);
+}
+
+static void fossil_span_acc_sum_ticks(
+    fossil_span_acc_t *acc,
+    const fossil_time_span_ticks_t *ticks,
+    size_t count
+) {
+    memset(acc, 0, sizeof(*acc));
+
+    for (size_t base = 0; base < count; base += FOSSIL_SPAN_AGG_BLOCK) {
+        size_t end = count - base < FOSSIL_SPAN_AGG_BLOCK ? count : base + FOSSIL_SPAN_AGG_BLOCK;
+        uint64_t w0 = 0, w1 = 0, w2 = 0;
+        int64_t w3 = 0;
+
+        for (size_t i = base; i < end; i++) {
+            w0 += ticks[i].lo & 0xFFFFFFFFULL;
+            w1 += ticks[i].lo >> 32;
+            w2 += (uint64_t)ticks[i].hi & 0xFFFFFFFFULL;
+            w3 += ticks[i].hi >> 32;
+        }
+
+        fossil_span_acc_add(acc, w0, 0, 0);
+        fossil_span_acc_add(acc, w1 << 32, w1 >> 32, 0);
+        fossil_span_acc_add(acc, 0, w2, 0);
+        fossil_span_acc_add(acc, 0, (uint64_t)w3 << 32, (uint64_t)(w3 >> 32));
+    }
+}
+
+/* hours..yoctoseconds are read as one int32 array, padded to 64 bytes */
+typedef char fossil_span_fields_contiguous[
+    offsetof(fossil_time_span_t, yoctoseconds) - offsetof(fossil_time_span_t, hours)
+        == 10 * sizeof(int32_t)
+    && offsetof(fossil_time_span_t, hours) + 12 * sizeof(int32_t) <= sizeof(fossil_time_span_t) ? 1 : -1];
+
+/* Sum the masked fields of every span; nonzero if a days total leaves int64 */
+static int fossil_span_acc_sum_spans(
+    fossil_span_acc_t *acc,
+    const fossil_time_span_t *spans,
+    size_t count
+) {
+    memset(acc, 0, sizeof(*acc));
+
+    for (size_t base = 0; base < count; base += FOSSIL_SPAN_AGG_BLOCK) {
+        size_t end = count - base < FOSSIL_SPAN_AGG_BLOCK ? count : base + FOSSIL_SPAN_AGG_BLOCK;
+        int64_t f[12] = { 0 };
+        uint64_t days_lo = 0, days_hi_lo;
+        int64_t days_hi = 0;
+#if defined(FOSSIL_SPAN_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bits[3] = {
+            _mm_setr_epi32(1 << 1, 1 << 2, 1 << 3, 1 << 4),
+            _mm_setr_epi32(1 << 5, 1 << 6, 1 << 7, 1 << 8),
+            _mm_setr_epi32(1 << 9, 1 << 10, 1 << 11, 0)
+        };
+        __m128i sum[6] = { zero, zero, zero, zero, zero, zero };
+#endif
+
+        for (size_t i = base; i < end; i++) {
+            const fossil_time_span_t *p = &spans[i];
+            uint64_t m = p->precision_mask;
+            int64_t d = p->days & ((int64_t)0 - (int64_t)(m & FOSSIL_TIME_SPAN_PRECISION_DAYS));
+
+            days_lo += (uint64_t)d & 0xFFFFFFFFULL;
+            days_hi += d >> 32;
+
+#if defined(FOSSIL_SPAN_SSE2)
+            /* Three 4 x int32 loads; the padding lane after ys has no mask bit */
+            __m128i mv = _mm_set1_epi32((int)(uint32_t)m);
+            for (int g = 0; g < 3; g++) {
+                __m128i x = _mm_loadu_si128((const __m128i *)((const int32_t *)&p->hours + 4 * g));
+                x = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(mv, bits[g]), zero), x);
+                sum[2 * g]     = _mm_add_epi64(sum[2 * g], _mm_unpacklo_epi32(x, _mm_srai_epi32(x, 31)));
+                sum[2 * g + 1] = _mm_add_epi64(sum[2 * g + 1], _mm_unpackhi_epi32(x, _mm_srai_epi32(x, 31)));
+            }
+#else
+            /* Twelve fixed lanes (the last always zero) so they can pack into vectors */
+            int32_t v[12];
+            memcpy(v, &p->hours, 11 * sizeof(int32_t));
+            v[11] = 0;
+            for (int k = 0; k < 12; k++)
+                f[k] += (int64_t)v[k] & ((int64_t)0 - (int64_t)((m >> (k + 1)) & 1));
+#endif
+        }
+#if defined(FOSSIL_SPAN_SSE2)
+        for (int g = 0; g < 6; g++)
+            _mm_storeu_si128((__m128i *)&f[2 * g], sum[g]);
+#endif
+
+        /* days_hi * 2^32 + days_lo as 128 bits must be a sign-extended int64 */
+        days_hi_lo = ((uint64_t)days_hi << 32) + days_lo;
+        if ((uint64_t)(days_hi >> 32) + (days_hi_lo < days_lo) != ((days_hi_lo >> 63) ? ~0ULL : 0))
+            return 1;
+
+        fossil_span_acc_add_scaled(acc, (int64_t)days_hi_lo, fossil_span_unit_ratio[0][FOSSIL_SPAN_UNIT_YS]);
+        for (int k = 0; k < 11; k++)
+            fossil_span_acc_add_scaled(acc, f[k], fossil_span_unit_ratio[k + 1][FOSSIL_SPAN_UNIT_YS]);
+    }
+    return 0;
+}
+
+/* x - mean in seconds: exact in ticks, rounded once to double */
+static double fossil_span_deviation_s(fossil_time_span_ticks_t x, fossil_time_span_ticks_t mean) {
+    fossil_time_span_ticks_t d = fossil_time_span_ticks_sub(x, mean);
+    int neg;
+
+    /* Past the tick range the difference wraps; fall back to the high words */
+    if ((x.hi < 0) != (mean.hi < 0) && (d.hi < 0) != (x.hi < 0))
+        return ((double)x.hi - (double)mean.hi) * 18446744073709551616.0 / 1e24;
+
+    neg = d.hi < 0;
+    if (neg)
+        d = ticks_neg(d);
+    double v = ((double)(uint64_t)d.hi * 18446744073709551616.0 + (double)d.lo) / 1e24;
+    return neg ? -v : v;
+}
+
+int fossil_time_span_ticks_sum(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    fossil_time_span_ticks_t *out
+) {
+    fossil_span_acc_t acc;
+
+    if (!out || (count > 0 && !ticks))
+        return -1;
+
+    fossil_span_acc_sum_ticks(&acc, ticks, count);
+    return fossil_span_acc_ticks(&acc, out) ? -1 : 0;
+}
+
+int fossil_time_span_ticks_mean(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    fossil_time_span_ticks_t *out
+) {
+    fossil_span_acc_t acc;
+
+    if (!ticks || !out || count == 0)
+        return -1;
+
+    fossil_span_acc_sum_ticks(&acc, ticks, count);
+    fossil_span_acc_div(&acc, (uint64_t)count);
+    return fossil_span_acc_ticks(&acc, out) ? -1 : 0;
+}
+
+int fossil_time_span_ticks_min(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    fossil_time_span_ticks_t *out
+) {
+    fossil_time_span_ticks_t best;
+
+    if (!ticks || !out || count == 0)
+        return -1;
+
+    best = ticks[0];
+    for (size_t i = 1; i < count; i++) {
+        if (ticks[i].hi < best.hi || (ticks[i].hi == best.hi && ticks[i].lo < best.lo))
+            best = ticks[i];
+    }
+    *out = best;
+    return 0;
+}
+
+int fossil_time_span_ticks_max(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    fossil_time_span_ticks_t *out
+) {
+    fossil_time_span_ticks_t best;
+
+    if (!ticks || !out || count == 0)
         return -1;
 
-    if (unit_equals(format_id, "short")) {
-        return snprintf(buffer, buffer_size,
-            "%lldd %dh %dm %ds",
-            (long long)span->days,
-            span->hours,
-            span->minutes,
-            span->seconds
-        );
+    best = ticks[0];
+    for (size_t i = 1; i < count; i++) {
+        if (ticks[i].hi > best.hi || (ticks[i].hi == best.hi && ticks[i].lo > best.lo))
+            best = ticks[i];
     }
+    *out = best;
+    return 0;
+}
+
+int fossil_time_span_ticks_variance(
+    const fossil_time_span_ticks_t *ticks,
+    size_t count,
+    double *out
+) {
+    fossil_time_span_ticks_t mean;
+    double sum = 0.0;
 
-    if (unit_equals(format_id, "human")) {
-        return snprintf(buffer, buffer_size,
-            "%lld days, %d hours, %d minutes, %d seconds",
-            (long long)span->days,
-            span->hours,
-            span->minutes,
-            span->seconds
-        );
+    if (!out || fossil_time_span_ticks_mean(ticks, count, &mean) != 0)
+        return -1;
+
+    for (size_t i = 0; i < count; i++) {
+        double d = fossil_span_deviation_s(ticks[i], mean);
+        sum += d * d;
     }
+    *out = sum / (double)count;
+    return 0;
+}
 
-    return -1;
+int fossil_time_span_sum(
+    const fossil_time_span_t *spans,
+    size_t count,
+    fossil_time_span_t *out
+) {
+    fossil_span_acc_t acc;
+    fossil_time_span_ticks_t total;
+
+    if (!out || (count > 0 && !spans))
+        return -1;
+
+    if (fossil_span_acc_sum_spans(&acc, spans, count) || fossil_span_acc_ticks(&acc, &total))
+        return -1;
+    fossil_time_span_from_ticks(out, total);
+    return 0;
+}
+
+int fossil_time_span_mean(
+    const fossil_time_span_t *spans,
+    size_t count,
+    fossil_time_span_t *out
+) {
+    fossil_span_acc_t acc;
+    fossil_time_span_ticks_t mean;
+
+    if (!spans || !out || count == 0)
+        return -1;
+
+    if (fossil_span_acc_sum_spans(&acc, spans, count))
+        return -1;
+    fossil_span_acc_div(&acc, (uint64_t)count);
+    if (fossil_span_acc_ticks(&acc, &mean))
+        return -1;
+    fossil_time_span_from_ticks(out, mean);
+    return 0;
+}
+
+int fossil_time_span_min(
+    const fossil_time_span_t *spans,
+    size_t count,
+    fossil_time_span_t *out
+) {
+    size_t best = 0;
+    fossil_time_span_ticks_t best_ticks;
+
+    if (!spans || !out || count == 0)
+        return -1;
+
+    best_ticks = fossil_time_span_to_ticks(&spans[0]);
+    for (size_t i = 1; i < count; i++) {
+        fossil_time_span_ticks_t t = fossil_time_span_to_ticks(&spans[i]);
+        if (fossil_time_span_ticks_cmp(t, best_ticks) < 0) {
+            best = i;
+            best_ticks = t;
+        }
+    }
+    *out = spans[best];
+    return 0;
+}
+
+int fossil_time_span_max(
+    const fossil_time_span_t *spans,
+    size_t count,
+    fossil_time_span_t *out
+) {
+    size_t best = 0;
+    fossil_time_span_ticks_t best_ticks;
+
+    if (!spans || !out || count == 0)
+        return -1;
+
+    best_ticks = fossil_time_span_to_ticks(&spans[0]);
+    for (size_t i = 1; i < count; i++) {
+        fossil_time_span_ticks_t t = fossil_time_span_to_ticks(&spans[i]);
+        if (fossil_time_span_ticks_cmp(t, best_ticks) > 0) {
+            best = i;
+            best_ticks = t;
+        }
+    }
+    *out = spans[best];
+    return 0;
+}
+
+int fossil_time_span_variance(
+    const fossil_time_span_t *spans,
+    size_t count,
+    double *out
+) {
+    fossil_span_acc_t acc;
+    fossil_time_span_ticks_t mean;
+    double sum = 0.0;
+
+    if (!spans || !out || count == 0)
+        return -1;
+
+    if (fossil_span_acc_sum_spans(&acc, spans, count))
+        return -1;
+    fossil_span_acc_div(&acc, (uint64_t)count);
+    if (fossil_span_acc_ticks(&acc, &mean))
+        return -1;
+
+    for (size_t i = 0; i < count; i++) {
+        double d = fossil_span_deviation_s(fossil_time_span_to_ticks(&spans[i]), mean);
+        sum += d * d;
+    }
+    *out = sum / (double)count;
+    return 0;
+}
+
+/* ======================================================
+ * Checked and Saturating Arithmetic
+ * ====================================================== */
+
+/*
+ * Overflow tests use the compiler builtins where available; the fallbacks
+ * compute the same flags with plain integer math (MSVC has no builtins).
+ * Flags are ORed across fields, so the common path has a single branch.
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FOSSIL_SPAN_HAVE_OVERFLOW_BUILTINS 1
+#endif
+
+static inline int fossil_span_add64_ov(int64_t a, int64_t b, int64_t *r) {
+#if defined(FOSSIL_SPAN_HAVE_OVERFLOW_BUILTINS)
+    return __builtin_add_overflow(a, b, r);
+#else
+    *r = (int64_t)((uint64_t)a + (uint64_t)b);
+    return ((a ^ *r) & (b ^ *r)) < 0;
+#endif
+}
+
+static inline int fossil_span_sub64_ov(int64_t a, int64_t b, int64_t *r) {
+#if defined(FOSSIL_SPAN_HAVE_OVERFLOW_BUILTINS)
+    return __builtin_sub_overflow(a, b, r);
+#else
+    *r = (int64_t)((uint64_t)a - (uint64_t)b);
+    return ((a ^ b) & (a ^ *r)) < 0;
+#endif
+}
+
+static inline int fossil_span_mul64_ov(int64_t a, int64_t b, int64_t *r) {
+#if defined(FOSSIL_SPAN_HAVE_OVERFLOW_BUILTINS)
+    return __builtin_mul_overflow(a, b, r);
+#else
+    uint64_t ma = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+    uint64_t mb = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+    uint64_t hi, lo = umul64(ma, mb, &hi);
+    int neg = (a < 0) != (b < 0);
+    *r = (int64_t)(neg ? 0 - lo : lo);
+    return hi != 0 || lo > (neg ? (1ULL << 63) : (1ULL << 63) - 1);
+#endif
+}
+
+static inline int fossil_span_add32_ov(int32_t a, int32_t b, int32_t *r) {
+#if defined(FOSSIL_SPAN_HAVE_OVERFLOW_BUILTINS)
+    return __builtin_add_overflow(a, b, r);
+#else
+    int64_t s = (int64_t)a + b;
+    *r = (int32_t)s;
+    return s != *r;
+#endif
+}
+
+static inline int fossil_span_sub32_ov(int32_t a, int32_t b, int32_t *r) {
+#if defined(FOSSIL_SPAN_HAVE_OVERFLOW_BUILTINS)
+    return __builtin_sub_overflow(a, b, r);
+#else
+    int64_t s = (int64_t)a - b;
+    *r = (int32_t)s;
+    return s != *r;
+#endif
+}
+
+static inline int fossil_span_mul32_ov(int32_t a, int64_t b, int32_t *r) {
+#if defined(FOSSIL_SPAN_HAVE_OVERFLOW_BUILTINS)
+    return __builtin_mul_overflow(a, b, r);
+#else
+    int64_t p;
+    int ov = fossil_span_mul64_ov(a, b, &p);
+    *r = (int32_t)p;
+    return ov || p != *r;
+#endif
+}
+
+static const fossil_time_span_ticks_t fossil_span_ticks_max = { INT64_MAX, UINT64_MAX };
+static const fossil_time_span_ticks_t fossil_span_ticks_min = { INT64_MIN, 0 };
+
+/* Within this many days no field combination, nor the sum or difference
+ * of two such spans, can leave the tick range */
+#define FOSSIL_SPAN_SAFE_DAYS 500000000LL
+
+static int fossil_span_ticks_safe(const fossil_time_span_t *span) {
+    return !(span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_DAYS) ||
+        (span->days <= FOSSIL_SPAN_SAFE_DAYS && span->days >= -FOSSIL_SPAN_SAFE_DAYS);
+}
+
+/* The span's ticks, clamped to the tick range; nonzero if clamped */
+static int fossil_span_ticks_clamped(const fossil_time_span_t *span, fossil_time_span_ticks_t *out) {
+    fossil_span_acc_t acc;
+
+    if (fossil_span_ticks_safe(span)) {
+        *out = fossil_time_span_to_ticks(span);
+        return 0;
+    }
+
+    if (fossil_span_acc_sum_spans(&acc, span, 1) == 0 && fossil_span_acc_ticks(&acc, out) == 0)
+        return 0;
+    *out = (span->days < 0) ? fossil_span_ticks_min : fossil_span_ticks_max;
+    return 1;
+}
+
+/* t * k, wrapping; nonzero on leaving the tick range */
+static int fossil_span_ticks_mul_ov(
+    fossil_time_span_ticks_t t,
+    int64_t k,
+    fossil_time_span_ticks_t *r
+) {
+    int neg = (t.hi < 0) != (k < 0);
+    fossil_time_span_ticks_t m = t.hi < 0 ? ticks_neg(t) : t;
+    uint64_t mk = k < 0 ? 0 - (uint64_t)k : (uint64_t)k;
+    uint64_t carry, top, lo, mid, hi;
+
+    /* Magnitudes: |t| <= 2^127, and the product may reach 2^127 only if negative */
+    lo = umul64(m.lo, mk, &carry);
+    mid = umul64((uint64_t)m.hi, mk, &top);
+    hi = mid + carry;
+    top += hi < mid;
+
+    r->lo = lo;
+    r->hi = (int64_t)hi;
+    if (neg)
+        *r = ticks_neg(*r);
+    if (top != 0 || hi > (1ULL << 63))
+        return 1;
+    return hi == (1ULL << 63) && (!neg || lo != 0);
+}
+
+static fossil_time_span_ticks_t fossil_span_ticks_saturate(int ov, int neg, fossil_time_span_ticks_t r) {
+    if (!ov)
+        return r;
+    return neg ? fossil_span_ticks_min : fossil_span_ticks_max;
+}
+
+int fossil_time_span_add_checked(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+) {
+    fossil_time_span_t r;
+    int ov = 0;
+
+    if (!result || !a || !b) return -1;
+
+    r = *a;
+    ov |= fossil_span_add64_ov(a->days, b->days, &r.days);
+    ov |= fossil_span_add32_ov(a->hours, b->hours, &r.hours);
+    ov |= fossil_span_add32_ov(a->minutes, b->minutes, &r.minutes);
+    ov |= fossil_span_add32_ov(a->seconds, b->seconds, &r.seconds);
+    ov |= fossil_span_add32_ov(a->milliseconds, b->milliseconds, &r.milliseconds);
+    ov |= fossil_span_add32_ov(a->microseconds, b->microseconds, &r.microseconds);
+    ov |= fossil_span_add32_ov(a->nanoseconds, b->nanoseconds, &r.nanoseconds);
+    ov |= fossil_span_add32_ov(a->picoseconds, b->picoseconds, &r.picoseconds);
+    ov |= fossil_span_add32_ov(a->femtoseconds, b->femtoseconds, &r.femtoseconds);
+    ov |= fossil_span_add32_ov(a->attoseconds, b->attoseconds, &r.attoseconds);
+    ov |= fossil_span_add32_ov(a->zeptoseconds, b->zeptoseconds, &r.zeptoseconds);
+    ov |= fossil_span_add32_ov(a->yoctoseconds, b->yoctoseconds, &r.yoctoseconds);
+    if (ov) return -1;
+
+    r.precision_mask |= b->precision_mask;
+    *result = r;
+    return 0;
+}
+
+int fossil_time_span_sub_checked(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+) {
+    fossil_time_span_t r;
+    int ov = 0;
+
+    if (!result || !a || !b) return -1;
+
+    r = *a;
+    ov |= fossil_span_sub64_ov(a->days, b->days, &r.days);
+    ov |= fossil_span_sub32_ov(a->hours, b->hours, &r.hours);
+    ov |= fossil_span_sub32_ov(a->minutes, b->minutes, &r.minutes);
+    ov |= fossil_span_sub32_ov(a->seconds, b->seconds, &r.seconds);
+    ov |= fossil_span_sub32_ov(a->milliseconds, b->milliseconds, &r.milliseconds);
+    ov |= fossil_span_sub32_ov(a->microseconds, b->microseconds, &r.microseconds);
+    ov |= fossil_span_sub32_ov(a->nanoseconds, b->nanoseconds, &r.nanoseconds);
+    ov |= fossil_span_sub32_ov(a->picoseconds, b->picoseconds, &r.picoseconds);
+    ov |= fossil_span_sub32_ov(a->femtoseconds, b->femtoseconds, &r.femtoseconds);
+    ov |= fossil_span_sub32_ov(a->attoseconds, b->attoseconds, &r.attoseconds);
+    ov |= fossil_span_sub32_ov(a->zeptoseconds, b->zeptoseconds, &r.zeptoseconds);
+    ov |= fossil_span_sub32_ov(a->yoctoseconds, b->yoctoseconds, &r.yoctoseconds);
+    if (ov) return -1;
+
+    r.precision_mask |= b->precision_mask;
+    *result = r;
+    return 0;
+}
+
+int fossil_time_span_scale_checked(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t factor
+) {
+    fossil_time_span_t r;
+    int ov = 0;
+
+    if (!result || !span) return -1;
+
+    r = *span;
+    ov |= fossil_span_mul64_ov(span->days, factor, &r.days);
+    ov |= fossil_span_mul32_ov(span->hours, factor, &r.hours);
+    ov |= fossil_span_mul32_ov(span->minutes, factor, &r.minutes);
+    ov |= fossil_span_mul32_ov(span->seconds, factor, &r.seconds);
+    ov |= fossil_span_mul32_ov(span->milliseconds, factor, &r.milliseconds);
+    ov |= fossil_span_mul32_ov(span->microseconds, factor, &r.microseconds);
+    ov |= fossil_span_mul32_ov(span->nanoseconds, factor, &r.nanoseconds);
+    ov |= fossil_span_mul32_ov(span->picoseconds, factor, &r.picoseconds);
+    ov |= fossil_span_mul32_ov(span->femtoseconds, factor, &r.femtoseconds);
+    ov |= fossil_span_mul32_ov(span->attoseconds, factor, &r.attoseconds);
+    ov |= fossil_span_mul32_ov(span->zeptoseconds, factor, &r.zeptoseconds);
+    ov |= fossil_span_mul32_ov(span->yoctoseconds, factor, &r.yoctoseconds);
+    if (ov) return -1;
+
+    *result = r;
+    return 0;
+}
+
+/* from_unit_checked past the int32 field range, through the tick view */
+static int fossil_span_from_unit_wide(
+    fossil_time_span_t *span,
+    int64_t value,
+    const char *unit_id
+) {
+    fossil_time_span_ticks_t t;
+    int k = fossil_span_unit_index(unit_id);
+
+    if (k < 0 || fossil_span_ticks_mul_ov(fossil_span_unit_ratio[k][FOSSIL_SPAN_UNIT_YS], value, &t))
+        return -1;
+
+    if (k == 0)
+        fossil_time_span_from_unit(span, value, unit_id);
+    else
+        fossil_time_span_from_ticks(span, t); /* carried into the field view */
+    return 0;
+}
+
+int fossil_time_span_from_unit_checked(
+    fossil_time_span_t *span,
+    int64_t value,
+    const char *unit_id
+) {
+    if (!span || !unit_id) return -1;
+
+    /* Any int32 count of any unit fits its field and the tick range */
+    if (value >= INT32_MIN && value <= INT32_MAX) {
+        fossil_time_span_clear(span);
+        return fossil_span_set_unit(span, value, unit_id);
+    }
+    return fossil_span_from_unit_wide(span, value, unit_id);
+}
+
+/* fossil_time_span_to_nanoseconds with every step checked */
+/* Below this many seconds no sub-second sum (|sub| < 2^52 ns) can leave int64 ns */
+#define FOSSIL_SPAN_NS_SAFE_SECS 9000000000LL
+
+/*
+ * Seconds and sub-second nanoseconds of a span within FOSSIL_SPAN_SAFE_DAYS.
+ * Neither sum can overflow: |secs| < 2^46, |sub| < 2^52.
+ */
+static inline void fossil_span_ns_parts(const fossil_time_span_t *span, int64_t days, int64_t *secs, int64_t *sub) {
+    uint64_t m = span->precision_mask;
+    int64_t s = days * 86400, f = 0;
+
+    if (m & FOSSIL_TIME_SPAN_PRECISION_HOURS)   s += (int64_t)span->hours * 3600;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_MINUTES) s += (int64_t)span->minutes * 60;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_SECONDS) s += span->seconds;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_MILLI)   f += (int64_t)span->milliseconds * 1000000LL;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_MICRO)   f += (int64_t)span->microseconds * 1000LL;
+    if (m & FOSSIL_TIME_SPAN_PRECISION_NANO)    f += span->nanoseconds;
+    *secs = s;
+    *sub = f;
+}
+
+/* Days, or 0 when the field is masked out; branch-free */
+static inline int64_t fossil_span_masked_days(const fossil_time_span_t *span) {
+    return span->days & ((int64_t)0 - (int64_t)(span->precision_mask & FOSSIL_TIME_SPAN_PRECISION_DAYS));
+}
+
+/*
+ * The common case of the total in nanoseconds: seconds well inside the
+ * range, so no sub-second sum can carry it out. Returns 0 when the span
+ * needs fossil_span_to_ns_exact instead; *out is then untouched.
+ */
+static inline int fossil_span_to_ns_fast(const fossil_time_span_t *span, int64_t *out) {
+    int64_t days = fossil_span_masked_days(span), secs, sub;
+
+    if ((uint64_t)days + (uint64_t)FOSSIL_SPAN_SAFE_DAYS > 2 * (uint64_t)FOSSIL_SPAN_SAFE_DAYS)
+        return 0;
+    fossil_span_ns_parts(span, days, &secs, &sub);
+    if ((uint64_t)secs + (uint64_t)FOSSIL_SPAN_NS_SAFE_SECS > 2 * (uint64_t)FOSSIL_SPAN_NS_SAFE_SECS)
+        return 0;
+    *out = secs * 1000000000LL + sub;
+    return 1;
+}
+
+/*
+ * Total nanoseconds range-checked on the exact result only, so fields
+ * that cancel (1 s and -1000 ms) never trip an intermediate overflow.
+ * Returns 0 and sets *out if it fits, else the sign of the overflow.
+ */
+static int fossil_span_to_ns_exact(const fossil_time_span_t *span, int64_t *out) {
+    int64_t days = fossil_span_masked_days(span), secs, sub;
+    fossil_time_span_ticks_t t;
+
+    /* Past the safe days no int32 field can pull the total back into range */
+    if (days >= -FOSSIL_SPAN_SAFE_DAYS && days <= FOSSIL_SPAN_SAFE_DAYS) {
+        fossil_span_ns_parts(span, days, &secs, &sub);
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef __int128 wide_t;
+        wide_t total = (wide_t)secs * 1000000000LL + sub;
+
+        if (total >= INT64_MIN && total <= INT64_MAX) {
+            *out = (int64_t)total;
+            return 0;
+        }
+        return total < 0 ? -1 : 1;
+#else
+        int64_t ns;
+
+        /* Give sub the sign of secs; then secs * 10^9 overflows only if the total does */
+        secs += sub / 1000000000LL;
+        sub %= 1000000000LL;
+        if (secs > 0 && sub < 0) { secs--; sub += 1000000000LL; }
+        if (secs < 0 && sub > 0) { secs++; sub -= 1000000000LL; }
+        if (!fossil_span_mul64_ov(secs, 1000000000LL, &ns) &&
+            !fossil_span_add64_ov(ns, sub, &ns)) {
+            *out = ns;
+            return 0;
+        }
+        return secs < 0 ? -1 : 1;
+#endif
+    }
+
+    /* Only the direction is needed from the exact total */
+    fossil_span_ticks_clamped(span, &t);
+    return t.hi < 0 ? -1 : 1;
+}
+
+int fossil_time_span_to_nanoseconds_checked(
+    const fossil_time_span_t *span,
+    int64_t *out
+) {
+    if (!span || !out) return -1;
+
+    if (fossil_span_to_ns_fast(span, out))
+        return 0;
+    return fossil_span_to_ns_exact(span, out) ? -1 : 0;
+}
+
+/* a + b or a - b, exact unless clamped to the tick range */
+static void fossil_span_add_saturating(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b,
+    int subtract
+) {
+    fossil_span_acc_t acc, other;
+    fossil_time_span_ticks_t r;
+    fossil_time_span_t fields;
+    int rc = subtract ? fossil_time_span_sub_checked(&fields, a, b)
+                      : fossil_time_span_add_checked(&fields, a, b);
+
+    /* Common case: the field-wise result, already known to be in range */
+    if (rc == 0 && fossil_span_ticks_safe(&fields)) {
+        *result = fields;
+        return;
+    }
+
+    if (fossil_span_ticks_safe(a) && fossil_span_ticks_safe(b)) {
+        fossil_time_span_ticks_t ta = fossil_time_span_to_ticks(a);
+        fossil_time_span_ticks_t tb = fossil_time_span_to_ticks(b);
+        r = subtract ? fossil_time_span_ticks_sub(ta, tb) : fossil_time_span_ticks_add(ta, tb);
+    } else {
+        fossil_span_acc_sum_spans(&acc, a, 1);
+        fossil_span_acc_sum_spans(&other, b, 1);
+        if (subtract)
+            fossil_span_acc_negate(&other);
+        fossil_span_acc_add(&acc, other.w[0], other.w[1], other.w[2]);
+        if (fossil_span_acc_ticks(&acc, &r))
+            r = fossil_span_acc_neg(&acc) ? fossil_span_ticks_min : fossil_span_ticks_max;
+    }
+    fossil_time_span_from_ticks(result, r);
+}
+
+void fossil_time_span_add_saturating(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+) {
+    if (!result || !a || !b) return;
+    fossil_span_add_saturating(result, a, b, 0);
+}
+
+void fossil_time_span_sub_saturating(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+) {
+    if (!result || !a || !b) return;
+    fossil_span_add_saturating(result, a, b, 1);
+}
+
+void fossil_time_span_scale_saturating(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t factor
+) {
+    fossil_time_span_ticks_t t, r;
+    fossil_time_span_t fields;
+    int ov;
+
+    if (!result || !span) return;
+
+    if (fossil_time_span_scale_checked(&fields, span, factor) == 0 && fossil_span_ticks_safe(&fields)) {
+        *result = fields;
+        return;
+    }
+
+    ov = fossil_span_ticks_clamped(span, &t);
+    ov |= fossil_span_ticks_mul_ov(t, factor, &r);
+    if (factor == 0)
+        ov = 0;
+    fossil_time_span_from_ticks(result, fossil_span_ticks_saturate(ov, (t.hi < 0) != (factor < 0), r));
+}
+
+int64_t fossil_time_span_to_nanoseconds_saturating(const fossil_time_span_t *span) {
+    int64_t ns = 0;
+    int rc;
+
+    if (!span) return 0;
+
+    if (fossil_span_to_ns_fast(span, &ns))
+        return ns;
+    rc = fossil_span_to_ns_exact(span, &ns);
+    return rc > 0 ? INT64_MAX : rc < 0 ? INT64_MIN : ns;
+}
+
+/* ======================================================
+ * Scaling and Division
+ * ====================================================== */
+
+static int fossil_span_ticks_is_zero(fossil_time_span_ticks_t t) {
+    return t.hi == 0 && t.lo == 0;
+}
+
+static double fossil_span_ticks_to_double(fossil_time_span_ticks_t t) {
+    return (double)t.hi * 18446744073709551616.0 + (double)t.lo;
+}
+
+/* The one quotient past the tick range: minimum / -1 */
+static int fossil_span_div_ov(fossil_time_span_ticks_t n, fossil_time_span_ticks_t d) {
+    return n.hi == INT64_MIN && n.lo == 0 && d.hi == -1 && d.lo == UINT64_MAX;
+}
+
+int fossil_time_span_ticks_mul(
+    fossil_time_span_ticks_t ticks,
+    int64_t factor,
+    fossil_time_span_ticks_t *out
+) {
+    fossil_time_span_ticks_t r;
+
+    if (!out || fossil_span_ticks_mul_ov(ticks, factor, &r))
+        return -1;
+    *out = r;
+    return 0;
+}
+
+int fossil_time_span_ticks_div(
+    fossil_time_span_ticks_t ticks,
+    int64_t divisor,
+    fossil_time_span_ticks_t *out
+) {
+    fossil_time_span_ticks_t d = ticks_from_i64(divisor), r;
+
+    if (!out || divisor == 0 || fossil_span_div_ov(ticks, d))
+        return -1;
+    ticks_sdivmod(ticks, d, out, &r);
+    return 0;
+}
+
+int fossil_time_span_ticks_divmod(
+    fossil_time_span_ticks_t a,
+    fossil_time_span_ticks_t b,
+    fossil_time_span_ticks_t *quotient,
+    fossil_time_span_ticks_t *remainder
+) {
+    fossil_time_span_ticks_t q, r;
+
+    if (fossil_span_ticks_is_zero(b) || fossil_span_div_ov(a, b))
+        return -1;
+
+    /* Floor: step a truncated quotient down when the signs disagree */
+    ticks_sdivmod(a, b, &q, &r);
+    if (!fossil_span_ticks_is_zero(r) && (r.hi < 0) != (b.hi < 0)) {
+        q = fossil_time_span_ticks_sub(q, ticks_from_i64(1));
+        r = fossil_time_span_ticks_add(r, b);
+    }
+    if (quotient)
+        *quotient = q;
+    if (remainder)
+        *remainder = r;
+    return 0;
+}
+
+int fossil_time_span_mul(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t factor
+) {
+    fossil_time_span_ticks_t r;
+
+    if (!result || !span) return -1;
+
+    if (fossil_time_span_ticks_mul(fossil_time_span_to_ticks(span), factor, &r) != 0)
+        return -1;
+    fossil_time_span_from_ticks(result, r);
+    return 0;
+}
+
+int fossil_time_span_div(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t divisor
+) {
+    fossil_time_span_ticks_t r;
+
+    if (!result || !span) return -1;
+
+    if (fossil_time_span_ticks_div(fossil_time_span_to_ticks(span), divisor, &r) != 0)
+        return -1;
+    fossil_time_span_from_ticks(result, r);
+    return 0;
+}
+
+int fossil_time_span_mod(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+) {
+    fossil_time_span_ticks_t r;
+
+    if (!result || !a || !b) return -1;
+
+    if (fossil_time_span_ticks_divmod(fossil_time_span_to_ticks(a), fossil_time_span_to_ticks(b), NULL, &r) != 0)
+        return -1;
+    fossil_time_span_from_ticks(result, r);
+    return 0;
+}
+
+double fossil_time_span_ratio(
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b
+) {
+    fossil_time_span_ticks_t ta, tb, q, r;
+
+    if (!a || !b) return 0.0;
+
+    ta = fossil_time_span_to_ticks(a);
+    tb = fossil_time_span_to_ticks(b);
+    if (fossil_span_ticks_is_zero(tb) || fossil_span_div_ov(ta, tb))
+        return fossil_span_ticks_to_double(ta) / fossil_span_ticks_to_double(tb);
+
+    /* Whole part exactly, so only the fraction is rounded */
+    ticks_sdivmod(ta, tb, &q, &r);
+    return fossil_span_ticks_to_double(q) + fossil_span_ticks_to_double(r) / fossil_span_ticks_to_double(tb);
+}
+
+int fossil_time_span_ratio_exact(
+    const fossil_time_span_t *a,
+    const fossil_time_span_t *b,
+    fossil_time_span_ticks_t *numerator,
+    fossil_time_span_ticks_t *denominator
+) {
+    fossil_time_span_ticks_t ta, tb, x, y, q, r;
+
+    if (!a || !b || !numerator || !denominator) return -1;
+
+    ta = fossil_time_span_to_ticks(a);
+    tb = fossil_time_span_to_ticks(b);
+    if (fossil_span_ticks_is_zero(tb))
+        return -1;
+
+    /* Euclid on the magnitudes */
+    x = ta.hi < 0 ? ticks_neg(ta) : ta;
+    y = tb.hi < 0 ? ticks_neg(tb) : tb;
+    while (!fossil_span_ticks_is_zero(y)) {
+        ticks_udivmod(x, y, &q, &r);
+        x = y;
+        y = r;
+    }
+    if (fossil_span_ticks_is_zero(x))
+        x = ticks_from_i64(1);
+
+    ticks_sdivmod(ta, x, numerator, &r);
+    ticks_sdivmod(tb, x, denominator, &r);
+
+    /* Keep the sign on the numerator; -2^127 has no positive counterpart */
+    if (denominator->hi < 0) {
+        if ((denominator->hi == INT64_MIN && denominator->lo == 0) ||
+            (numerator->hi == INT64_MIN && numerator->lo == 0))
+            return -1;
+        *numerator = ticks_neg(*numerator);
+        *denominator = ticks_neg(*denominator);
+    }
+    return 0;
+}
+
+/* ======================================================
+ * Rounding
+ * ====================================================== */
+
+enum {
+    FOSSIL_SPAN_ROUND_FLOOR,
+    FOSSIL_SPAN_ROUND_CEIL,
+    FOSSIL_SPAN_ROUND_NEAREST
+};
+
+/* multiple * unit_id as a positive step; nonzero if invalid */
+static int fossil_span_round_step(int64_t multiple, const char *unit_id, fossil_time_span_ticks_t *step) {
+    int k = fossil_span_unit_index(unit_id);
+
+    if (k < 0 || multiple <= 0)
+        return 1;
+    return fossil_span_ticks_mul_ov(fossil_span_unit_ratio[k][FOSSIL_SPAN_UNIT_YS], multiple, step);
+}
+
+/* t to a multiple of step > 0; nonzero if the result leaves the tick range */
+static int fossil_span_round_ticks(
+    fossil_time_span_ticks_t t,
+    fossil_time_span_ticks_t step,
+    int mode,
+    fossil_time_span_ticks_t *out
+) {
+    fossil_time_span_ticks_t r, down, up;
+    int up_wins;
+
+    /* Floored remainder, so r is in [0, step) whatever the sign of t */
+    fossil_time_span_ticks_divmod(t, step, NULL, &r);
+    if (r.hi == 0 && r.lo == 0) {
+        *out = t;
+        return 0;
+    }
+
+    if (mode == FOSSIL_SPAN_ROUND_NEAREST) {
+        /* r against step - r; a tie goes away from zero */
+        int c = fossil_time_span_ticks_cmp(r, fossil_time_span_ticks_sub(step, r));
+        up_wins = c > 0 || (c == 0 && t.hi >= 0);
+    } else {
+        up_wins = mode == FOSSIL_SPAN_ROUND_CEIL;
+    }
+
+    down = fossil_time_span_ticks_sub(t, r);
+    if (!up_wins) {
+        *out = down;
+        return down.hi > t.hi || (down.hi == t.hi && down.lo > t.lo);
+    }
+    up = fossil_time_span_ticks_add(down, step);
+    *out = up;
+    return up.hi < t.hi || (up.hi == t.hi && up.lo < t.lo);
+}
+
+static int fossil_span_round(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t multiple,
+    const char *unit_id,
+    int mode
+) {
+    fossil_time_span_ticks_t step, r;
+
+    if (!result || !span || fossil_span_round_step(multiple, unit_id, &step))
+        return -1;
+    if (fossil_span_round_ticks(fossil_time_span_to_ticks(span), step, mode, &r))
+        return -1;
+    fossil_time_span_from_ticks(result, r);
+    return 0;
+}
+
+static int fossil_span_round_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    int64_t multiple,
+    const char *unit_id,
+    fossil_time_span_t *out,
+    int mode
+) {
+    fossil_time_span_ticks_t step, r;
+    int failed = 0;
+
+    if ((count > 0 && (!spans || !out)) || fossil_span_round_step(multiple, unit_id, &step))
+        return -1;
+
+    /* The step is resolved once for the whole array */
+    for (size_t i = 0; i < count; i++) {
+        if (fossil_span_round_ticks(fossil_time_span_to_ticks(&spans[i]), step, mode, &r)) {
+            fossil_time_span_zero_fields(&out[i]);
+            failed++;
+        } else {
+            fossil_time_span_from_ticks(&out[i], r);
+        }
+    }
+    return failed;
+}
+
+int fossil_time_span_floor(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t multiple,
+    const char *unit_id
+) {
+    return fossil_span_round(result, span, multiple, unit_id, FOSSIL_SPAN_ROUND_FLOOR);
+}
+
+int fossil_time_span_ceil(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t multiple,
+    const char *unit_id
+) {
+    return fossil_span_round(result, span, multiple, unit_id, FOSSIL_SPAN_ROUND_CEIL);
+}
+
+int fossil_time_span_round(
+    fossil_time_span_t *result,
+    const fossil_time_span_t *span,
+    int64_t multiple,
+    const char *unit_id
+) {
+    return fossil_span_round(result, span, multiple, unit_id, FOSSIL_SPAN_ROUND_NEAREST);
+}
+
+int fossil_time_span_floor_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    int64_t multiple,
+    const char *unit_id,
+    fossil_time_span_t *out
+) {
+    return fossil_span_round_batch(spans, count, multiple, unit_id, out, FOSSIL_SPAN_ROUND_FLOOR);
+}
+
+int fossil_time_span_ceil_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    int64_t multiple,
+    const char *unit_id,
+    fossil_time_span_t *out
+) {
+    return fossil_span_round_batch(spans, count, multiple, unit_id, out, FOSSIL_SPAN_ROUND_CEIL);
+}
+
+int fossil_time_span_round_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    int64_t multiple,
+    const char *unit_id,
+    fossil_time_span_t *out
+) {
+    return fossil_span_round_batch(spans, count, multiple, unit_id, out, FOSSIL_SPAN_ROUND_NEAREST);
+}
+
+/* ======================================================
+ * Parsing
+ * ====================================================== */
+
+/* A unit as mant * 10^exp yoctoseconds, so every fraction digit down to
+ * the unit's own resolution scales exactly */
+typedef struct fossil_span_unit_t {
+    const char *name;
+    uint8_t len;
+    uint16_t mant;
+    uint8_t exp;
+} fossil_span_unit_t;
+
+static const fossil_span_unit_t fossil_span_compact_units[] = {
+    { "ns", 2, 1, 15 }, { "us", 2, 1, 18 }, { "\xC2\xB5s", 3, 1, 18 }, { "\xCE\xBCs", 3, 1, 18 },
+    { "ms", 2, 1, 21 }, { "s",  1, 1, 24 }, { "m",  1, 6, 25 },    { "h",  1, 36, 26 },
+    { "d",  1, 864, 26 }, { "w", 1, 6048, 26 },
+    { "ps", 2, 1, 12 }, { "fs", 2, 1, 9 },  { "as", 2, 1, 6 },     { "zs", 2, 1, 3 },
+    { "ys", 2, 1, 0 }
+};
+
+/* ISO 8601 designators; years and months have no fixed length */
+static const fossil_span_unit_t fossil_span_iso_date_units[] = {
+    { "W", 1, 6048, 26 }, { "D", 1, 864, 26 }
+};
+
+static const fossil_span_unit_t fossil_span_iso_time_units[] = {
+    { "H", 1, 36, 26 }, { "M", 1, 6, 25 }, { "S", 1, 1, 24 }
+};
+
+#define FOSSIL_SPAN_UNITS(t) (sizeof(t) / sizeof((t)[0]))
+
+static const fossil_span_unit_t *fossil_span_find_unit(
+    const fossil_span_unit_t *table,
+    size_t count,
+    const char *name,
+    size_t len
+) {
+    for (size_t i = 0; i < count; i++)
+        if (table[i].len == len && memcmp(table[i].name, name, len) == 0)
+            return &table[i];
+    return NULL;
+}
+
+/*
+ * Read "digits[.digits]" as an integer n with `*frac` digits after the
+ * point. Digits beyond 37 significant ones only survive if they are in
+ * the integer part, where they are an error. Returns the end, or NULL.
+ */
+static const char *fossil_span_read_number(
+    const char *p,
+    int comma,
+    fossil_time_span_ticks_t *n,
+    int *frac
+) {
+    int digits = 0, point = 0;
+
+    *n = ticks_from_i64(0);
+    *frac = 0;
+    for (;; p++) {
+        if (*p >= '0' && *p <= '9') {
+            digits++;
+            if (n->hi >= 0x0785EE10D5DA46D9LL) { /* n >= ~10^37 */
+                if (!point) return NULL;
+                continue;
+            }
+            ticks_umul_ov(*n, 10, n);
+            *n = fossil_time_span_ticks_add(*n, ticks_from_i64(*p - '0'));
+            *frac += point;
+        } else if ((*p == '.' || (comma && *p == ',')) && !point) {
+            point = 1;
+        } else {
+            break;
+        }
+    }
+    return digits ? p : NULL;
+}
+
+/* n with `frac` decimals, in units of mant * 10^exp ys; checked */
+static int fossil_span_apply_unit(
+    fossil_time_span_ticks_t n,
+    int frac,
+    const fossil_span_unit_t *unit,
+    fossil_time_span_ticks_t *acc
+) {
+    fossil_time_span_ticks_t v;
+
+    /* Digits finer than a yoctosecond are dropped */
+    for (; frac > unit->exp; frac--)
+        ticks_udiv_u32(&n, 10);
+
+    if (ticks_scale10_ov(n, unit->exp - frac, &v) || ticks_umul_ov(v, unit->mant, &v))
+        return -1;
+    *acc = fossil_time_span_ticks_add(*acc, v);
+    return acc->hi < 0 ? -1 : 0;
+}
+
+/* PnW / PnDTnHnMnS, fractions on any component */
+static int fossil_span_parse_iso(const char *p, fossil_time_span_ticks_t *acc) {
+    const fossil_span_unit_t *table = fossil_span_iso_date_units;
+    size_t count = FOSSIL_SPAN_UNITS(fossil_span_iso_date_units);
+    int parts = 0, time = 0;
+
+    while (*p) {
+        if (*p == 'T' && !time) {
+            time = 1;
+            table = fossil_span_iso_time_units;
+            count = FOSSIL_SPAN_UNITS(fossil_span_iso_time_units);
+            if (!*++p) return -1;
+            continue;
+        }
+
+        fossil_time_span_ticks_t n;
+        int frac;
+        p = fossil_span_read_number(p, 1, &n, &frac);
+        if (!p) return -1;
+
+        const fossil_span_unit_t *unit = fossil_span_find_unit(table, count, p, 1);
+        if (!unit || fossil_span_apply_unit(n, frac, unit, acc) != 0)
+            return -1;
+
+        /* Designators must come in order: drop the ones already used */
+        count -= (size_t)(unit - table) + 1;
+        table = unit + 1;
+        p++;
+        parts++;
+    }
+    return parts ? 0 : -1;
+}
+
+/* "1h30m", "250ms", "1.5us": number-unit pairs, any order */
+static int fossil_span_parse_compact(const char *p, fossil_time_span_ticks_t *acc) {
+    if (p[0] == '0' && p[1] == '\0')
+        return 0;
+
+    while (*p) {
+        fossil_time_span_ticks_t n;
+        int frac;
+        p = fossil_span_read_number(p, 0, &n, &frac);
+        if (!p) return -1;
+
+        const char *name = p;
+        while (*p && *p != '.' && (*p < '0' || *p > '9'))
+            p++;
+
+        const fossil_span_unit_t *unit = fossil_span_find_unit(
+            fossil_span_compact_units, FOSSIL_SPAN_UNITS(fossil_span_compact_units),
+            name, (size_t)(p - name));
+        if (!unit || fossil_span_apply_unit(n, frac, unit, acc) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int fossil_span_parse_ticks(const char *text, fossil_time_span_ticks_t *out) {
+    const char *p = text;
+    int neg = 0;
+
+    *out = ticks_from_i64(0);
+    if (*p == '+' || *p == '-')
+        neg = *p++ == '-';
+    if (!*p)
+        return -1;
+
+    if ((*p == 'P' ? fossil_span_parse_iso(p + 1, out) : fossil_span_parse_compact(p, out)) != 0)
+        return -1;
+    if (neg)
+        *out = ticks_neg(*out);
+    return 0;
+}
+
+int fossil_time_span_parse(const char *text, fossil_time_span_t *out) {
+    fossil_time_span_ticks_t ticks;
+
+    if (!text || !out)
+        return -1;
+    if (fossil_span_parse_ticks(text, &ticks) != 0) {
+        fossil_time_span_zero_fields(out);
+        return -1;
+    }
+    fossil_time_span_from_ticks(out, ticks);
+    return 0;
+}
+
+int fossil_time_span_parse_batch(
+    const char *const *texts,
+    size_t count,
+    fossil_time_span_t *out
+) {
+    int failed = 0;
+
+    if (count > 0 && (!texts || !out))
+        return -1;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!texts[i]) {
+            fossil_time_span_zero_fields(&out[i]);
+            failed++;
+        } else {
+            failed += fossil_time_span_parse(texts[i], &out[i]) != 0;
+        }
+    }
+    return failed;
+}
+
+/* ======================================================
+ * Formatting
+ * ====================================================== */
+
+enum {
+    FOSSIL_SPAN_STYLE_SHORT,
+    FOSSIL_SPAN_STYLE_HUMAN,
+    FOSSIL_SPAN_STYLE_ISO,
+    FOSSIL_SPAN_STYLE_COMPACT,
+    FOSSIL_SPAN_STYLE_PRECISE
+};
+
+/* Longest text any style can produce, terminator included */
+#define FOSSIL_SPAN_MAX_TEXT 128
+
+static const char fossil_span_digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const char *const fossil_span_sub_units[8] = {
+    "ms", "us", "ns", "ps", "fs", "as", "zs", "ys"
+};
+
+/* A span's magnitude split for printing: whole seconds and 24 digits of
+ * fraction, ms first */
+typedef struct {
+    int neg;
+    uint64_t secs;
+    char frac[24];
+    size_t frac_len; /* without trailing zeros */
+} fossil_span_text_t;
+
+static int fossil_span_style(const char *format_id) {
+    if (unit_equals(format_id, "short"))   return FOSSIL_SPAN_STYLE_SHORT;
+    if (unit_equals(format_id, "human"))   return FOSSIL_SPAN_STYLE_HUMAN;
+    if (unit_equals(format_id, "iso"))     return FOSSIL_SPAN_STYLE_ISO;
+    if (unit_equals(format_id, "compact")) return FOSSIL_SPAN_STYLE_COMPACT;
+    if (unit_equals(format_id, "precise")) return FOSSIL_SPAN_STYLE_PRECISE;
+    return -1;
+}
+
+/* Exactly width digits of v, two per table copy */
+static void fossil_span_put_fixed(char *p, uint32_t v, int width) {
+    while (width >= 2) {
+        width -= 2;
+        memcpy(p + width, fossil_span_digit_pairs + (v % 100) * 2, 2);
+        v /= 100;
+    }
+    if (width)
+        p[0] = (char)('0' + v % 10);
+}
+
+static void fossil_span_text_init(fossil_span_text_t *t, fossil_time_span_ticks_t ticks) {
+    fossil_time_span_ticks_t m;
+    uint32_t ys, fs, ns;
+
+    t->neg = ticks.hi < 0;
+    m = t->neg ? ticks_neg(ticks) : ticks;
+    ys = ticks_udiv_u32(&m, 1000000000U); /* as, zs, ys */
+    fs = ticks_udiv_u32(&m, 1000000U);    /* ps, fs */
+    ns = ticks_udiv_u32(&m, 1000000000U); /* ms, us, ns */
+    t->secs = m.lo;
+
+    fossil_span_put_fixed(t->frac, ns, 9);
+    fossil_span_put_fixed(t->frac + 9, fs, 6);
+    fossil_span_put_fixed(t->frac + 15, ys, 9);
+
+    t->frac_len = 24;
+    while (t->frac_len > 0 && t->frac[t->frac_len - 1] == '0')
+        t->frac_len--;
+}
+
+/*
+ * Writers append at out + n and return the new length. With out == NULL they
+ * only count, so a layout run once without a buffer gives the exact length.
+ */
+static size_t fossil_span_put(char *out, size_t n, const char *s, size_t len) {
+    if (out)
+        memcpy(out + n, s, len);
+    return n + len;
+}
+
+static size_t fossil_span_put_u64(char *out, size_t n, uint64_t v) {
+    size_t len = 1;
+    while (len < 20 && v >= fossil_span_pow10[len])
+        len++;
+
+    if (out) {
+        char *p = out + n + len;
+        while (v >= 100) {
+            p -= 2;
+            memcpy(p, fossil_span_digit_pairs + (v % 100) * 2, 2);
+            v /= 100;
+        }
+        if (v >= 10) {
+            p -= 2;
+            memcpy(p, fossil_span_digit_pairs + v * 2, 2);
+        } else {
+            *--p = (char)('0' + v);
+        }
+    }
+    return n + len;
+}
+
+static size_t fossil_span_put_i64(char *out, size_t n, int64_t v) {
+    if (v < 0)
+        n = fossil_span_put(out, n, "-", 1);
+    return fossil_span_put_u64(out, n, v < 0 ? 0 - (uint64_t)v : (uint64_t)v);
+}
+
+/* Seconds with the trimmed fraction, as "4" or "4.005" */
+static size_t fossil_span_put_seconds(char *out, size_t n, uint64_t s, const fossil_span_text_t *t) {
+    n = fossil_span_put_u64(out, n, s);
+    if (t->frac_len) {
+        n = fossil_span_put(out, n, ".", 1);
+        n = fossil_span_put(out, n, t->frac, t->frac_len);
+    }
+    return n;
+}
+
+/* "P1DT2H3M4.005S"; a zero span is "PT0S" */
+static size_t fossil_span_layout_iso(char *out, const fossil_span_text_t *t) {
+    uint64_t days = t->secs / 86400, rem = t->secs % 86400;
+    uint64_t h = rem / 3600, m = rem / 60 % 60, s = rem % 60;
+    size_t n = 0;
+
+    if (t->neg)
+        n = fossil_span_put(out, n, "-", 1);
+    n = fossil_span_put(out, n, "P", 1);
+    if (days) {
+        n = fossil_span_put_u64(out, n, days);
+        n = fossil_span_put(out, n, "D", 1);
+    }
+    if (rem || t->frac_len || !days) {
+        n = fossil_span_put(out, n, "T", 1);
+        if (h) {
+            n = fossil_span_put_u64(out, n, h);
+            n = fossil_span_put(out, n, "H", 1);
+        }
+        if (m) {
+            n = fossil_span_put_u64(out, n, m);
+            n = fossil_span_put(out, n, "M", 1);
+        }
+        if (s || t->frac_len || (!h && !m)) {
+            n = fossil_span_put_seconds(out, n, s, t);
+            n = fossil_span_put(out, n, "S", 1);
+        }
+    }
+    return n;
+}
+
+/*
+ * Go's time.Duration notation: "26h3m4.005s", "1m0s", and below one second
+ * the largest unit that keeps a non-zero integer part ("1.5ms", "250ns").
+ * Hours are the largest unit so the text stays readable by Go.
+ */
+static size_t fossil_span_layout_compact(char *out, const fossil_span_text_t *t) {
+    size_t n = 0;
+
+    if (t->secs == 0 && t->frac_len == 0)
+        return fossil_span_put(out, n, "0s", 2);
+    if (t->neg)
+        n = fossil_span_put(out, n, "-", 1);
+
+    if (t->secs == 0) {
+        size_t i = 0, u, end;
+        while (t->frac[i] == '0')
+            i++;
+        u = i / 3;
+        end = u * 3 + 3;
+        n = fossil_span_put(out, n, t->frac + i, end - i);
+        if (t->frac_len > end) {
+            n = fossil_span_put(out, n, ".", 1);
+            n = fossil_span_put(out, n, t->frac + end, t->frac_len - end);
+        }
+        return fossil_span_put(out, n, fossil_span_sub_units[u], 2);
+    }
+
+    uint64_t h = t->secs / 3600, m = t->secs / 60 % 60, s = t->secs % 60;
+    if (h) {
+        n = fossil_span_put_u64(out, n, h);
+        n = fossil_span_put(out, n, "h", 1);
+    }
+    if (h || m) {
+        n = fossil_span_put_u64(out, n, m);
+        n = fossil_span_put(out, n, "m", 1);
+    }
+    n = fossil_span_put_seconds(out, n, s, t);
+    return fossil_span_put(out, n, "s", 1);
+}
+
+/* Total seconds with at least nine fraction digits: "5.000000000 s" */
+static size_t fossil_span_layout_precise(char *out, const fossil_span_text_t *t) {
+    size_t n = 0;
+    size_t digits = t->frac_len > 9 ? t->frac_len : 9;
+
+    if (t->neg)
+        n = fossil_span_put(out, n, "-", 1);
+    n = fossil_span_put_u64(out, n, t->secs);
+    n = fossil_span_put(out, n, ".", 1);
+    n = fossil_span_put(out, n, t->frac, digits);
+    return fossil_span_put(out, n, " s", 2);
+}
+
+/* The field styles print the stored fields as they are */
+static size_t fossil_span_layout_fields(char *out, const fossil_time_span_t *span, int style) {
+    size_t n = 0;
+
+    if (style == FOSSIL_SPAN_STYLE_SHORT) {
+        n = fossil_span_put_i64(out, n, span->days);
+        n = fossil_span_put(out, n, "d ", 2);
+        n = fossil_span_put_i64(out, n, span->hours);
+        n = fossil_span_put(out, n, "h ", 2);
+        n = fossil_span_put_i64(out, n, span->minutes);
+        n = fossil_span_put(out, n, "m ", 2);
+        n = fossil_span_put_i64(out, n, span->seconds);
+        return fossil_span_put(out, n, "s", 1);
+    }
+
+    n = fossil_span_put_i64(out, n, span->days);
+    n = fossil_span_put(out, n, " days, ", 7);
+    n = fossil_span_put_i64(out, n, span->hours);
+    n = fossil_span_put(out, n, " hours, ", 8);
+    n = fossil_span_put_i64(out, n, span->minutes);
+    n = fossil_span_put(out, n, " minutes, ", 10);
+    n = fossil_span_put_i64(out, n, span->seconds);
+    return fossil_span_put(out, n, " seconds", 8);
+}
+
+static size_t fossil_span_layout(
+    char *out,
+    const fossil_time_span_t *span,
+    const fossil_span_text_t *t,
+    int style
+) {
+    switch (style) {
+        case FOSSIL_SPAN_STYLE_ISO:     return fossil_span_layout_iso(out, t);
+        case FOSSIL_SPAN_STYLE_COMPACT: return fossil_span_layout_compact(out, t);
+        case FOSSIL_SPAN_STYLE_PRECISE: return fossil_span_layout_precise(out, t);
+        default:                        return fossil_span_layout_fields(out, span, style);
+    }
+}
+
+/* The total-based styles need the exact ticks; -1 past the tick range */
+static int fossil_span_text_prepare(const fossil_time_span_t *span, fossil_span_text_t *t, int style) {
+    fossil_time_span_ticks_t ticks;
+
+    if (style < FOSSIL_SPAN_STYLE_ISO)
+        return 0;
+    if (fossil_span_ticks_clamped(span, &ticks))
+        return -1;
+    fossil_span_text_init(t, ticks);
+    return 0;
+}
+
+/* Measure, then write straight into the buffer when the text fits */
+static int fossil_span_emit(
+    const fossil_time_span_t *span,
+    char *buffer,
+    size_t buffer_size,
+    int style
+) {
+    fossil_span_text_t t;
+    size_t len;
+
+    if (fossil_span_text_prepare(span, &t, style) != 0) {
+        buffer[0] = '\0';
+        return -1;
+    }
+
+    len = fossil_span_layout(NULL, span, &t, style);
+    if (len < buffer_size) {
+        fossil_span_layout(buffer, span, &t, style);
+        buffer[len] = '\0';
+    } else {
+        char text[FOSSIL_SPAN_MAX_TEXT];
+        fossil_span_layout(text, span, &t, style);
+        memcpy(buffer, text, buffer_size - 1);
+        buffer[buffer_size - 1] = '\0';
+    }
+    return (int)len;
+}
+
+int fossil_time_span_format(
+    const fossil_time_span_t *span,
+    char *buffer,
+    size_t buffer_size,
+    const char *format_id
+) {
+    int style;
+
+    if (!span || !buffer || buffer_size == 0 || !format_id)
+        return -1;
+
+    style = fossil_span_style(format_id);
+    if (style < 0)
+        return -1;
+    return fossil_span_emit(span, buffer, buffer_size, style);
+}
+
+int fossil_time_span_format_length(
+    const fossil_time_span_t *span,
+    const char *format_id
+) {
+    fossil_span_text_t t;
+    int style;
+
+    if (!span || !format_id)
+        return -1;
+
+    style = fossil_span_style(format_id);
+    if (style < 0 || fossil_span_text_prepare(span, &t, style) != 0)
+        return -1;
+    return (int)fossil_span_layout(NULL, span, &t, style);
+}
+
+int fossil_time_span_format_batch(
+    const fossil_time_span_t *spans,
+    size_t count,
+    char *buffer,
+    size_t stride,
+    const char *format_id
+) {
+    int style, rc = 0;
+
+    if (!format_id)
+        return -1;
+    style = fossil_span_style(format_id);
+    if (style < 0 || (count > 0 && (!spans || !buffer || stride == 0)))
+        return -1;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (fossil_span_emit(&spans[i], buffer + i * stride, stride, style) < 0)
+            rc = -1;
+    }
+
+    return rc;
 }
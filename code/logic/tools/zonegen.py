@@ -0,0 +1,159 @@
+import argparse
+import os
+import struct
+import sys
+
+# Directories and files under a zoneinfo tree that are not zones
+SKIP_DIRS = {"posix", "right"}
+SKIP_FILES = {"localtime", "posixrules", "Factory", "leapseconds", "leap-seconds.list",
+              "tzdata.zi", "zone.tab", "zone1970.tab", "zonenow.tab", "iso3166.tab", "SECURITY"}
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return (value << 1) ^ (value >> 63)
+
+
+def read_tzif(path):
+    """Return (transitions, type indices, types, footer) from the 64-bit block."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < 44 or data[:4] != b"TZif" or data[4] < ord("2"):
+        return None
+
+    def counts(at):
+        return struct.unpack(">6I", data[at + 20:at + 44])
+
+    isut, isstd, leap, timecnt, typecnt, charcnt = counts(0)
+    at = 44 + timecnt * 5 + typecnt * 6 + charcnt + leap * 8 + isstd + isut
+    isut, isstd, leap, timecnt, typecnt, charcnt = counts(at)
+    at += 44
+
+    times = list(struct.unpack(">%dq" % timecnt, data[at:at + timecnt * 8]))
+    at += timecnt * 8
+    indices = list(data[at:at + timecnt])
+    at += timecnt
+    types = []
+    for i in range(typecnt):
+        utoff, isdst, idx = struct.unpack(">iBB", data[at + i * 6:at + i * 6 + 6])
+        types.append((utoff, isdst, idx))
+    at += typecnt * 6
+    chars = data[at:at + charcnt]
+    at += charcnt + leap * 12 + isstd + isut
+
+    footer = data[at:].split(b"\n")[1] if data[at:at + 1] == b"\n" else b""
+    abbrevs = [chars[idx:chars.index(b"\0", idx)].decode("ascii") for _, _, idx in types]
+    return times, indices, [(t[0], t[1], a) for t, a in zip(types, abbrevs)], footer.decode("ascii")
+
+
+def list_zones(directory):
+    zones = []
+    for root, dirs, files in os.walk(directory):
+        dirs[:] = [d for d in dirs if d not in SKIP_DIRS]
+        for name in files:
+            if name in SKIP_FILES or name.endswith(".tab"):
+                continue
+            zones.append(os.path.relpath(os.path.join(root, name), directory).replace(os.sep, "/"))
+    return sorted(zones)
+
+
+class BlobWriter:
+    def __init__(self):
+        self.strings = bytearray()
+        self.string_at = {}
+        self.rules = []
+        self.rule_at = {}
+        self.records = bytearray()
+        self.record_at = {}
+        self.index = []
+
+    def string(self, text):
+        if text not in self.string_at:
+            self.string_at[text] = len(self.strings)
+            self.strings += text.encode("ascii") + b"\0"
+        return self.string_at[text]
+
+    def rule(self, footer):
+        if not footer:
+            return 0xFFFF
+        if footer not in self.rule_at:
+            self.rule_at[footer] = len(self.rules)
+            self.rules.append(self.string(footer))
+        return self.rule_at[footer]
+
+    def record(self, times, indices, types):
+        out = bytearray(varint(len(types)))
+        for utoff, isdst, abbrev in types:
+            out += varint(zigzag(utoff)) + bytes([isdst]) + varint(self.string(abbrev))
+        out += varint(len(times))
+        if times:
+            out += varint(zigzag(times[0]) & 0xFFFFFFFFFFFFFFFF)
+            for prev, cur in zip(times, times[1:]):
+                out += varint(cur - prev)
+            out += bytes(indices)
+        key = bytes(out)
+        # Links (e.g. Europe/Berlin and Arctic/Longyearbyen) share one record
+        if key not in self.record_at:
+            self.record_at[key] = len(self.records)
+            self.records += key
+        return self.record_at[key]
+
+    def add(self, name, tzif):
+        times, indices, types, footer = tzif
+        self.index.append((name, self.string(name), self.record(times, indices, types), self.rule(footer)))
+
+    def blob(self):
+        self.index.sort()
+        rules_at = 20 + len(self.index) * 12
+        strings_at = rules_at + len(self.rules) * 4
+        zones_at = strings_at + len(self.strings)
+        out = bytearray(b"FZDB")
+        out += struct.pack("<4I", len(self.index), len(self.rules), strings_at, zones_at)
+        for _, name, record, rule in self.index:
+            out += struct.pack("<IIHH", name, record, rule, 0)
+        for rule in self.rules:
+            out += struct.pack("<I", rule)
+        return bytes(out + self.strings + self.records)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the embedded Fossil Time zone database")
+    parser.add_argument("--dir", default="/usr/share/zoneinfo")
+    parser.add_argument("--output", required=True)
+    parser.add_argument("zones", nargs="+", help="IANA zone names, or 'all'")
+    args = parser.parse_args()
+
+    names = list_zones(args.dir) if args.zones == ["all"] else args.zones
+    writer = BlobWriter()
+    for name in names:
+        tzif = read_tzif(os.path.join(args.dir, name))
+        if tzif is None:
+            if args.zones != ["all"]:
+                sys.exit("zonegen: %s is not a version 2+ TZif file" % name)
+            continue
+        writer.add(name, tzif)
+
+    blob = writer.blob()
+    with open(args.output, "w") as f:
+        f.write("/* Generated by zonegen.py from %s; do not edit */\n" % args.dir)
+        f.write("#include <stddef.h>\n\n")
+        f.write("const size_t fossil_time_zone_embedded_size = %d;\n" % len(blob))
+        f.write("const unsigned char fossil_time_zone_embedded[] = {\n")
+        for i in range(0, len(blob), 16):
+            f.write("    " + ", ".join("0x%02x" % b for b in blob[i:i + 16]) + ",\n")
+        f.write("};\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,1532 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/time/zone.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  include <sched.h>
+#endif
+
+/* ======================================================
+ * Internal helpers
+ * ====================================================== */
+
+#define FOSSIL_ZONE_DEFAULT_DIR "/usr/share/zoneinfo"
+#define FOSSIL_ZONE_MAX_PATH 512
+#define FOSSIL_ZONE_MAX_NAME 128
+#define FOSSIL_ZONE_MAX_ABBR 16
+#define FOSSIL_ZONE_MAX_FOOTER 128
+#define FOSSIL_ZONE_HEADER_SIZE 44
+#define FOSSIL_ZONE_NS_PER_SEC 1000000000LL
+#define FOSSIL_ZONE_CACHE_SLOTS 8
+#define FOSSIL_ZONE_DB_HEADER_SIZE 20
+#define FOSSIL_ZONE_DB_ENTRY_SIZE 12
+#define FOSSIL_ZONE_DB_NO_RULE 0xFFFF
+#define FOSSIL_ZONE_REGISTRY_SLOTS 1024  /* power of two, well above the IANA zone count */
+
+/* Offsets of adjacent periods differ by less than two days, so a wall
+ * time this far inside a period cannot also belong to a neighbour */
+#define FOSSIL_ZONE_RESOLVE_MARGIN (2 * 86400LL)
+
+#if defined(_MSC_VER)
+#  define FOSSIL_ZONE_TLS __declspec(thread)
+#  define FOSSIL_ZONE_INC(p)          InterlockedIncrement(p)
+#  define FOSSIL_ZONE_DEC(p)          InterlockedDecrement(p)
+#  define FOSSIL_ZONE_LOAD(p)         InterlockedCompareExchange((p), 0, 0)
+#  define FOSSIL_ZONE_LOAD_PTR(p)     InterlockedCompareExchangePointer((PVOID volatile *)(p), NULL, NULL)
+#  define FOSSIL_ZONE_XCHG_PTR(p, v)  InterlockedExchangePointer((PVOID volatile *)(p), (v))
+#  define FOSSIL_ZONE_CAS_PTR(p, e, v) \
+        (InterlockedCompareExchangePointer((PVOID volatile *)(p), (v), (e)) == (PVOID)(e))
+#  define FOSSIL_ZONE_YIELD()         SwitchToThread()
+#else
+#  define FOSSIL_ZONE_TLS _Thread_local
+#  define FOSSIL_ZONE_INC(p)          __atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST)
+#  define FOSSIL_ZONE_DEC(p)          __atomic_sub_fetch((p), 1, __ATOMIC_SEQ_CST)
+#  define FOSSIL_ZONE_LOAD(p)         __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#  define FOSSIL_ZONE_LOAD_PTR(p)     __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#  define FOSSIL_ZONE_XCHG_PTR(p, v)  __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#  define FOSSIL_ZONE_CAS_PTR(p, e, v) \
+        __atomic_compare_exchange_n((p), &(e), (v), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#  define FOSSIL_ZONE_YIELD()         sched_yield()
+#endif
+
+/* A date rule of a POSIX TZ string: Jn, n or Mm.w.d, plus a local time */
+typedef struct fossil_zone_rule_date_t {
+    char    kind;       /* 'J' (1-365, Feb 29 never counted), 'N' (0-365), 'M' */
+    int     month;      /* 'M' only */
+    int     week;       /* 'M' only, 5 = last */
+    int     day;        /* weekday for 'M', day number for 'J' and 'N' */
+    int32_t time;       /* seconds after local midnight, may be negative */
+} fossil_zone_rule_date_t;
+
+/* The TZif footer: a POSIX TZ string for instants after the last transition */
+typedef struct fossil_zone_rule_t {
+    int     present;
+    int     has_dst;
+    int32_t std_offset;              /* seconds east of UTC */
+    int32_t dst_offset;
+    char    std_abbr[FOSSIL_ZONE_MAX_ABBR];
+    char    dst_abbr[FOSSIL_ZONE_MAX_ABBR];
+    fossil_zone_rule_date_t start;   /* in local standard time */
+    fossil_zone_rule_date_t end;     /* in local daylight time */
+} fossil_zone_rule_t;
+
+struct fossil_time_zone_t {
+    char name[FOSSIL_ZONE_MAX_NAME];
+    uint64_t id;                     /* unique per opened zone, never reused */
+    volatile long refs;              /* the only field written after load */
+
+    /* Backing TZif bytes: a read-only mapping or caller memory */
+    const unsigned char *data;
+    size_t size;
+    int mapped;
+    int owned;                       /* data was decoded into a heap buffer */
+
+    /* Views into data */
+    uint32_t timecnt;
+    uint32_t typecnt;
+    uint32_t charcnt;
+    uint32_t time_size;              /* 4 (version 1) or 8 bytes */
+    const unsigned char *times;      /* big-endian transition times */
+    const unsigned char *indices;    /* type index per transition */
+    const unsigned char *types;      /* 6-byte ttinfo records */
+    const char *abbrevs;
+
+    fossil_zone_rule_t rule;
+};
+
+/*
+ * Per-thread cache of the last period seen for each zone. Entries are
+ * keyed by zone id rather than address, so a closed zone's entries can
+ * never match a zone later allocated at the same address.
+ */
+typedef struct fossil_zone_cache_t {
+    uint64_t id;
+    fossil_time_zone_period_t period;
+} fossil_zone_cache_t;
+
+#if defined(FOSSIL_TIME_EMBEDDED_ZONES)
+/* Generated by tools/zonegen.py when the embedded_zones option is set */
+extern const unsigned char fossil_time_zone_embedded[];
+extern const size_t fossil_time_zone_embedded_size;
+#endif
+
+/*
+ * A name in the shared registry. Entries are published once and never
+ * removed; a reload swaps `current` and retires the old version only after
+ * every fossil_time_zone_get that might have loaded it holds a reference.
+ */
+typedef struct fossil_zone_entry_t {
+    char name[FOSSIL_ZONE_MAX_NAME];
+    fossil_time_zone_t *current;     /* holds one reference for the registry */
+    volatile long readers;           /* gets between loading current and retaining it */
+} fossil_zone_entry_t;
+
+static char g_directory[FOSSIL_ZONE_MAX_PATH];
+static int g_directory_set = 0;
+static uint64_t g_next_id = 0;
+static FOSSIL_ZONE_TLS fossil_zone_cache_t g_cache[FOSSIL_ZONE_CACHE_SLOTS];
+static fossil_zone_entry_t *g_registry[FOSSIL_ZONE_REGISTRY_SLOTS];
+
+static uint32_t load_be32(const unsigned char *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+}
+
+static int64_t load_be64(const unsigned char *p) {
+    return (int64_t)(((uint64_t)load_be32(p) << 32) | (uint64_t)load_be32(p + 4));
+}
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+    return q;
+}
+
+static int is_leap(int64_t year) {
+    return ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0));
+}
+
+static int days_in_month(int64_t year, int month) {
+    static const int days[] = {
+        31,28,31,30,31,30,31,31,30,31,30,31
+    };
+    if (month == 2 && is_leap(year)) return 29;
+    return days[month - 1];
+}
+
+static int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+static int64_t year_from_days(int64_t z) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    return (int64_t)yoe + era * 400 + (mp >= 10);
+}
+
+static uint64_t next_zone_id(void) {
+#if defined(_MSC_VER)
+    return (uint64_t)InterlockedIncrement64((volatile LONG64 *)&g_next_id);
+#else
+    return __atomic_add_fetch(&g_next_id, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+static int64_t load_time(const fossil_time_zone_t *zone, uint32_t i) {
+    if (zone->time_size == 8)
+        return load_be64(zone->times + (size_t)i * 8);
+    return (int64_t)(int32_t)load_be32(zone->times + (size_t)i * 4);
+}
+
+/* ======================================================
+ * Internal: POSIX TZ footer rules
+ * ====================================================== */
+
+static const char *parse_abbr(const char *s, char *out) {
+    size_t n = 0;
+
+    if (*s == '<') {
+        for (s++; *s && *s != '>'; s++) {
+            if (n + 1 >= FOSSIL_ZONE_MAX_ABBR) return NULL;
+            out[n++] = *s;
+        }
+        if (*s++ != '>') return NULL;
+    } else {
+        for (; isalpha((unsigned char)*s); s++) {
+            if (n + 1 >= FOSSIL_ZONE_MAX_ABBR) return NULL;
+            out[n++] = *s;
+        }
+    }
+
+    out[n] = '\0';
+    return n >= 3 ? s : NULL;
+}
+
+/* [+-]hh[:mm[:ss]] with hours up to max_hours */
+static const char *parse_hms(const char *s, int max_hours, int32_t *out) {
+    int32_t sign = 1;
+    int32_t part[3] = {0, 0, 0};
+
+    if (*s == '+' || *s == '-') {
+        sign = (*s == '-') ? -1 : 1;
+        s++;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        int digits = 0;
+        if (i > 0) {
+            if (*s != ':') break;
+            s++;
+        }
+        while (isdigit((unsigned char)*s) && digits < 3) {
+            part[i] = part[i] * 10 + (*s++ - '0');
+            digits++;
+        }
+        if (digits == 0) return NULL;
+    }
+
+    if (part[0] > max_hours || part[1] > 59 || part[2] > 59)
+        return NULL;
+
+    *out = sign * (part[0] * 3600 + part[1] * 60 + part[2]);
+    return s;
+}
+
+static const char *parse_number(const char *s, int lo, int hi, int *out) {
+    int v = 0, digits = 0;
+    while (isdigit((unsigned char)*s) && digits < 4) {
+        v = v * 10 + (*s++ - '0');
+        digits++;
+    }
+    if (digits == 0 || v < lo || v > hi) return NULL;
+    *out = v;
+    return s;
+}
+
+static const char *parse_rule_date(const char *s, fossil_zone_rule_date_t *d) {
+    memset(d, 0, sizeof(*d));
+
+    if (*s == 'M') {
+        d->kind = 'M';
+        if (!(s = parse_number(s + 1, 1, 12, &d->month)) || *s++ != '.') return NULL;
+        if (!(s = parse_number(s, 1, 5, &d->week)) || *s++ != '.') return NULL;
+        if (!(s = parse_number(s, 0, 6, &d->day))) return NULL;
+    } else if (*s == 'J') {
+        d->kind = 'J';
+        if (!(s = parse_number(s + 1, 1, 365, &d->day))) return NULL;
+    } else {
+        d->kind = 'N';
+        if (!(s = parse_number(s, 0, 365, &d->day))) return NULL;
+    }
+
+    d->time = 2 * 3600;
+    if (*s == '/' && !(s = parse_hms(s + 1, 167, &d->time)))
+        return NULL;
+    return s;
+}
+
+static int parse_rule(const char *text, size_t len, fossil_zone_rule_t *rule) {
+    char buf[FOSSIL_ZONE_MAX_FOOTER];
+    const char *s = buf;
+    int32_t off;
+
+    memset(rule, 0, sizeof(*rule));
+    if (len == 0)
+        return 0;
+    if (len >= sizeof(buf))
+        return -1;
+    memcpy(buf, text, len);
+    buf[len] = '\0';
+
+    /* POSIX offsets count west of UTC */
+    if (!(s = parse_abbr(s, rule->std_abbr)) || !(s = parse_hms(s, 24, &off)))
+        return -1;
+    rule->std_offset = -off;
+    rule->dst_offset = rule->std_offset;
+
+    if (*s) {
+        if (!(s = parse_abbr(s, rule->dst_abbr)))
+            return -1;
+        rule->dst_offset = rule->std_offset + 3600;
+        if (*s != ',') {
+            if (!(s = parse_hms(s, 24, &off)))
+                return -1;
+            rule->dst_offset = -off;
+        }
+        if (*s++ != ',' || !(s = parse_rule_date(s, &rule->start)) ||
+            *s++ != ',' || !(s = parse_rule_date(s, &rule->end)))
+            return -1;
+        rule->has_dst = 1;
+    }
+
+    if (*s)
+        return -1;
+    rule->present = 1;
+    return 0;
+}
+
+/* Days since the epoch of the day a rule date falls on in a year */
+static int64_t rule_day(const fossil_zone_rule_date_t *d, int64_t year) {
+    int64_t jan1 = days_from_civil(year, 1, 1);
+
+    if (d->kind == 'J')
+        return jan1 + d->day - 1 + (is_leap(year) && d->day >= 60);
+    if (d->kind == 'N')
+        return jan1 + d->day;
+
+    int64_t first = days_from_civil(year, (unsigned)d->month, 1);
+    int64_t wd = first - floor_div(first + 4, 7) * 7 + 4;     /* 0 = Sunday */
+    int64_t day = (d->day - wd + 7) % 7 + (int64_t)(d->week - 1) * 7;
+    while (day >= days_in_month(year, d->month))
+        day -= 7;
+    return first + day;
+}
+
+/* UTC second of a rule transition, given the offset in force before it */
+static int64_t rule_instant(const fossil_zone_rule_date_t *d, int64_t year, int32_t before) {
+    return rule_day(d, year) * 86400 + d->time - before;
+}
+
+static void rule_period(
+    const fossil_zone_rule_t *rule,
+    int daylight,
+    int64_t begin,
+    int64_t end,
+    fossil_time_zone_period_t *out
+) {
+    out->begin = begin;
+    out->end = end;
+    out->offset_sec = daylight ? rule->dst_offset : rule->std_offset;
+    out->is_dst = daylight;
+    out->abbrev = daylight ? rule->dst_abbr : rule->std_abbr;
+}
+
+static void rule_lookup(const fossil_zone_rule_t *rule, int64_t t, fossil_time_zone_period_t *out) {
+    if (!rule->has_dst) {
+        rule_period(rule, 0, INT64_MIN, INT64_MAX, out);
+        return;
+    }
+
+    const fossil_zone_rule_date_t *sd = &rule->start;
+    const fossil_zone_rule_date_t *ed = &rule->end;
+    int32_t so = rule->std_offset;
+    int32_t dso = rule->dst_offset;
+    int64_t y = year_from_days(floor_div(t + so, 86400));
+    int64_t start = rule_instant(sd, y, so);
+    int64_t end = rule_instant(ed, y, dso);
+
+    if (start < end) {
+        /* Northern hemisphere: DST inside the year */
+        if (t < start)
+            rule_period(rule, 0, rule_instant(ed, y - 1, dso), start, out);
+        else if (t < end)
+            rule_period(rule, 1, start, end, out);
+        else
+            rule_period(rule, 0, end, rule_instant(sd, y + 1, so), out);
+    } else {
+        /* Southern hemisphere: DST spans the new year */
+        if (t < end)
+            rule_period(rule, 1, rule_instant(sd, y - 1, so), end, out);
+        else if (t < start)
+            rule_period(rule, 0, end, start, out);
+        else
+            rule_period(rule, 1, start, rule_instant(ed, y + 1, dso), out);
+    }
+}
+
+/* ======================================================
+ * Internal: TZif parsing (RFC 8536)
+ * ====================================================== */
+
+/* Parse one header + data block; returns its length or 0 if invalid */
+static size_t parse_block(
+    fossil_time_zone_t *zone,
+    const unsigned char *p,
+    size_t avail,
+    uint32_t time_size
+) {
+    if (avail < FOSSIL_ZONE_HEADER_SIZE || memcmp(p, "TZif", 4) != 0)
+        return 0;
+
+    uint32_t isutcnt  = load_be32(p + 20);
+    uint32_t isstdcnt = load_be32(p + 24);
+    uint32_t leapcnt  = load_be32(p + 28);
+    uint32_t timecnt  = load_be32(p + 32);
+    uint32_t typecnt  = load_be32(p + 36);
+    uint32_t charcnt  = load_be32(p + 40);
+
+    if (typecnt == 0 || typecnt > 256 || charcnt == 0 ||
+        (isutcnt != 0 && isutcnt != typecnt) ||
+        (isstdcnt != 0 && isstdcnt != typecnt) ||
+        timecnt > avail || leapcnt > avail || charcnt > avail)
+        return 0;
+
+    size_t len = FOSSIL_ZONE_HEADER_SIZE;
+    size_t times_at = len;
+    len += (size_t)timecnt * time_size;
+    size_t indices_at = len;
+    len += timecnt;
+    size_t types_at = len;
+    len += (size_t)typecnt * 6;
+    size_t abbrevs_at = len;
+    len += charcnt;
+    len += (size_t)leapcnt * (time_size + 4) + isstdcnt + isutcnt;
+
+    if (len > avail)
+        return 0;
+
+    zone->timecnt   = timecnt;
+    zone->typecnt   = typecnt;
+    zone->charcnt   = charcnt;
+    zone->time_size = time_size;
+    zone->times     = p + times_at;
+    zone->indices   = p + indices_at;
+    zone->types     = p + types_at;
+    zone->abbrevs   = (const char *)(p + abbrevs_at);
+    return len;
+}
+
+/* Validate once so lookups can trust every index */
+static int validate_tables(const fossil_time_zone_t *zone) {
+    if (zone->abbrevs[zone->charcnt - 1] != '\0')
+        return -1;
+    for (uint32_t i = 0; i < zone->typecnt; ++i) {
+        if (zone->types[i * 6 + 5] >= zone->charcnt)
+            return -1;
+    }
+    for (uint32_t i = 0; i < zone->timecnt; ++i) {
+        if (zone->indices[i] >= zone->typecnt)
+            return -1;
+        if (i > 0 && load_time(zone, i - 1) >= load_time(zone, i))
+            return -1;
+    }
+    return 0;
+}
+
+static int parse_tzif(fossil_time_zone_t *zone) {
+    const unsigned char *p = zone->data;
+    size_t avail = zone->size;
+    size_t len;
+
+    if (avail < FOSSIL_ZONE_HEADER_SIZE)
+        return -1;
+
+    len = parse_block(zone, p, avail, 4);
+    if (len == 0)
+        return -1;
+
+    if (p[4] >= '2') {
+        /* Skip the 32-bit block; use the 64-bit one and its footer */
+        p += len;
+        avail -= len;
+        len = parse_block(zone, p, avail, 8);
+        if (len == 0)
+            return -1;
+        p += len;
+        avail -= len;
+
+        if (avail < 2 || p[0] != '\n')
+            return -1;
+        const unsigned char *nl = memchr(p + 1, '\n', avail - 1);
+        if (!nl || parse_rule((const char *)p + 1, (size_t)(nl - p - 1), &zone->rule) != 0)
+            return -1;
+    }
+
+    return validate_tables(zone);
+}
+
+static void type_period(const fossil_time_zone_t *zone, uint32_t type, fossil_time_zone_period_t *out) {
+    const unsigned char *tt = zone->types + (size_t)type * 6;
+    out->offset_sec = (int32_t)load_be32(tt);
+    out->is_dst = tt[4] != 0;
+    out->abbrev = zone->abbrevs + tt[5];
+}
+
+/* ======================================================
+ * Internal: civil breakdown and wall-clock resolution
+ * ====================================================== */
+
+/* Fill the calendar part of a date for a day number (days since epoch) */
+static void fill_day(int64_t days, fossil_time_date_t *dt) {
+    int64_t z = days + 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp  = (5 * doy + 2) / 153;
+    const unsigned m   = mp < 10 ? mp + 3 : mp - 9;
+    const int64_t y    = (int64_t)yoe + era * 400 + (m <= 2);
+
+    memset(dt, 0, sizeof(*dt));
+    dt->year    = (int32_t)y;
+    dt->month   = (int8_t)m;
+    dt->day     = (int8_t)(doy - (153 * mp + 2) / 5 + 1);
+    dt->weekday = (int8_t)(days - floor_div(days + 4, 7) * 7 + 4);
+    dt->yearday = (int16_t)(days - days_from_civil(y, 1, 1) + 1);
+    dt->precision_mask =
+        FOSSIL_TIME_PRECISION_YEAR   |
+        FOSSIL_TIME_PRECISION_MONTH  |
+        FOSSIL_TIME_PRECISION_DAY    |
+        FOSSIL_TIME_PRECISION_HOUR   |
+        FOSSIL_TIME_PRECISION_MINUTE |
+        FOSSIL_TIME_PRECISION_SECOND |
+        FOSSIL_TIME_PRECISION_MILLI  |
+        FOSSIL_TIME_PRECISION_MICRO  |
+        FOSSIL_TIME_PRECISION_NANO;
+}
+
+static void fill_clock(int64_t sod, int64_t sub, fossil_time_date_t *dt) {
+    dt->hour        = (int8_t)(sod / 3600);
+    dt->minute      = (int8_t)((sod / 60) % 60);
+    dt->second      = (int8_t)(sod % 60);
+    dt->millisecond = (int16_t)(sub / 1000000);
+    dt->microsecond = (int16_t)((sub / 1000) % 1000);
+    dt->nanosecond  = (int16_t)(sub % 1000);
+}
+
+/* Wall-clock seconds of a date, tz_offset_min ignored */
+static int64_t wall_seconds(const fossil_time_date_t *dt) {
+    return days_from_civil(dt->year, (unsigned)dt->month, (unsigned)dt->day) * 86400
+         + (int64_t)dt->hour * 3600 + (int64_t)dt->minute * 60 + dt->second;
+}
+
+/* Sub-second nanoseconds of a date, as fossil_time_date_to_unix_nanoseconds reads them */
+static int64_t wall_subsecond(const fossil_time_date_t *dt) {
+    int64_t ns = 0;
+    if (dt->precision_mask & FOSSIL_TIME_PRECISION_MILLI)
+        ns += dt->millisecond * 1000000LL;
+    if (dt->precision_mask & FOSSIL_TIME_PRECISION_MICRO)
+        ns += dt->microsecond * 1000LL;
+    if (dt->precision_mask & FOSSIL_TIME_PRECISION_NANO)
+        ns += dt->nanosecond;
+    return ns;
+}
+
+/* Nanoseconds past the second, 0..999999999; never forms sec * 1e9, which
+ * leaves the int64 range for the second containing INT64_MIN */
+static int64_t subsecond_ns(int64_t ns) {
+    int64_t sub = ns % FOSSIL_ZONE_NS_PER_SEC;
+    return sub < 0 ? sub + FOSSIL_ZONE_NS_PER_SEC : sub;
+}
+
+/* UTC seconds plus sub-second nanoseconds as epoch ns; -1 past the int64 range */
+static int utc_to_ns(int64_t utc, int64_t sub, int64_t *out) {
+    if (utc > INT64_MAX / FOSSIL_ZONE_NS_PER_SEC || utc < INT64_MIN / FOSSIL_ZONE_NS_PER_SEC)
+        return -1;
+    utc *= FOSSIL_ZONE_NS_PER_SEC;
+    if ((sub > 0 && utc > INT64_MAX - sub) || (sub < 0 && utc < INT64_MIN - sub))
+        return -1;
+    *out = utc + sub;
+    return 0;
+}
+
+static int well_inside(const fossil_time_zone_period_t *p, int64_t t) {
+    return (p->begin == INT64_MIN || t - FOSSIL_ZONE_RESOLVE_MARGIN >= p->begin) &&
+           (p->end == INT64_MAX || t + FOSSIL_ZONE_RESOLVE_MARGIN < p->end);
+}
+
+/*
+ * Resolve wall-clock seconds to UTC by walking the periods around them.
+ * A wall time matches at most two periods (the sides of a backward
+ * transition) or falls between two (a forward transition's gap); the
+ * policy picks the instant, or rejects with -1.
+ */
+static int resolve_local(
+    const fossil_time_zone_t *zone,
+    int64_t wall,
+    fossil_time_zone_policy_t policy,
+    int64_t *out_utc,
+    fossil_time_zone_period_t *out_period
+) {
+    fossil_time_zone_period_t cur, prev, first;
+    int64_t first_utc = 0;
+    int have_prev = 0, found = 0;
+
+    fossil_time_zone_lookup(zone, wall - FOSSIL_ZONE_RESOLVE_MARGIN, &cur);
+
+    for (;;) {
+        int64_t t = wall - cur.offset_sec;
+
+        if (t >= cur.begin && t < cur.end) {
+            if (found) {
+                /* Repeated by a backward transition */
+                if (policy == FOSSIL_TIME_ZONE_REJECT)
+                    return -1;
+                if (policy == FOSSIL_TIME_ZONE_LATEST) {
+                    *out_utc = t;
+                    *out_period = cur;
+                    return 0;
+                }
+                break;
+            }
+            found = 1;
+            first_utc = t;
+            first = cur;
+            /* Only these two policies care whether a second match exists */
+            if (policy != FOSSIL_TIME_ZONE_LATEST && policy != FOSSIL_TIME_ZONE_REJECT)
+                break;
+        } else if (have_prev && !found && t < cur.begin) {
+            /* Skipped by a forward transition between prev and cur */
+            if (policy == FOSSIL_TIME_ZONE_REJECT)
+                return -1;
+            if (policy == FOSSIL_TIME_ZONE_EARLIEST) {
+                *out_utc = wall - cur.offset_sec;
+                *out_period = prev;
+            } else {
+                *out_utc = wall - prev.offset_sec;
+                *out_period = cur;
+            }
+            return 0;
+        }
+        if (cur.end == INT64_MAX || cur.end > wall + FOSSIL_ZONE_RESOLVE_MARGIN)
+            break;
+
+        prev = cur;
+        have_prev = 1;
+        fossil_time_zone_lookup(zone, prev.end, &cur);
+    }
+
+    if (found) {
+        *out_utc = first_utc;
+        *out_period = first;
+        return 0;
+    }
+
+    /* Unreachable for valid zone data; fall back to the last offset seen */
+    *out_utc = wall - cur.offset_sec;
+    *out_period = cur;
+    return 0;
+}
+
+/* 0 for "iso" (offset designator), 1 for "abbr" (zone abbreviation) */
+static int parse_format_id(const char *format_id) {
+    if (!format_id)
+        return -1;
+    if (strcmp(format_id, "iso") == 0)
+        return 0;
+    if (strcmp(format_id, "abbr") == 0)
+        return 1;
+    return -1;
+}
+
+/*
+ * Text written after the time part for a period: the designator
+ * fossil_time_date_format derives from tz_offset_min, or a space and the
+ * abbreviation.
+ */
+static void period_suffix(const fossil_time_zone_period_t *p, int abbr, char *out, size_t size) {
+    int m = p->offset_sec / 60;
+    int a = m < 0 ? -m : m;
+
+    if (abbr)
+        snprintf(out, size, " %s", p->abbrev);
+    else if (m == 0)
+        snprintf(out, size, "Z");
+    else
+        snprintf(out, size, "%c%02d:%02d", m < 0 ? '-' : '+', a / 60, a % 60);
+}
+
+/* ======================================================
+ * Internal: file mapping
+ * ====================================================== */
+
+static int valid_name(const char *name) {
+    size_t len;
+
+    if (!name || !*name || name[0] == '/' || name[0] == '\\' || strchr(name, ':'))
+        return 0;
+    len = strlen(name);
+    if (len >= FOSSIL_ZONE_MAX_NAME)
+        return 0;
+
+    for (const char *p = name; *p; ) {
+        size_t n = strcspn(p, "/\\");
+        if ((n == 2 && p[0] == '.' && p[1] == '.') || n == 0)
+            return 0;
+        p += n;
+        if (*p) p++;
+    }
+    return 1;
+}
+
+static const unsigned char *map_file(const char *path, size_t *out_size) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER size;
+    HANDLE mapping;
+    void *view = NULL;
+
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        *out_size = (size_t)size.QuadPart;
+    }
+    CloseHandle(file);
+    return (const unsigned char *)view;
+#else
+    struct stat st;
+    void *view = NULL;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED)
+            view = NULL;
+        *out_size = (size_t)st.st_size;
+    }
+    close(fd);
+    return (const unsigned char *)view;
+#endif
+}
+
+static void unmap_file(const unsigned char *data, size_t size) {
+#if defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap((void *)(uintptr_t)data, size);
+#endif
+}
+
+static fossil_time_zone_t *zone_create(
+    const char *name,
+    const unsigned char *data,
+    size_t size,
+    int mapped
+) {
+    fossil_time_zone_t *zone = (fossil_time_zone_t *)calloc(1, sizeof(*zone));
+    if (!zone)
+        return NULL;
+
+    strncpy(zone->name, name, sizeof(zone->name) - 1);
+    zone->data = data;
+    zone->size = size;
+    zone->mapped = mapped;
+
+    if (parse_tzif(zone) != 0) {
+        free(zone);
+        return NULL;
+    }
+    zone->id = next_zone_id();
+    zone->refs = 1;
+    return zone;
+}
+
+/* ======================================================
+ * Internal: embedded database
+ * ====================================================== */
+
+#if defined(FOSSIL_TIME_EMBEDDED_ZONES)
+
+/*
+ * Layout written by tools/zonegen.py, little-endian:
+ *   header   "FZDB", zone count, rule count, strings offset, records offset
+ *   index    per zone, sorted by name: name string, record offset, rule
+ *   rules    per distinct POSIX TZ footer: string offset
+ *   strings  NUL-terminated names, footers and abbreviations
+ *   records  varint type count; per type a zigzag offset, an isdst byte
+ *            and an abbreviation string; varint transition count; the
+ *            first transition zigzag-encoded, then varint deltas; one
+ *            type index byte per transition
+ * Links share a record, and zones share footers and abbreviations.
+ */
+
+static uint32_t load_le32(const unsigned char *p) {
+    return ((uint32_t)p[3] << 24) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[1] << 8)  |  (uint32_t)p[0];
+}
+
+static void store_be32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+static const unsigned char *read_varint(
+    const unsigned char *p,
+    const unsigned char *end,
+    uint64_t *out
+) {
+    uint64_t v = 0;
+
+    for (unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        unsigned char b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *out = v;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+/* Binary search of the name index; returns the zone's record or NULL */
+static const unsigned char *embedded_find(const char *name, uint32_t *out_rule) {
+    const unsigned char *db = fossil_time_zone_embedded;
+    uint32_t count, strings_at, zones_at, lo, hi;
+
+    if (fossil_time_zone_embedded_size < FOSSIL_ZONE_DB_HEADER_SIZE ||
+        memcmp(db, "FZDB", 4) != 0)
+        return NULL;
+
+    count = load_le32(db + 4);
+    strings_at = load_le32(db + 12);
+    zones_at = load_le32(db + 16);
+
+    lo = 0;
+    hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const unsigned char *e = db + FOSSIL_ZONE_DB_HEADER_SIZE + (size_t)mid * FOSSIL_ZONE_DB_ENTRY_SIZE;
+        int cmp = strcmp(name, (const char *)db + strings_at + load_le32(e));
+
+        if (cmp == 0) {
+            *out_rule = (uint32_t)e[8] | ((uint32_t)e[9] << 8);
+            return db + zones_at + load_le32(e + 4);
+        }
+        if (cmp < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return NULL;
+}
+
+/*
+ * Expand a record into the in-memory form of a TZif v2 block, so lookups
+ * run unchanged: 8-byte big-endian transitions, type indices, 6-byte
+ * ttinfo records and a zone-local abbreviation table.
+ */
+static int embedded_decode(fossil_time_zone_t *zone, const unsigned char *p, uint32_t rule) {
+    const unsigned char *db = fossil_time_zone_embedded;
+    const unsigned char *end = db + fossil_time_zone_embedded_size;
+    const char *strings = (const char *)db + load_le32(db + 12);
+    uint32_t strings_size = load_le32(db + 16) - load_le32(db + 12);
+    const unsigned char *type_at;
+    uint64_t typecnt, timecnt, v;
+    unsigned char *buf, *types;
+    char *abbrevs;
+    size_t charcnt = 0;
+    int64_t t = 0;
+
+    p = read_varint(p, end, &typecnt);
+    if (!p || typecnt == 0 || typecnt > 256)
+        return -1;
+
+    /* Skip the types to size the buffer; they are decoded into it below */
+    type_at = p;
+    for (uint64_t i = 0; i < typecnt; ++i) {
+        p = read_varint(p, end, &v);
+        if (!p || p >= end)
+            return -1;
+        p = read_varint(p + 1, end, &v);
+        if (!p || v >= strings_size)
+            return -1;
+    }
+    p = read_varint(p, end, &timecnt);
+    if (!p || timecnt > (uint64_t)(end - p))
+        return -1;
+
+    buf = (unsigned char *)malloc((size_t)timecnt * 9 + (size_t)typecnt * (6 + FOSSIL_ZONE_MAX_ABBR));
+    if (!buf)
+        return -1;
+    types = buf + (size_t)timecnt * 9;
+    abbrevs = (char *)(types + (size_t)typecnt * 6);
+
+    for (uint64_t i = 0; i < typecnt; ++i) {
+        const char *abbr;
+        size_t len, at = 0;
+
+        type_at = read_varint(type_at, end, &v);
+        store_be32(types + i * 6, (uint32_t)(int32_t)unzigzag(v));
+        types[i * 6 + 4] = *type_at++;
+        type_at = read_varint(type_at, end, &v);
+
+        abbr = strings + v;
+        len = strlen(abbr);
+        if (len >= FOSSIL_ZONE_MAX_ABBR)
+            goto fail;
+
+        /* Types sharing an abbreviation share its bytes, as in TZif */
+        while (at < charcnt && strcmp(abbrevs + at, abbr) != 0)
+            at += strlen(abbrevs + at) + 1;
+        if (at == charcnt) {
+            memcpy(abbrevs + charcnt, abbr, len + 1);
+            charcnt += len + 1;
+        }
+        if (at > 255)
+            goto fail;
+        types[i * 6 + 5] = (unsigned char)at;
+    }
+
+    for (uint64_t i = 0; i < timecnt; ++i) {
+        p = read_varint(p, end, &v);
+        if (!p)
+            goto fail;
+        t = (i == 0) ? unzigzag(v) : t + (int64_t)v;
+        store_be32(buf + i * 8, (uint32_t)((uint64_t)t >> 32));
+        store_be32(buf + i * 8 + 4, (uint32_t)t);
+    }
+    if ((uint64_t)(end - p) < timecnt)
+        goto fail;
+    memcpy(buf + (size_t)timecnt * 8, p, (size_t)timecnt);
+
+    zone->data      = buf;
+    zone->size      = (size_t)timecnt * 9 + (size_t)typecnt * 6 + charcnt;
+    zone->owned     = 1;
+    zone->timecnt   = (uint32_t)timecnt;
+    zone->typecnt   = (uint32_t)typecnt;
+    zone->charcnt   = (uint32_t)charcnt;
+    zone->time_size = 8;
+    zone->times     = buf;
+    zone->indices   = buf + (size_t)timecnt * 8;
+    zone->types     = types;
+    zone->abbrevs   = abbrevs;
+
+    if (rule != FOSSIL_ZONE_DB_NO_RULE) {
+        uint32_t rules_at = FOSSIL_ZONE_DB_HEADER_SIZE + load_le32(db + 4) * FOSSIL_ZONE_DB_ENTRY_SIZE;
+        const char *text;
+
+        if (rule >= load_le32(db + 8))
+            goto fail;
+        text = strings + load_le32(db + rules_at + rule * 4);
+        if (parse_rule(text, strlen(text), &zone->rule) != 0)
+            goto fail;
+    }
+
+    if (validate_tables(zone) == 0)
+        return 0;
+
+fail:
+    free(buf);
+    zone->data = NULL;
+    zone->owned = 0;
+    return -1;
+}
+
+#endif
+
+/* ======================================================
+ * Internal: shared registry
+ * ====================================================== */
+
+static uint32_t hash_name(const char *name) {
+    uint32_t h = 2166136261u;   /* FNV-1a */
+    while (*name)
+        h = (h ^ (unsigned char)*name++) * 16777619u;
+    return h;
+}
+
+/* Take a reference to the entry's current version without locking */
+static fossil_time_zone_t *entry_acquire(fossil_zone_entry_t *entry) {
+    fossil_time_zone_t *zone;
+
+    FOSSIL_ZONE_INC(&entry->readers);
+    zone = (fossil_time_zone_t *)FOSSIL_ZONE_LOAD_PTR(&entry->current);
+    FOSSIL_ZONE_INC(&zone->refs);
+    FOSSIL_ZONE_DEC(&entry->readers);
+    return zone;
+}
+
+/* ======================================================
+ * C API — Database
+ * ====================================================== */
+
+int fossil_time_zone_set_directory(const char *directory) {
+    if (!directory) {
+        g_directory_set = 0;
+        g_directory[0] = '\0';
+        return 0;
+    }
+    if (strlen(directory) >= sizeof(g_directory))
+        return -1;
+
+    strcpy(g_directory, directory);
+    g_directory_set = 1;
+    return 0;
+}
+
+const char *fossil_time_zone_directory(void) {
+    const char *env;
+
+    if (g_directory_set)
+        return g_directory;
+    env = getenv("TZDIR");
+    if (env && *env)
+        return env;
+    return FOSSIL_ZONE_DEFAULT_DIR;
+}
+
+/* ======================================================
+ * C API — Zones
+ * ====================================================== */
+
+fossil_time_zone_t *fossil_time_zone_open(const char *name) {
+    char path[FOSSIL_ZONE_MAX_PATH + FOSSIL_ZONE_MAX_NAME + 1];
+    const char *dir = fossil_time_zone_directory();
+    const unsigned char *data;
+    fossil_time_zone_t *zone;
+    size_t dir_len, size = 0;
+
+    if (!valid_name(name))
+        return NULL;
+
+    /* An explicitly configured directory takes precedence over built-in zones */
+    if (!g_directory_set) {
+        zone = fossil_time_zone_open_embedded(name);
+        if (zone)
+            return zone;
+    }
+
+    dir_len = strlen(dir);
+    if (dir_len >= FOSSIL_ZONE_MAX_PATH)
+        return NULL;
+    memcpy(path, dir, dir_len);
+    path[dir_len] = '/';
+    strcpy(path + dir_len + 1, name);
+
+    data = map_file(path, &size);
+    if (!data)
+        return NULL;
+
+    zone = zone_create(name, data, size, 1);
+    if (!zone)
+        unmap_file(data, size);
+    return zone;
+}
+
+fossil_time_zone_t *fossil_time_zone_open_memory(
+    const char *name,
+    const void *data,
+    size_t size
+) {
+    if (!name || !data)
+        return NULL;
+    return zone_create(name, (const unsigned char *)data, size, 0);
+}
+
+fossil_time_zone_t *fossil_time_zone_open_embedded(const char *name) {
+#if defined(FOSSIL_TIME_EMBEDDED_ZONES)
+    const unsigned char *record;
+    fossil_time_zone_t *zone;
+    uint32_t rule;
+
+    if (!valid_name(name))
+        return NULL;
+    record = embedded_find(name, &rule);
+    if (!record)
+        return NULL;
+
+    zone = (fossil_time_zone_t *)calloc(1, sizeof(*zone));
+    if (!zone)
+        return NULL;
+
+    strncpy(zone->name, name, sizeof(zone->name) - 1);
+    if (embedded_decode(zone, record, rule) != 0) {
+        free(zone);
+        return NULL;
+    }
+    zone->id = next_zone_id();
+    zone->refs = 1;
+    return zone;
+#else
+    (void)name;
+    return NULL;
+#endif
+}
+
+void fossil_time_zone_close(fossil_time_zone_t *zone) {
+    if (!zone || FOSSIL_ZONE_DEC(&zone->refs) != 0)
+        return;
+    if (zone->mapped)
+        unmap_file(zone->data, zone->size);
+    if (zone->owned)
+        free((void *)(uintptr_t)zone->data);
+    free(zone);
+}
+
+const char *fossil_time_zone_name(const fossil_time_zone_t *zone) {
+    return zone ? zone->name : NULL;
+}
+
+/* ======================================================
+ * C API — Shared zones
+ * ====================================================== */
+
+fossil_time_zone_t *fossil_time_zone_get(const char *name) {
+    fossil_time_zone_t *zone;
+    uint32_t h;
+
+    if (!valid_name(name))
+        return NULL;
+
+    h = hash_name(name);
+    for (uint32_t probe = 0; probe < FOSSIL_ZONE_REGISTRY_SLOTS; ++probe) {
+        fossil_zone_entry_t **slot = &g_registry[(h + probe) & (FOSSIL_ZONE_REGISTRY_SLOTS - 1)];
+        fossil_zone_entry_t *entry = (fossil_zone_entry_t *)FOSSIL_ZONE_LOAD_PTR(slot);
+
+        if (!entry) {
+            /* First use of the name: load it, then try to claim the slot */
+            fossil_zone_entry_t *fresh = (fossil_zone_entry_t *)calloc(1, sizeof(*fresh));
+            fossil_zone_entry_t *expected = NULL;
+
+            if (!fresh)
+                return NULL;
+            fresh->current = fossil_time_zone_open(name);
+            if (!fresh->current) {
+                free(fresh);
+                return NULL;
+            }
+            strcpy(fresh->name, name);
+
+            /* Take the caller's reference first: once published, a reload may swap it out */
+            zone = fossil_time_zone_retain(fresh->current);
+            if (FOSSIL_ZONE_CAS_PTR(slot, expected, fresh))
+                return zone;
+
+            /* Another thread claimed the slot first, maybe for this name */
+            fossil_time_zone_close(zone);
+            fossil_time_zone_close(zone);
+            free(fresh);
+            entry = (fossil_zone_entry_t *)FOSSIL_ZONE_LOAD_PTR(slot);
+        }
+
+        if (strcmp(entry->name, name) == 0)
+            return entry_acquire(entry);
+    }
+
+    /* Registry full: hand out a private zone rather than fail */
+    return fossil_time_zone_open(name);
+}
+
+fossil_time_zone_t *fossil_time_zone_retain(fossil_time_zone_t *zone) {
+    if (zone)
+        FOSSIL_ZONE_INC(&zone->refs);
+    return zone;
+}
+
+int fossil_time_zone_reload(const char *name) {
+    int reloaded = 0;
+
+    for (uint32_t i = 0; i < FOSSIL_ZONE_REGISTRY_SLOTS; ++i) {
+        fossil_zone_entry_t *entry = (fossil_zone_entry_t *)FOSSIL_ZONE_LOAD_PTR(&g_registry[i]);
+        fossil_time_zone_t *fresh, *old;
+
+        if (!entry || (name && strcmp(entry->name, name) != 0))
+            continue;
+
+        /* A zone that no longer loads keeps serving its previous data */
+        fresh = fossil_time_zone_open(entry->name);
+        if (!fresh)
+            continue;
+
+        old = (fossil_time_zone_t *)FOSSIL_ZONE_XCHG_PTR(&entry->current, fresh);
+
+        /* Grace period: a get that loaded old before the swap is still retaining it */
+        while (FOSSIL_ZONE_LOAD(&entry->readers) != 0)
+            FOSSIL_ZONE_YIELD();
+
+        fossil_time_zone_close(old);
+        reloaded++;
+    }
+    return reloaded;
+}
+
+/* ======================================================
+ * C API — Lookups
+ * ====================================================== */
+
+int fossil_time_zone_lookup(
+    const fossil_time_zone_t *zone,
+    int64_t utc_seconds,
+    fossil_time_zone_period_t *out
+) {
+    uint32_t n, lo, hi;
+
+    if (!zone || !out)
+        return -1;
+
+    n = zone->timecnt;
+    if (n == 0) {
+        if (zone->rule.present) {
+            rule_lookup(&zone->rule, utc_seconds, out);
+        } else {
+            type_period(zone, 0, out);
+            out->begin = INT64_MIN;
+            out->end = INT64_MAX;
+        }
+        return 0;
+    }
+
+    if (utc_seconds < load_time(zone, 0)) {
+        type_period(zone, 0, out);
+        out->begin = INT64_MIN;
+        out->end = load_time(zone, 0);
+        return 0;
+    }
+
+    /* Largest i with times[i] <= utc_seconds */
+    lo = 0;
+    hi = n;
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (load_time(zone, mid) <= utc_seconds)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    if (lo == n - 1 && zone->rule.present) {
+        int64_t last = load_time(zone, lo);
+        rule_lookup(&zone->rule, utc_seconds, out);
+        if (out->begin < last)
+            out->begin = last;
+        return 0;
+    }
+
+    type_period(zone, zone->indices[lo], out);
+    out->begin = load_time(zone, lo);
+    out->end = (lo + 1 < n) ? load_time(zone, lo + 1) : INT64_MAX;
+    return 0;
+}
+
+int fossil_time_zone_lookup_cached(
+    const fossil_time_zone_t *zone,
+    int64_t utc_seconds,
+    fossil_time_zone_period_t *out
+) {
+    fossil_zone_cache_t *slot;
+
+    if (!zone || !out)
+        return -1;
+
+    slot = &g_cache[zone->id % FOSSIL_ZONE_CACHE_SLOTS];
+    if (slot->id != zone->id ||
+        utc_seconds < slot->period.begin || utc_seconds >= slot->period.end) {
+        fossil_time_zone_lookup(zone, utc_seconds, &slot->period);
+        slot->id = zone->id;
+    }
+
+    *out = slot->period;
+    return 0;
+}
+
+int32_t fossil_time_zone_offset(
+    const fossil_time_zone_t *zone,
+    int64_t utc_ns
+) {
+    fossil_time_zone_period_t period;
+
+    if (fossil_time_zone_lookup_cached(zone, floor_div(utc_ns, FOSSIL_ZONE_NS_PER_SEC), &period) != 0)
+        return 0;
+    return period.offset_sec;
+}
+
+int fossil_time_zone_to_local(
+    const fossil_time_zone_t *zone,
+    int64_t utc_ns,
+    fossil_time_date_t *out
+) {
+    fossil_time_zone_period_t period;
+    int64_t shift;
+
+    if (!out || fossil_time_zone_lookup_cached(zone, floor_div(utc_ns, FOSSIL_ZONE_NS_PER_SEC), &period) != 0)
+        return -1;
+
+    shift = (int64_t)period.offset_sec * FOSSIL_ZONE_NS_PER_SEC;
+    if ((shift > 0 && utc_ns > INT64_MAX - shift) ||
+        (shift < 0 && utc_ns < INT64_MIN - shift))
+        return -1;
+
+    /* Zone conversions stay on plain UTC, whatever the date smear setting */
+    int64_t local = utc_ns + shift;
+    int64_t sec = floor_div(local, FOSSIL_ZONE_NS_PER_SEC);
+    int64_t day = floor_div(sec, 86400);
+
+    fill_day(day, out);
+    fill_clock(sec - day * 86400, subsecond_ns(local), out);
+    out->tz_offset_min = (int16_t)(period.offset_sec / 60);
+    return 0;
+}
+
+/* ======================================================
+ * C API — Batch conversion
+ * ====================================================== */
+
+int fossil_time_zone_to_local_batch(
+    const fossil_time_zone_t *zone,
+    const int64_t *utc_ns,
+    size_t count,
+    fossil_time_date_t *out
+) {
+    fossil_time_zone_period_t period;
+    fossil_time_date_t day_fields;
+    int64_t current_day = 0;
+    int have_day = 0;
+
+    if (!zone || (count > 0 && (!utc_ns || !out)))
+        return -1;
+
+    period.begin = 0;
+    period.end = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        int64_t sec = floor_div(utc_ns[i], FOSSIL_ZONE_NS_PER_SEC);
+        int64_t sub = subsecond_ns(utc_ns[i]);
+
+        /* Sorted input only searches when it crosses a transition */
+        if (sec < period.begin || sec >= period.end)
+            fossil_time_zone_lookup(zone, sec, &period);
+
+        int64_t local = sec + period.offset_sec;
+        int64_t day = floor_div(local, 86400);
+
+        /* Rows on the same local day share the calendar breakdown */
+        if (!have_day || day != current_day) {
+            fill_day(day, &day_fields);
+            current_day = day;
+            have_day = 1;
+        }
+
+        out[i] = day_fields;
+        out[i].tz_offset_min = (int16_t)(period.offset_sec / 60);
+        fill_clock(local - day * 86400, sub, &out[i]);
+    }
+
+    return 0;
+}
+
+/* ======================================================
+ * C API — Formatting
+ * ====================================================== */
+
+int fossil_time_zone_format(
+    const fossil_time_zone_t *zone,
+    int64_t utc_ns,
+    char *buffer,
+    size_t buffer_size,
+    const char *format_id
+) {
+    char suffix[FOSSIL_ZONE_MAX_ABBR + 8];
+    fossil_time_zone_period_t period;
+    fossil_time_date_t dt;
+    int64_t sec = floor_div(utc_ns, FOSSIL_ZONE_NS_PER_SEC), local, day;
+    int abbr = parse_format_id(format_id);
+
+    if (!zone || !buffer || buffer_size == 0 || abbr < 0)
+        return -1;
+
+    if (fossil_time_zone_lookup_cached(zone, sec, &period) != 0) {
+        buffer[0] = '\0';
+        return -1;
+    }
+
+    /* Broken down in seconds like the batch form, so no instant overflows */
+    local = sec + period.offset_sec;
+    day = floor_div(local, 86400);
+    fill_day(day, &dt);
+    dt.tz_offset_min = (int16_t)(period.offset_sec / 60);
+    fill_clock(local - day * 86400, subsecond_ns(utc_ns), &dt);
+
+    period_suffix(&period, abbr, suffix, sizeof(suffix));
+    return fossil_time_date_format_iso(&dt, buffer, buffer_size, suffix);
+}
+
+int fossil_time_zone_format_batch(
+    const fossil_time_zone_t *zone,
+    const int64_t *utc_ns,
+    size_t count,
+    char *buffer,
+    size_t stride,
+    const char *format_id
+) {
+    char suffix[FOSSIL_ZONE_MAX_ABBR + 8];
+    fossil_time_zone_period_t period;
+    fossil_time_date_t day_fields, dt;
+    int64_t current_day = 0;
+    int have_day = 0;
+    int abbr = parse_format_id(format_id);
+
+    if (!zone || abbr < 0 || (count > 0 && (!utc_ns || !buffer || stride == 0)))
+        return -1;
+
+    period.begin = 0;
+    period.end = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        int64_t sec = floor_div(utc_ns[i], FOSSIL_ZONE_NS_PER_SEC);
+        int64_t sub = subsecond_ns(utc_ns[i]);
+
+        /* The suffix is rendered once per period, not per row */
+        if (sec < period.begin || sec >= period.end) {
+            fossil_time_zone_lookup(zone, sec, &period);
+            period_suffix(&period, abbr, suffix, sizeof(suffix));
+        }
+
+        int64_t local = sec + period.offset_sec;
+        int64_t day = floor_div(local, 86400);
+
+        if (!have_day || day != current_day) {
+            fill_day(day, &day_fields);
+            current_day = day;
+            have_day = 1;
+        }
+
+        dt = day_fields;
+        dt.tz_offset_min = (int16_t)(period.offset_sec / 60);
+        fill_clock(local - day * 86400, sub, &dt);
+        fossil_time_date_format_iso(&dt, buffer + i * stride, stride, suffix);
+    }
+
+    return 0;
+}
+
+int fossil_time_zone_to_utc(
+    const fossil_time_zone_t *zone,
+    const fossil_time_date_t *local,
+    fossil_time_zone_policy_t policy,
+    int64_t *out_utc_ns
+) {
+    fossil_time_zone_period_t period;
+    int64_t utc;
+
+    if (!zone || !local || !out_utc_ns)
+        return -1;
+
+    if (resolve_local(zone, wall_seconds(local), policy, &utc, &period) != 0)
+        return -1;
+
+    return utc_to_ns(utc, wall_subsecond(local), out_utc_ns);
+}
+
+int fossil_time_zone_to_utc_batch(
+    const fossil_time_zone_t *zone,
+    const fossil_time_date_t *local,
+    size_t count,
+    fossil_time_zone_policy_t policy,
+    int64_t *out_utc_ns
+) {
+    fossil_time_zone_period_t period;
+    int have_period = 0;
+    int rejected = 0;
+
+    if (!zone || (count > 0 && (!local || !out_utc_ns)))
+        return -1;
+
+    for (size_t i = 0; i < count; ++i) {
+        int64_t wall = wall_seconds(&local[i]);
+        int64_t utc = have_period ? wall - period.offset_sec : 0;
+
+        /* Well inside a period a wall time is unambiguous under any policy */
+        if (!have_period || !well_inside(&period, utc)) {
+            if (resolve_local(zone, wall, policy, &utc, &period) != 0) {
+                out_utc_ns[i] = INT64_MIN;
+                rejected++;
+                continue;
+            }
+            have_period = 1;
+        }
+
+        if (utc_to_ns(utc, wall_subsecond(&local[i]), &out_utc_ns[i]) != 0) {
+            out_utc_ns[i] = INT64_MIN;
+            rejected++;
+        }
+    }
+
+    return rejected;
+}
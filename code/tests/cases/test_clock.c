@@ -0,0 +1,141 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+
+#if defined(__linux__)
+#  include <sys/timex.h>
+#endif
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(c_clock_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(c_clock_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(c_clock_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#define CLOCK_MS 1000000LL
+
+// Test: a fixed bound gives an interval of twice its width around now
+FOSSIL_TEST(c_test_clock_fixed_interval) {
+    fossil_time_interval_t now;
+    fossil_time_date_t dt;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_set_uncertainty(-7), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_set_uncertainty(5 * CLOCK_MS), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_now_uncertainty(), 5 * CLOCK_MS);
+
+    fossil_time_date_now(&dt);
+    int64_t before = fossil_time_date_to_unix_nanoseconds(&dt);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_interval(&now), 0);
+    ASSUME_ITS_EQUAL_I64(now.latest - now.earliest, 10 * CLOCK_MS);
+    ASSUME_ITS_TRUE(now.latest >= before + 5 * CLOCK_MS);
+    ASSUME_ITS_TRUE(now.earliest < before + 1000 * CLOCK_MS);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_interval(NULL), -1);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_set_uncertainty(FOSSIL_TIME_UNCERTAINTY_MEASURED), 0);
+}
+
+// Test: after/before only answer yes outside the interval
+FOSSIL_TEST(c_test_clock_after_before) {
+    fossil_time_interval_t now;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_set_uncertainty(50 * CLOCK_MS), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_interval(&now), 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_after(now.earliest - 1000 * CLOCK_MS), 1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_after(now.latest + 1000 * CLOCK_MS), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_before(now.latest + 1000 * CLOCK_MS), 1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_before(now.earliest - 1000 * CLOCK_MS), 0);
+
+    // A reading's own latest bound has not definitely passed yet
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_after(now.latest), 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_set_uncertainty(FOSSIL_TIME_UNCERTAINTY_MEASURED), 0);
+}
+
+// Test: commit wait returns once the timestamp is definitely past
+FOSSIL_TEST(c_test_clock_commit_wait) {
+    fossil_time_interval_t now;
+    fossil_time_timer_t timer;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_set_uncertainty(2 * CLOCK_MS), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_interval(&now), 0);
+
+    fossil_time_timer_start(&timer);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_commit_wait(now.latest), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_after(now.latest), 1);
+    ASSUME_ITS_TRUE(fossil_time_timer_elapsed_ns(&timer) >= (uint64_t)(3 * CLOCK_MS));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_set_uncertainty(FOSSIL_TIME_UNCERTAINTY_MEASURED), 0);
+}
+
+// Test: the measured bound either works end to end or reports unavailable
+FOSSIL_TEST(c_test_clock_measured) {
+    fossil_time_interval_t now;
+    int64_t error_ns = fossil_time_now_uncertainty();
+
+#if defined(__linux__)
+    // An unsynchronized clock reports no bound, whatever maxerror says
+    struct timex tx = {0};
+    int state = adjtimex(&tx);
+    int unsynced = state == -1 || state == TIME_ERROR || (tx.status & STA_UNSYNC) != 0;
+    ASSUME_ITS_EQUAL_I32(error_ns < 0, unsynced);
+    if (!unsynced)
+        ASSUME_ITS_TRUE(error_ns <= (int64_t)tx.maxerror * 1000);
+#endif
+
+    if (error_ns < 0) {
+        ASSUME_ITS_EQUAL_I32(fossil_time_now_interval(&now), -1);
+        ASSUME_ITS_EQUAL_I32(fossil_time_now_after(0), -1);
+        return;
+    }
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_interval(&now), 0);
+    ASSUME_ITS_TRUE(now.latest - now.earliest >= 2 * error_ns);
+    ASSUME_ITS_EQUAL_I32(fossil_time_now_after(0), 1);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_clock_tests) {
+    FOSSIL_TEST_ADD(c_clock_suite, c_test_clock_fixed_interval);
+    FOSSIL_TEST_ADD(c_clock_suite, c_test_clock_after_before);
+    FOSSIL_TEST_ADD(c_clock_suite, c_test_clock_commit_wait);
+    FOSSIL_TEST_ADD(c_clock_suite, c_test_clock_measured);
+
+    FOSSIL_TEST_REGISTER(c_clock_suite);
+}
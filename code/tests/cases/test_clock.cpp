@@ -0,0 +1,72 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(cpp_clock_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(cpp_clock_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(cpp_clock_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+using fossil::time::Clock;
+
+// Test: Clock wrapper reads intervals and waits out uncertainty
+FOSSIL_TEST(cpp_test_clock_wrapper) {
+    fossil_time_interval_t now;
+
+    ASSUME_ITS_FALSE(Clock::set_uncertainty(-3));
+    ASSUME_ITS_TRUE(Clock::set_uncertainty(1000000));
+    ASSUME_ITS_EQUAL_I64(Clock::uncertainty(), 1000000);
+
+    ASSUME_ITS_TRUE(Clock::now(now));
+    ASSUME_ITS_EQUAL_I64(now.latest - now.earliest, 2000000);
+    ASSUME_ITS_TRUE(Clock::before(now.latest + 1000000000LL));
+    ASSUME_ITS_TRUE(Clock::commit_wait(now.latest));
+    ASSUME_ITS_TRUE(Clock::after(now.latest));
+
+    ASSUME_ITS_TRUE(Clock::set_uncertainty(FOSSIL_TIME_UNCERTAINTY_MEASURED));
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_clock_tests) {
+    FOSSIL_TEST_ADD(cpp_clock_suite, cpp_test_clock_wrapper);
+
+    FOSSIL_TEST_REGISTER(cpp_clock_suite);
+}
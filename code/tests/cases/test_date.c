@@ -110,6 +110,27 @@ FOSSIL_TEST(c_test_date_normalize) {
     // 2024-06-01 is a Saturday (weekday 6), yearday 153
     ASSUME_ITS_EQUAL_I32(dt.weekday, 6);
     ASSUME_ITS_EQUAL_I32(dt.yearday, 153);
+
+    // Out-of-range fields carry like mktime: 2023-12-31T24:00 is 2024-01-01
+    dt = make_date(2023, 12, 31, 24, 0, 0, 0, 0, 0,
+        FOSSIL_TIME_PRECISION_YEAR | FOSSIL_TIME_PRECISION_MONTH | FOSSIL_TIME_PRECISION_DAY);
+    fossil_time_date_normalize(&dt);
+    ASSUME_ITS_EQUAL_I32(dt.weekday, 1);
+    ASSUME_ITS_EQUAL_I32(dt.yearday, 1);
+
+    // Month 14 of 2023 is February 2024; day 0 is the last day of January
+    dt = make_date(2023, 14, 0, 0, 0, 0, 0, 0, 0,
+        FOSSIL_TIME_PRECISION_YEAR | FOSSIL_TIME_PRECISION_MONTH | FOSSIL_TIME_PRECISION_DAY);
+    fossil_time_date_normalize(&dt);
+    ASSUME_ITS_EQUAL_I32(dt.weekday, 3);
+    ASSUME_ITS_EQUAL_I32(dt.yearday, 31);
+
+    // Pre-epoch dates
+    dt = make_date(1900, 3, 1, 0, 0, 0, 0, 0, 0,
+        FOSSIL_TIME_PRECISION_YEAR | FOSSIL_TIME_PRECISION_MONTH | FOSSIL_TIME_PRECISION_DAY);
+    fossil_time_date_normalize(&dt);
+    ASSUME_ITS_EQUAL_I32(dt.weekday, 4);
+    ASSUME_ITS_EQUAL_I32(dt.yearday, 60);
 }
 
 // Test: fossil_time_date_compare
@@ -150,6 +171,29 @@ FOSSIL_TEST(c_test_date_to_from_unix_seconds) {
     ASSUME_ITS_EQUAL_I32(dt2.second, 0);
 }
 
+// Test: fossil_time_date_from_unix_nanoseconds round-trips, including before 1970
+FOSSIL_TEST(c_test_date_from_unix_nanoseconds) {
+    fossil_time_date_t dt;
+
+    fossil_time_date_from_unix_nanoseconds(-1, &dt);
+    ASSUME_ITS_EQUAL_I32(dt.year, 1969);
+    ASSUME_ITS_EQUAL_I32(dt.month, 12);
+    ASSUME_ITS_EQUAL_I32(dt.day, 31);
+    ASSUME_ITS_EQUAL_I32(dt.second, 59);
+    ASSUME_ITS_EQUAL_I32(dt.millisecond, 999);
+    ASSUME_ITS_EQUAL_I32(dt.nanosecond, 999);
+    ASSUME_ITS_EQUAL_I32(dt.weekday, 3);
+    ASSUME_ITS_EQUAL_I32(dt.yearday, 365);
+    ASSUME_ITS_EQUAL_I64(fossil_time_date_to_unix_nanoseconds(&dt), -1);
+
+    fossil_time_date_from_unix_nanoseconds(1709210096123456789LL, &dt); // 2024-02-29T12:34:56
+    ASSUME_ITS_EQUAL_I32(dt.month, 2);
+    ASSUME_ITS_EQUAL_I32(dt.day, 29);
+    ASSUME_ITS_EQUAL_I32(dt.hour, 12);
+    ASSUME_ITS_EQUAL_I32(dt.microsecond, 456);
+    ASSUME_ITS_EQUAL_I64(fossil_time_date_to_unix_nanoseconds(&dt), 1709210096123456789LL);
+}
+
 // Test: fossil_time_date_to_unix_nanoseconds
 FOSSIL_TEST(c_test_date_to_unix_nanoseconds) {
     fossil_time_date_t dt = make_date(1970, 1, 1, 0, 0, 1, 123, 456, 789,
@@ -177,6 +221,129 @@ FOSSIL_TEST(c_test_date_format) {
     ASSUME_ITS_EQUAL_CSTR(buf, "invalid_date");
 }
 
+// Test: ISO output carries tz_offset_min instead of always writing Z
+FOSSIL_TEST(c_test_date_format_offset) {
+    fossil_time_date_t dt = make_date(2024, 6, 1, 14, 34, 56, 250, 0, 0,
+        FOSSIL_TIME_PRECISION_YEAR | FOSSIL_TIME_PRECISION_MONTH | FOSSIL_TIME_PRECISION_DAY |
+        FOSSIL_TIME_PRECISION_HOUR | FOSSIL_TIME_PRECISION_MINUTE | FOSSIL_TIME_PRECISION_SECOND |
+        FOSSIL_TIME_PRECISION_MILLI);
+    char buf[64];
+
+    dt.tz_offset_min = 120;
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_format(&dt, buf, sizeof(buf), "iso"), 28);
+    ASSUME_ITS_EQUAL_CSTR(buf, "2024-06-01T14:34:56.25+02:00");
+
+    dt.tz_offset_min = -570;
+    fossil_time_date_format(&dt, buf, sizeof(buf), "iso");
+    ASSUME_ITS_EQUAL_CSTR(buf, "2024-06-01T14:34:56.25-09:30");
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_format_iso(&dt, buf, sizeof(buf), " AKDT"), 27);
+    ASSUME_ITS_EQUAL_CSTR(buf, "2024-06-01T14:34:56.25 AKDT");
+    fossil_time_date_format_iso(&dt, buf, sizeof(buf), "");
+    ASSUME_ITS_EQUAL_CSTR(buf, "2024-06-01T14:34:56.25");
+
+    // Truncates like snprintf, reporting the full length
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_format_iso(&dt, buf, 11, NULL), 28);
+    ASSUME_ITS_EQUAL_CSTR(buf, "2024-06-01");
+}
+
+// Test: widest out-of-range fields plus the longest suffix still fit
+FOSSIL_TEST(c_test_date_format_iso_extremes) {
+    fossil_time_date_t dt;
+    char suffix[65];
+    char buf[192];
+
+    memset(&dt, 0, sizeof(dt));
+    dt.year = -2000000000;
+    dt.month = dt.day = dt.hour = dt.minute = dt.second = -100;
+    dt.millisecond = dt.microsecond = dt.nanosecond = dt.picosecond = -32767;
+    dt.femtosecond = dt.attosecond = dt.zeptosecond = dt.yoctosecond = -32767;
+    dt.precision_mask = ~0ULL;
+    memset(suffix, 'x', 64);
+    suffix[64] = '\0';
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_format_iso(&dt, buf, sizeof(buf), suffix), 149);
+    ASSUME_ITS_TRUE(strncmp(buf, "-2000000000--100--100T-100:-100:-100.-32767", 43) == 0);
+    ASSUME_ITS_TRUE(strcmp(buf + 85, suffix) == 0);
+
+    // One byte more is refused
+    char longer[66];
+    memset(longer, 'x', 65);
+    longer[65] = '\0';
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_format_iso(&dt, buf, sizeof(buf), longer), -1);
+}
+
+// Test: fossil_time_date_parse reads what the formatter writes
+FOSSIL_TEST(c_test_date_parse) {
+    fossil_time_date_t dt;
+    char buf[64];
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01T14:34:56.25+02:00", &dt), 0);
+    ASSUME_ITS_EQUAL_I32(dt.year, 2024);
+    ASSUME_ITS_EQUAL_I32(dt.hour, 14);
+    ASSUME_ITS_EQUAL_I32(dt.millisecond, 250);
+    ASSUME_ITS_EQUAL_I32(dt.tz_offset_min, 120);
+    ASSUME_ITS_EQUAL_I32(dt.weekday, 6);
+    ASSUME_ITS_EQUAL_I32(dt.yearday, 153);
+    ASSUME_ITS_TRUE(dt.precision_mask & FOSSIL_TIME_PRECISION_MILLI);
+    ASSUME_ITS_FALSE(dt.precision_mask & FOSSIL_TIME_PRECISION_MICRO);
+    fossil_time_date_format(&dt, buf, sizeof(buf), "iso");
+    ASSUME_ITS_EQUAL_CSTR(buf, "2024-06-01T14:34:56.25+02:00");
+
+    // Offsets change the instant, not the fields
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01 12:00:00-0330", &dt), 0);
+    ASSUME_ITS_EQUAL_I32(dt.tz_offset_min, -210);
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01T12:00Z", &dt), 0);
+    ASSUME_ITS_FALSE(dt.precision_mask & FOSSIL_TIME_PRECISION_SECOND);
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01T12+05", &dt), 0);
+    ASSUME_ITS_EQUAL_I32(dt.tz_offset_min, 300);
+
+    // Fraction digits fill the sub-second ladder
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01T00:00:00.1234567Z", &dt), 0);
+    ASSUME_ITS_EQUAL_I32(dt.millisecond, 123);
+    ASSUME_ITS_EQUAL_I32(dt.microsecond, 456);
+    ASSUME_ITS_EQUAL_I32(dt.nanosecond, 700);
+    ASSUME_ITS_TRUE(dt.precision_mask & FOSSIL_TIME_PRECISION_NANO);
+    ASSUME_ITS_FALSE(dt.precision_mask & FOSSIL_TIME_PRECISION_PICO);
+
+    // Partial dates
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06", &dt), 0);
+    ASSUME_ITS_EQUAL_I32(dt.month, 6);
+    ASSUME_ITS_FALSE(dt.precision_mask & FOSSIL_TIME_PRECISION_DAY);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-02-30", &dt), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01T25:00:00Z", &dt), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01T12:00:00.Z", &dt), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01T12:00:00+2", &dt), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("2024-06-01x", &dt), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_parse("", &dt), -1);
+}
+
+// Test: batch formatting matches per-row formatting
+FOSSIL_TEST(c_test_date_format_batch) {
+    enum { ROWS = 5, STRIDE = 40 };
+    fossil_time_date_t dates[ROWS];
+    char rows[ROWS * STRIDE];
+    char one[STRIDE];
+
+    for (int i = 0; i < ROWS; ++i) {
+        dates[i] = make_date(2024, 3, 1 + i, 8, 30, i, 0, 0, 0,
+            FOSSIL_TIME_PRECISION_YEAR | FOSSIL_TIME_PRECISION_MONTH | FOSSIL_TIME_PRECISION_DAY |
+            FOSSIL_TIME_PRECISION_HOUR | FOSSIL_TIME_PRECISION_MINUTE | FOSSIL_TIME_PRECISION_SECOND);
+        dates[i].tz_offset_min = (int16_t)(i < 3 ? 60 : 0);
+    }
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_format_batch(dates, ROWS, rows, STRIDE, "iso"), 0);
+    for (int i = 0; i < ROWS; ++i) {
+        fossil_time_date_format(&dates[i], one, sizeof(one), "iso");
+        ASSUME_ITS_EQUAL_CSTR(rows + i * STRIDE, one);
+    }
+    ASSUME_ITS_EQUAL_CSTR(rows + 2 * STRIDE, "2024-03-03T08:30:02+01:00");
+    ASSUME_ITS_EQUAL_CSTR(rows + 3 * STRIDE, "2024-03-04T08:30:03Z");
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_date_format_batch(NULL, 1, rows, STRIDE, "iso"), -1);
+}
+
 // Test: fossil_time_date_format_smart and format_relative
 FOSSIL_TEST(c_test_date_format_smart_relative) {
     fossil_time_date_t now = make_date(2024, 6, 1, 12, 0, 0, 0, 0, 0,
@@ -304,7 +471,12 @@ FOSSIL_TEST_GROUP(c_date_tests) {
     FOSSIL_TEST_ADD(c_date_suite, c_test_date_diff_seconds);
     FOSSIL_TEST_ADD(c_date_suite, c_test_date_to_from_unix_seconds);
     FOSSIL_TEST_ADD(c_date_suite, c_test_date_to_unix_nanoseconds);
+    FOSSIL_TEST_ADD(c_date_suite, c_test_date_from_unix_nanoseconds);
     FOSSIL_TEST_ADD(c_date_suite, c_test_date_format);
+    FOSSIL_TEST_ADD(c_date_suite, c_test_date_format_offset);
+    FOSSIL_TEST_ADD(c_date_suite, c_test_date_format_iso_extremes);
+    FOSSIL_TEST_ADD(c_date_suite, c_test_date_parse);
+    FOSSIL_TEST_ADD(c_date_suite, c_test_date_format_batch);
     FOSSIL_TEST_ADD(c_date_suite, c_test_date_format_smart_relative);
     FOSSIL_TEST_ADD(c_date_suite, c_test_date_search);
     FOSSIL_TEST_ADD(c_date_suite, c_test_date_search_field_comparisons);
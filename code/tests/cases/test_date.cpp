@@ -167,6 +167,20 @@ FOSSIL_TEST(cpp_test_date_format_method) {
     ASSUME_ITS_EQUAL_CSTR(buf, "invalid_date");
 }
 
+// Test: parse() and format_iso() round-trip offsets
+FOSSIL_TEST(cpp_test_date_parse_method) {
+    Date d;
+    char buf[64];
+
+    ASSUME_ITS_TRUE(d.parse("2024-11-03T01:30:00-04:00"));
+    ASSUME_ITS_EQUAL_I32(d.raw.tz_offset_min, -240);
+    d.format(buf, sizeof(buf), "iso");
+    ASSUME_ITS_EQUAL_CSTR(buf, "2024-11-03T01:30:00-04:00");
+    d.format_iso(buf, sizeof(buf), " EDT");
+    ASSUME_ITS_EQUAL_CSTR(buf, "2024-11-03T01:30:00 EDT");
+    ASSUME_ITS_FALSE(d.parse("yesterday"));
+}
+
 // Test: format_smart() and format_relative()
 FOSSIL_TEST(cpp_test_date_format_smart_relative_method) {
     Date now = make_cpp_date(2024, 6, 1, 12, 0, 0, 0, 0, 0,
@@ -311,6 +325,7 @@ FOSSIL_TEST_GROUP(cpp_date_tests) {
     FOSSIL_TEST_ADD(cpp_date_suite, cpp_test_date_to_from_unix_seconds_method);
     FOSSIL_TEST_ADD(cpp_date_suite, cpp_test_date_to_unix_nanoseconds_method);
     FOSSIL_TEST_ADD(cpp_date_suite, cpp_test_date_format_method);
+    FOSSIL_TEST_ADD(cpp_date_suite, cpp_test_date_parse_method);
     FOSSIL_TEST_ADD(cpp_date_suite, cpp_test_date_format_smart_relative_method);
     FOSSIL_TEST_ADD(cpp_date_suite, cpp_test_date_search_method);
     FOSSIL_TEST_ADD(cpp_date_suite, cpp_test_date_roundtrip_subsecond);
@@ -0,0 +1,160 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(c_index_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(c_index_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(c_index_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Helper: reference lower bound by linear scan
+static size_t linear_lower_bound(const int64_t *v, size_t n, int64_t key) {
+    size_t i = 0;
+    while (i < n && v[i] < key) i++;
+    return i;
+}
+
+// Helper: reference upper bound by linear scan
+static size_t linear_upper_bound(const int64_t *v, size_t n, int64_t key) {
+    size_t i = 0;
+    while (i < n && v[i] <= key) i++;
+    return i;
+}
+
+// Test: lower/upper bound agree with a linear scan, including duplicates
+FOSSIL_TEST(c_test_index_bounds_match_linear) {
+    int64_t values[100];
+    for (size_t i = 0; i < 100; ++i)
+        values[i] = (int64_t)(i / 3) * 10; // runs of three equal keys
+
+    fossil_time_index_t index;
+    memset(&index, 0, sizeof(index));
+    ASSUME_ITS_EQUAL_I32(fossil_time_index_build(&index, values, 100), 0);
+    ASSUME_ITS_EQUAL_U64(index.count, 100);
+
+    for (int64_t key = -5; key <= 345; ++key) {
+        ASSUME_ITS_EQUAL_U64(fossil_time_index_lower_bound(&index, key),
+                             linear_lower_bound(values, 100, key));
+        ASSUME_ITS_EQUAL_U64(fossil_time_index_upper_bound(&index, key),
+                             linear_upper_bound(values, 100, key));
+    }
+
+    fossil_time_index_free(&index);
+    ASSUME_ITS_EQUAL_U64(index.count, 0);
+}
+
+// Test: every size up to 40 keeps the Eytzinger mapping consistent
+FOSSIL_TEST(c_test_index_all_small_sizes) {
+    int64_t values[40];
+    for (size_t i = 0; i < 40; ++i)
+        values[i] = (int64_t)i * 2;
+
+    for (size_t n = 1; n <= 40; ++n) {
+        fossil_time_index_t index;
+        memset(&index, 0, sizeof(index));
+        ASSUME_ITS_EQUAL_I32(fossil_time_index_build(&index, values, n), 0);
+        for (int64_t key = -1; key <= (int64_t)n * 2; ++key) {
+            ASSUME_ITS_EQUAL_U64(fossil_time_index_lower_bound(&index, key),
+                                 linear_lower_bound(values, n, key));
+        }
+        fossil_time_index_free(&index);
+    }
+}
+
+// Test: nearest picks the closest key, earlier on ties
+FOSSIL_TEST(c_test_index_nearest) {
+    int64_t values[] = { 100, 200, 200, 200, 400, 1000 };
+    fossil_time_index_t index;
+    memset(&index, 0, sizeof(index));
+    ASSUME_ITS_EQUAL_I32(fossil_time_index_build(&index, values, 6), 0);
+
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_nearest(&index, 0), 0);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_nearest(&index, 149), 0);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_nearest(&index, 150), 0);   // tie -> earlier
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_nearest(&index, 151), 1);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_nearest(&index, 299), 1);   // first of the run
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_nearest(&index, 301), 4);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_nearest(&index, 5000), 5);
+
+    fossil_time_index_free(&index);
+}
+
+// Test: unsorted input and empty indexes are handled
+FOSSIL_TEST(c_test_index_invalid_and_empty) {
+    int64_t unsorted[] = { 3, 1, 2 };
+    fossil_time_index_t index;
+    memset(&index, 0, sizeof(index));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_index_build(&index, unsorted, 3), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_index_build(NULL, unsorted, 3), -1);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_index_build(&index, NULL, 0), 0);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_lower_bound(&index, 5), 0);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_upper_bound(&index, 5), 0);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_nearest(&index, 5), 0);
+    fossil_time_index_free(&index);
+}
+
+// Test: build from dates converts through epoch nanoseconds
+FOSSIL_TEST(c_test_index_build_dates) {
+    fossil_time_date_t dates[3];
+    for (int i = 0; i < 3; ++i) {
+        fossil_time_date_from_unix_seconds(1700000000 + i * 60, &dates[i]);
+    }
+
+    fossil_time_index_t index;
+    memset(&index, 0, sizeof(index));
+    ASSUME_ITS_EQUAL_I32(fossil_time_index_build_dates(&index, dates, 3), 0);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_lower_bound(&index, 1700000060LL * 1000000000LL), 1);
+    ASSUME_ITS_EQUAL_U64(fossil_time_index_upper_bound(&index, 1700000060LL * 1000000000LL), 2);
+    fossil_time_index_free(&index);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_index_tests) {
+    FOSSIL_TEST_ADD(c_index_suite, c_test_index_bounds_match_linear);
+    FOSSIL_TEST_ADD(c_index_suite, c_test_index_all_small_sizes);
+    FOSSIL_TEST_ADD(c_index_suite, c_test_index_nearest);
+    FOSSIL_TEST_ADD(c_index_suite, c_test_index_invalid_and_empty);
+    FOSSIL_TEST_ADD(c_index_suite, c_test_index_build_dates);
+
+    FOSSIL_TEST_REGISTER(c_index_suite);
+}
@@ -0,0 +1,92 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(cpp_index_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(cpp_index_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(cpp_index_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+using fossil::time::Index;
+using fossil::time::Date;
+
+// Test: Index wrapper builds and answers bound queries
+FOSSIL_TEST(cpp_test_index_bounds) {
+    int64_t values[] = { 10, 20, 20, 30, 40 };
+    Index index;
+    ASSUME_ITS_TRUE(index.build(values, 5));
+    ASSUME_ITS_EQUAL_U64(index.size(), 5);
+    ASSUME_ITS_EQUAL_U64(index.lower_bound(20), 1);
+    ASSUME_ITS_EQUAL_U64(index.upper_bound(20), 3);
+    ASSUME_ITS_EQUAL_U64(index.lower_bound(41), 5);
+    ASSUME_ITS_EQUAL_U64(index.upper_bound(5), 0);
+}
+
+// Test: Index wrapper nearest lookup
+FOSSIL_TEST(cpp_test_index_nearest) {
+    int64_t values[] = { 10, 20, 30 };
+    Index index;
+    ASSUME_ITS_TRUE(index.build(values, 3));
+    ASSUME_ITS_EQUAL_U64(index.nearest(24), 1);
+    ASSUME_ITS_EQUAL_U64(index.nearest(26), 2);
+    ASSUME_ITS_EQUAL_U64(index.nearest(25), 1);
+    ASSUME_ITS_EQUAL_U64(index.nearest(-100), 0);
+}
+
+// Test: Index wrapper rejects unsorted input and accepts Date arrays
+FOSSIL_TEST(cpp_test_index_dates_and_unsorted) {
+    int64_t unsorted[] = { 2, 1 };
+    Index index;
+    ASSUME_ITS_FALSE(index.build(unsorted, 2));
+
+    Date dates[2] = { Date(2024, 1, 1), Date(2024, 1, 2) };
+    ASSUME_ITS_TRUE(index.build(dates, 2));
+    ASSUME_ITS_EQUAL_U64(index.lower_bound(dates[1].to_unix_nanoseconds()), 1);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_index_tests) {
+    FOSSIL_TEST_ADD(cpp_index_suite, cpp_test_index_bounds);
+    FOSSIL_TEST_ADD(cpp_index_suite, cpp_test_index_nearest);
+    FOSSIL_TEST_ADD(cpp_index_suite, cpp_test_index_dates_and_unsorted);
+
+    FOSSIL_TEST_REGISTER(cpp_index_suite);
+}
@@ -0,0 +1,277 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(c_leap_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(c_leap_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(c_leap_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+#define LEAP_NS 1000000000LL
+#define LEAP_2017 1483228800LL /* 2017-01-01T00:00:00Z, TAI−UTC becomes 37 */
+
+// Test: built-in table offsets around known leap seconds
+FOSSIL_TEST(c_test_leap_offsets) {
+    int64_t at;
+    int32_t delta;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(0), 10);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(63072000LL), 10);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(78796799LL), 10);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(78796800LL), 11);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(LEAP_2017 - 1), 36);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(LEAP_2017), 37);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(1767225600LL), 37);
+    ASSUME_ITS_TRUE(fossil_time_leap_count() >= 28);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_next(LEAP_2017 - 100, &at, &delta), 0);
+    ASSUME_ITS_EQUAL_I64(at, LEAP_2017);
+    ASSUME_ITS_EQUAL_I32(delta, 1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_prev(LEAP_2017 + 100, &at, &delta), 0);
+    ASSUME_ITS_EQUAL_I64(at, LEAP_2017);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_prev(LEAP_2017, &at, NULL), 0);
+    ASSUME_ITS_EQUAL_I64(at, LEAP_2017);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_next(0, &at, NULL), 0);
+    ASSUME_ITS_EQUAL_I64(at, 78796800LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_prev(70000000LL, &at, NULL), -1);
+}
+
+// Test: UTC, TAI and GPS conversions, including the repeated second
+FOSSIL_TEST(c_test_leap_convert) {
+    int64_t utc = LEAP_2017 * LEAP_NS;
+
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_utc_to_tai(utc), utc + 37 * LEAP_NS);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_utc_to_tai(utc - 1), utc - 1 + 36 * LEAP_NS);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_tai_to_utc(utc + 37 * LEAP_NS), utc);
+
+    // 23:59:59 and the inserted 23:59:60 both map to 23:59:59 UTC
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_tai_to_utc(utc + 35 * LEAP_NS), utc - LEAP_NS);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_tai_to_utc(utc + 36 * LEAP_NS + 500000000LL),
+                         utc - LEAP_NS + 500000000LL);
+
+    // GPS epoch, and GPS runs 19 s behind TAI
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_utc_to_gps(315964800LL * LEAP_NS), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_gps_to_utc(0), 315964800LL * LEAP_NS);
+    ASSUME_ITS_EQUAL_I64(
+        fossil_time_leap_convert(utc, FOSSIL_TIME_SCALE_TAI, FOSSIL_TIME_SCALE_GPS),
+        utc - (315964800LL + 19) * LEAP_NS);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_gps_to_utc(fossil_time_leap_utc_to_gps(utc)), utc);
+
+    // Before 1972 the 1972 offset applies; negative instants floor correctly
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_utc_to_tai(-1), -1 + 10 * LEAP_NS);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_convert(5, FOSSIL_TIME_SCALE_GPS, FOSSIL_TIME_SCALE_GPS), 5);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_convert(5, (fossil_time_scale_t)9, FOSSIL_TIME_SCALE_UTC), INT64_MIN);
+
+    // Shifts past the int64 range report INT64_MIN instead of wrapping
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_utc_to_tai(INT64_MAX), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_utc_to_tai(INT64_MAX - 37 * LEAP_NS), INT64_MAX);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_gps_to_utc(INT64_MAX), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_utc_to_gps(INT64_MIN), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_tai_to_utc(INT64_MIN + 9 * LEAP_NS), INT64_MIN);
+}
+
+// Test: batch conversion matches the scalar path across leap seconds
+FOSSIL_TEST(c_test_leap_convert_batch) {
+    enum { ROWS = 512 };
+    int64_t in[ROWS], out[ROWS];
+    const fossil_time_scale_t scales[] = {
+        FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_TAI, FOSSIL_TIME_SCALE_GPS
+    };
+
+    // Hourly steps around 2015-07-01 and 2017-01-01, plus a jump back
+    for (int i = 0; i < ROWS; ++i) {
+        int64_t base = (i < ROWS / 2 ? 1435708800LL : LEAP_2017) - 128 * 3600;
+        in[i] = (base + (int64_t)(i % (ROWS / 2)) * 3600) * LEAP_NS + i;
+    }
+    // Rows at the range ends overflow some shifts; both paths report INT64_MIN
+    in[1] = INT64_MAX;
+    in[ROWS - 2] = INT64_MIN;
+
+    for (int f = 0; f < 3; ++f) {
+        for (int t = 0; t < 3; ++t) {
+            ASSUME_ITS_EQUAL_I32(fossil_time_leap_convert_batch(in, ROWS, scales[f], scales[t], out), 0);
+            for (int i = 0; i < ROWS; ++i)
+                ASSUME_ITS_EQUAL_I64(out[i], fossil_time_leap_convert(in[i], scales[f], scales[t]));
+        }
+    }
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_convert_batch(in, ROWS, FOSSIL_TIME_SCALE_UTC,
+                                                        FOSSIL_TIME_SCALE_TAI, out), 0);
+    ASSUME_ITS_EQUAL_I64(out[1], INT64_MIN);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_convert_batch(NULL, 1, FOSSIL_TIME_SCALE_UTC,
+                                                        FOSSIL_TIME_SCALE_TAI, out), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_convert_batch(NULL, 0, FOSSIL_TIME_SCALE_UTC,
+                                                        FOSSIL_TIME_SCALE_TAI, NULL), 0);
+}
+
+// Test: 23:59:60 is only valid where a leap second was inserted
+FOSSIL_TEST(c_test_leap_second_valid) {
+    fossil_time_date_t dt = {0};
+
+    dt.year = 2016; dt.month = 12; dt.day = 31;
+    dt.hour = 23; dt.minute = 59; dt.second = 60;
+    ASSUME_ITS_TRUE(fossil_time_leap_second_valid(&dt));
+
+    dt.year = 2017; dt.month = 1; dt.day = 1;
+    dt.hour = 0; dt.tz_offset_min = 60;
+    ASSUME_ITS_TRUE(fossil_time_leap_second_valid(&dt));
+
+    dt.tz_offset_min = 0;
+    ASSUME_ITS_FALSE(fossil_time_leap_second_valid(&dt));
+
+    dt.year = 2018; dt.month = 12; dt.day = 31; dt.hour = 23;
+    ASSUME_ITS_FALSE(fossil_time_leap_second_valid(&dt));
+
+    dt.year = 2016; dt.second = 59;
+    ASSUME_ITS_FALSE(fossil_time_leap_second_valid(&dt));
+    ASSUME_ITS_FALSE(fossil_time_leap_second_valid(NULL));
+}
+
+// Test: loading the system leap-seconds.list, then restoring the built-in table
+FOSSIL_TEST(c_test_leap_load) {
+    size_t builtin = fossil_time_leap_count();
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_load("/nonexistent/leap-seconds.list"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_load(NULL), -1);
+    ASSUME_ITS_TRUE(fossil_time_leap_count() == builtin);
+
+    int n = fossil_time_leap_load("/usr/share/zoneinfo/leap-seconds.list");
+    if (n < 0) return;
+
+    ASSUME_ITS_TRUE(n >= 28);
+    ASSUME_ITS_TRUE(fossil_time_leap_count() == (size_t)n);
+    ASSUME_ITS_TRUE(fossil_time_leap_expires() > LEAP_2017);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(LEAP_2017), 37);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_tai_offset(63072000LL), 10);
+
+    fossil_time_leap_reset();
+    ASSUME_ITS_TRUE(fossil_time_leap_count() == builtin);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_expires(), 1782604800LL);
+}
+
+// Test: a 24 h smear spreads the 2016 leap second with no step or :60
+FOSSIL_TEST(c_test_leap_smear) {
+    const int64_t start = (LEAP_2017 - 43200) * LEAP_NS;
+    const int64_t end = (LEAP_2017 + 43200) * LEAP_NS;
+    int64_t prev = INT64_MIN;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_set_smear(1), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_set_smear(8 * 86400LL), -1);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_smear_window(), 0);
+
+    // Off: the smeared scale is plain UTC
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_convert(LEAP_2017 * LEAP_NS, FOSSIL_TIME_SCALE_UTC,
+                                                  FOSSIL_TIME_SCALE_SMEAR), LEAP_2017 * LEAP_NS);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_set_smear(86400), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_smear_window(), 86400);
+
+    // Window edges match UTC; midnight is 43201 real seconds in at 86400/86401 speed
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_convert(start, FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_SMEAR), start);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_convert(end, FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_SMEAR), end);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_convert(start - LEAP_NS, FOSSIL_TIME_SCALE_UTC,
+                                                  FOSSIL_TIME_SCALE_SMEAR), start - LEAP_NS);
+    ASSUME_ITS_EQUAL_I64(fossil_time_leap_convert(LEAP_2017 * LEAP_NS, FOSSIL_TIME_SCALE_UTC,
+                                                  FOSSIL_TIME_SCALE_SMEAR), LEAP_2017 * LEAP_NS + 499994214LL);
+
+    // Real time through the window: smeared time only moves forward and
+    // maps back to within the nanosecond it came from
+    for (int64_t tai = start + 36 * LEAP_NS; tai <= end + 37 * LEAP_NS; tai += 997 * 1000000LL) {
+        int64_t s = fossil_time_leap_convert(tai, FOSSIL_TIME_SCALE_TAI, FOSSIL_TIME_SCALE_SMEAR);
+        ASSUME_ITS_TRUE(s > prev);
+        int64_t back = fossil_time_leap_convert(s, FOSSIL_TIME_SCALE_SMEAR, FOSSIL_TIME_SCALE_TAI);
+        ASSUME_ITS_TRUE(back <= tai && back >= tai - 1);
+        prev = s;
+    }
+    ASSUME_ITS_TRUE(prev <= end);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_set_smear(0), 0);
+}
+
+// Test: with smearing on, dates are smeared civil time and never read :60
+FOSSIL_TEST(c_test_leap_smear_dates) {
+    fossil_time_date_t dt;
+    int64_t utc = (LEAP_2017 - 1) * LEAP_NS + 750000000LL;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_set_smear(1000), 0);
+
+    // 23:59:59.75 UTC reads a quarter second earlier in the smear
+    fossil_time_date_from_unix_nanoseconds(utc, &dt);
+    ASSUME_ITS_EQUAL_I32(dt.second, 59);
+    ASSUME_ITS_EQUAL_I32(dt.millisecond, 250);
+    int64_t back = fossil_time_date_to_unix_nanoseconds(&dt) - utc;
+    ASSUME_ITS_TRUE(back >= -1 && back <= 1);
+
+    fossil_time_date_from_unix_seconds(LEAP_2017, &dt);
+    ASSUME_ITS_EQUAL_I32(dt.day, 1);
+    ASSUME_ITS_EQUAL_I32(dt.second, 0);
+
+    fossil_time_date_now(&dt);
+    ASSUME_ITS_TRUE(dt.second < 60);
+    ASSUME_ITS_TRUE(dt.year >= 2024);
+
+    // Past the int64 nanosecond range the smear is a no-op, not an overflow
+    fossil_time_date_from_unix_seconds(32503680000LL, &dt);
+    ASSUME_ITS_EQUAL_I32(dt.year, 3000);
+    ASSUME_ITS_EQUAL_I32(dt.second, 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_date_to_unix_seconds(&dt), 32503680000LL);
+    fossil_time_date_from_unix_seconds(-30610224000LL, &dt);
+    ASSUME_ITS_EQUAL_I32(dt.year, 1000);
+    ASSUME_ITS_EQUAL_I64(fossil_time_date_to_unix_seconds(&dt), -30610224000LL);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_leap_set_smear(0), 0);
+    fossil_time_date_from_unix_nanoseconds(utc, &dt);
+    ASSUME_ITS_EQUAL_I32(dt.millisecond, 750);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_leap_tests) {
+    FOSSIL_TEST_ADD(c_leap_suite, c_test_leap_offsets);
+    FOSSIL_TEST_ADD(c_leap_suite, c_test_leap_convert);
+    FOSSIL_TEST_ADD(c_leap_suite, c_test_leap_convert_batch);
+    FOSSIL_TEST_ADD(c_leap_suite, c_test_leap_second_valid);
+    FOSSIL_TEST_ADD(c_leap_suite, c_test_leap_load);
+    FOSSIL_TEST_ADD(c_leap_suite, c_test_leap_smear);
+    FOSSIL_TEST_ADD(c_leap_suite, c_test_leap_smear_dates);
+
+    FOSSIL_TEST_REGISTER(c_leap_suite);
+}
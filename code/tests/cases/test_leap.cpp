@@ -0,0 +1,83 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(cpp_leap_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(cpp_leap_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(cpp_leap_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+using fossil::time::Leap;
+using fossil::time::Date;
+
+// Test: Leap wrapper forwards to the C table and conversions
+FOSSIL_TEST(cpp_test_leap_wrapper) {
+    const int64_t utc = 1483228800LL * 1000000000LL;
+
+    ASSUME_ITS_EQUAL_I32(Leap::tai_offset(1483228800LL), 37);
+    ASSUME_ITS_EQUAL_I64(Leap::utc_to_tai(utc), utc + 37000000000LL);
+    ASSUME_ITS_EQUAL_I64(Leap::tai_to_utc(Leap::utc_to_tai(utc)), utc);
+    ASSUME_ITS_EQUAL_I64(Leap::gps_to_utc(Leap::utc_to_gps(utc)), utc);
+    ASSUME_ITS_EQUAL_I64(Leap::convert(utc, FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_GPS),
+                         Leap::utc_to_gps(utc));
+
+    int64_t col[2] = { utc, utc - 1 };
+    ASSUME_ITS_TRUE(Leap::convert(col, 2, FOSSIL_TIME_SCALE_UTC, FOSSIL_TIME_SCALE_TAI, col));
+    ASSUME_ITS_EQUAL_I64(col[0], utc + 37000000000LL);
+    ASSUME_ITS_EQUAL_I64(col[1], utc - 1 + 36000000000LL);
+
+    Date dt;
+    ASSUME_ITS_TRUE(dt.parse("2016-12-31T23:59:59Z"));
+    dt.raw.second = 60;
+    ASSUME_ITS_TRUE(Leap::second_valid(dt));
+
+    ASSUME_ITS_FALSE(Leap::set_smear(-5));
+    ASSUME_ITS_TRUE(Leap::set_smear(86400));
+    ASSUME_ITS_EQUAL_I64(Leap::smear_window(), 86400);
+    ASSUME_ITS_TRUE(Leap::set_smear(0));
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_leap_tests) {
+    FOSSIL_TEST_ADD(cpp_leap_suite, cpp_test_leap_wrapper);
+
+    FOSSIL_TEST_REGISTER(cpp_leap_suite);
+}
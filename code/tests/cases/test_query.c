@@ -0,0 +1,361 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+#include <string.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(c_query_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(c_query_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(c_query_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Helper: build a full-precision UTC date
+static fossil_time_date_t make_utc(int year, int month, int day, int hour, int min, int sec) {
+    fossil_time_date_t dt;
+    memset(&dt, 0, sizeof(dt));
+    dt.year = year;
+    dt.month = month;
+    dt.day = day;
+    dt.hour = hour;
+    dt.minute = min;
+    dt.second = sec;
+    dt.precision_mask = FOSSIL_TIME_PRECISION_YEAR | FOSSIL_TIME_PRECISION_MONTH |
+                        FOSSIL_TIME_PRECISION_DAY | FOSSIL_TIME_PRECISION_HOUR |
+                        FOSSIL_TIME_PRECISION_MINUTE | FOSSIL_TIME_PRECISION_SECOND;
+    fossil_time_calendar_compute_derived(&dt);
+    return dt;
+}
+
+// Helper: epoch ns for a UTC civil time
+static int64_t utc_ns(int year, int month, int day, int hour, int min, int sec) {
+    fossil_time_date_t dt = make_utc(year, month, day, hour, min, sec);
+    return fossil_time_date_to_unix_nanoseconds(&dt);
+}
+
+// Test: calendar-aligned periods resolve to exact [start, end) ranges
+FOSSIL_TEST(c_test_query_calendar_periods) {
+    fossil_time_date_t now = make_utc(2024, 6, 5, 12, 0, 0); // Wednesday
+    fossil_time_query_t q;
+    int64_t start, end;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "this week", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2024, 6, 3, 0, 0, 0));
+    ASSUME_ITS_EQUAL_I64(end, utc_ns(2024, 6, 10, 0, 0, 0));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "this month", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2024, 6, 1, 0, 0, 0));
+    ASSUME_ITS_EQUAL_I64(end, utc_ns(2024, 7, 1, 0, 0, 0));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "previous quarter", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2024, 1, 1, 0, 0, 0));
+    ASSUME_ITS_EQUAL_I64(end, utc_ns(2024, 4, 1, 0, 0, 0));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "next year", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2025, 1, 1, 0, 0, 0));
+    ASSUME_ITS_EQUAL_I64(end, utc_ns(2026, 1, 1, 0, 0, 0));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "yesterday", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2024, 6, 4, 0, 0, 0));
+    ASSUME_ITS_EQUAL_I64(end, utc_ns(2024, 6, 5, 0, 0, 0));
+}
+
+// Test: rolling windows end or start exactly at now
+FOSSIL_TEST(c_test_query_rolling_windows) {
+    fossil_time_date_t now = make_utc(2024, 3, 31, 12, 0, 0);
+    fossil_time_query_t q;
+    int64_t start, end;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "last 7 days", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2024, 3, 24, 12, 0, 0));
+    ASSUME_ITS_EQUAL_I64(end, utc_ns(2024, 3, 31, 12, 0, 0));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "next 2 hours", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2024, 3, 31, 12, 0, 0));
+    ASSUME_ITS_EQUAL_I64(end, utc_ns(2024, 3, 31, 14, 0, 0));
+
+    // Month arithmetic clamps to the end of shorter months
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "Past 1 Month", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2024, 2, 29, 12, 0, 0));
+}
+
+// Test: periods honor the timezone offset of now
+FOSSIL_TEST(c_test_query_now_offset) {
+    fossil_time_date_t now = make_utc(2024, 6, 5, 1, 0, 0);
+    now.tz_offset_min = 120; // local 01:00 is 23:00 UTC the previous day
+    fossil_time_query_t q;
+    int64_t start, end;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "today", &now), 0);
+    ASSUME_ITS_TRUE(fossil_time_query_bounds(&q, &start, &end));
+    ASSUME_ITS_EQUAL_I64(start, utc_ns(2024, 6, 4, 22, 0, 0));
+    ASSUME_ITS_EQUAL_I64(end, utc_ns(2024, 6, 5, 22, 0, 0));
+}
+
+// Test: compound queries evaluate every clause
+FOSSIL_TEST(c_test_query_match_compound) {
+    fossil_time_date_t now = make_utc(2024, 6, 5, 12, 0, 0);
+    fossil_time_query_t q;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "weekday and hour >= 9 and last 30 days", &now), 0);
+    ASSUME_ITS_EQUAL_U64(q.clause_count, 3);
+
+    fossil_time_date_t dt = make_utc(2024, 6, 4, 10, 0, 0); // Tuesday
+    ASSUME_ITS_TRUE(fossil_time_query_match(&q, &dt));
+    ASSUME_ITS_TRUE(fossil_time_query_match_ns(&q, fossil_time_date_to_unix_nanoseconds(&dt)));
+
+    dt = make_utc(2024, 6, 1, 10, 0, 0); // Saturday
+    ASSUME_ITS_FALSE(fossil_time_query_match(&q, &dt));
+    ASSUME_ITS_FALSE(fossil_time_query_match_ns(&q, fossil_time_date_to_unix_nanoseconds(&dt)));
+
+    dt = make_utc(2024, 6, 4, 8, 0, 0); // too early
+    ASSUME_ITS_FALSE(fossil_time_query_match(&q, &dt));
+
+    dt = make_utc(2024, 4, 2, 10, 0, 0); // outside the window
+    ASSUME_ITS_FALSE(fossil_time_query_match(&q, &dt));
+}
+
+// Test: context-free clauses compile without now; relative ones do not
+FOSSIL_TEST(c_test_query_compile_errors) {
+    fossil_time_query_t q;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "year in 2020..2025", NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "month is not 2", NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "last 7 days", NULL), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "foo = 1", NULL), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "year and", NULL), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "", NULL), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(NULL, "year = 1", NULL), -1);
+}
+
+// Test: date search accepts the new relative windows
+FOSSIL_TEST(c_test_query_via_date_search) {
+    fossil_time_date_t now = make_utc(2024, 6, 5, 12, 0, 0);
+    fossil_time_date_t dt = make_utc(2024, 6, 3, 0, 0, 0);
+
+    ASSUME_ITS_TRUE(fossil_time_date_search(&dt, &now, "this week"));
+    ASSUME_ITS_TRUE(fossil_time_date_search(&dt, &now, "last 3 days"));
+    ASSUME_ITS_FALSE(fossil_time_date_search(&dt, &now, "last 2 days"));
+    ASSUME_ITS_FALSE(fossil_time_date_search(&dt, &now, "next 2 days"));
+}
+
+// Test: parallel scans agree with the serial scan for any worker count
+FOSSIL_TEST(c_test_query_scan_workers) {
+    enum { ROWS = 40000 };
+    static int64_t ns[ROWS];
+    static uint64_t serial[(ROWS + 63) / 64];
+    static uint64_t parallel[(ROWS + 63) / 64];
+    static size_t index[ROWS];
+    fossil_time_query_t q;
+    const size_t workers[] = { 2, 3, 4, 0 };
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "hour >= 9 and hour < 17", NULL), 0);
+
+    for (size_t i = 0; i < ROWS; ++i)
+        ns[i] = (int64_t)i * 3599LL * 1000000000LL; // just under an hour apart
+
+    int64_t expected = fossil_time_query_scan_ns(&q, ns, ROWS, 1, serial);
+    ASSUME_ITS_TRUE(expected > 0);
+
+    int64_t counted = 0;
+    for (size_t i = 0; i < ROWS; ++i)
+        counted += fossil_time_query_match_ns(&q, ns[i]) ? 1 : 0;
+    ASSUME_ITS_EQUAL_I64(expected, counted);
+
+    for (size_t w = 0; w < sizeof(workers) / sizeof(workers[0]); ++w) {
+        memset(parallel, 0xff, sizeof(parallel));
+        ASSUME_ITS_EQUAL_I64(fossil_time_query_scan_ns(&q, ns, ROWS, workers[w], parallel), expected);
+        ASSUME_ITS_TRUE(memcmp(serial, parallel, sizeof(serial)) == 0);
+
+        ASSUME_ITS_EQUAL_I64(fossil_time_query_select_ns(&q, ns, ROWS, workers[w], index), expected);
+        for (int64_t k = 0; k < expected; ++k) {
+            size_t row = index[k];
+            ASSUME_ITS_TRUE(serial[row / 64] & (1ULL << (row % 64)));
+            if (k > 0)
+                ASSUME_ITS_TRUE(index[k - 1] < row);
+        }
+    }
+}
+
+// Test: date-array scans and argument checks
+FOSSIL_TEST(c_test_query_scan_dates) {
+    fossil_time_date_t dates[5];
+    uint64_t bitmap[1] = { 0 };
+    size_t index[5];
+    fossil_time_query_t q;
+
+    dates[0] = make_utc(2023, 12, 31, 0, 0, 0);
+    dates[1] = make_utc(2024, 1, 1, 0, 0, 0);
+    dates[2] = make_utc(2024, 7, 4, 0, 0, 0);
+    dates[3] = make_utc(2025, 1, 1, 0, 0, 0);
+    dates[4] = make_utc(2024, 12, 31, 23, 59, 59);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "year = 2024", NULL), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_query_scan_dates(&q, dates, 5, 0, bitmap), 3);
+    ASSUME_ITS_EQUAL_I64((int64_t)bitmap[0], 0x16);
+
+    ASSUME_ITS_EQUAL_I64(fossil_time_query_select_dates(&q, dates, 5, 4, index), 3);
+    ASSUME_ITS_EQUAL_I64((int64_t)index[0], 1);
+    ASSUME_ITS_EQUAL_I64((int64_t)index[1], 2);
+    ASSUME_ITS_EQUAL_I64((int64_t)index[2], 4);
+
+    ASSUME_ITS_EQUAL_I64(fossil_time_query_scan_dates(&q, dates, 0, 0, NULL), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_query_scan_dates(&q, dates, 5, 0, NULL), -1);
+    ASSUME_ITS_EQUAL_I64(fossil_time_query_select_ns(NULL, NULL, 0, 0, NULL), -1);
+}
+
+// Test: calendar clauses agree with the holiday registry and calendar regions
+FOSSIL_TEST(c_test_query_calendar_sets) {
+    fossil_time_query_t holiday, business, us;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&holiday, "holiday", NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&business, "business day", NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&us, "holiday us", NULL), 0);
+
+    for (int m = 1; m <= 12; ++m) {
+        for (int d = 1; d <= fossil_time_calendar_days_in_month(2024, m); ++d) {
+            fossil_time_date_t dt = make_utc(2024, m, d, 12, 0, 0);
+            fossil_time_calendar_compute_derived(&dt);
+
+            int is_holiday = fossil_holiday_is(&dt, NULL);
+            int is_weekend = dt.weekday == 0 || dt.weekday == 6;
+            ASSUME_ITS_EQUAL_I32(fossil_time_query_match(&holiday, &dt), is_holiday);
+            ASSUME_ITS_EQUAL_I32(fossil_time_query_match(&business, &dt), !is_holiday && !is_weekend);
+            ASSUME_ITS_EQUAL_I32(fossil_time_query_match(&us, &dt),
+                                 fossil_time_calendar_is_holiday(&dt, "us"));
+        }
+    }
+}
+
+// Test: business-day-of-month, quarter and negated calendar clauses
+FOSSIL_TEST(c_test_query_business_days) {
+    fossil_time_query_t q;
+    fossil_time_date_t dt;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "last business day of month", NULL), 0);
+    dt = make_utc(2024, 5, 31, 9, 0, 0); // Friday
+    ASSUME_ITS_TRUE(fossil_time_query_match(&q, &dt));
+    dt = make_utc(2024, 8, 30, 9, 0, 0); // Friday before a weekend month end
+    ASSUME_ITS_TRUE(fossil_time_query_match_ns(&q, fossil_time_date_to_unix_nanoseconds(&dt)));
+    dt = make_utc(2024, 8, 31, 9, 0, 0);
+    ASSUME_ITS_FALSE(fossil_time_query_match(&q, &dt));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "first business day of month us", NULL), 0);
+    dt = make_utc(2024, 9, 3, 9, 0, 0); // day after Labor Day
+    ASSUME_ITS_TRUE(fossil_time_query_match(&q, &dt));
+    dt = make_utc(2024, 9, 2, 9, 0, 0);
+    ASSUME_ITS_FALSE(fossil_time_query_match(&q, &dt));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "quarter = 2 and not business day uk", NULL), 0);
+    dt = make_utc(2024, 6, 1, 9, 0, 0); // Saturday
+    ASSUME_ITS_TRUE(fossil_time_query_match(&q, &dt));
+    dt = make_utc(2024, 6, 3, 9, 0, 0);
+    ASSUME_ITS_FALSE(fossil_time_query_match(&q, &dt));
+    dt = make_utc(2024, 7, 6, 9, 0, 0);
+    ASSUME_ITS_FALSE(fossil_time_query_match(&q, &dt));
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "holiday mars", NULL), -1);
+}
+
+// Test: profiling counts evaluations and passes per clause, across workers
+FOSSIL_TEST(c_test_query_profile) {
+    enum { ROWS = 1000 };
+    int64_t ns[ROWS];
+    uint64_t bitmap[(ROWS + 63) / 64];
+    fossil_time_query_t q;
+    fossil_time_query_stats_t stats;
+
+    for (size_t i = 0; i < ROWS; ++i)
+        ns[i] = (int64_t)i * 3600LL * 1000000000LL;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_compile(&q, "weekday and hour >= 9", NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_profile(&q, &stats), 0);
+
+    int64_t single = 0;
+    for (size_t i = 0; i < ROWS; ++i)
+        single += fossil_time_query_match_ns(&q, ns[i]) ? 1 : 0;
+    int64_t scanned = fossil_time_query_scan_ns(&q, ns, ROWS, 2, bitmap);
+    ASSUME_ITS_EQUAL_I64(single, scanned);
+
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.records, 2 * ROWS);
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.matched, 2 * single);
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.clauses[0].evaluations, 2 * ROWS);
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.clauses[1].evaluations, (int64_t)stats.clauses[0].passed);
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.clauses[1].passed, (int64_t)stats.matched);
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.clauses[2].evaluations, 0);
+
+    char buf[512];
+    int len = fossil_time_query_explain(&q, buf, sizeof(buf));
+    ASSUME_ITS_EQUAL_I32(len, fossil_time_query_explain(&q, NULL, 0));
+    ASSUME_ITS_TRUE(len > 0 && (size_t)len < sizeof(buf));
+    ASSUME_ITS_TRUE(strstr(buf, "clause 0: field weekday in [1, 6) evals=2000") != NULL);
+    ASSUME_ITS_TRUE(strstr(buf, "clause 1: field hour in [9, +inf)") != NULL);
+    ASSUME_ITS_TRUE(strstr(buf, "total: records=2000") != NULL);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_query_profile(&q, NULL), 0);
+    fossil_time_query_match_ns(&q, ns[0]);
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.records, 2 * ROWS);
+    fossil_time_query_explain(&q, buf, sizeof(buf));
+    ASSUME_ITS_TRUE(strstr(buf, "profiling disabled") != NULL);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_query_tests) {
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_calendar_periods);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_rolling_windows);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_now_offset);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_match_compound);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_compile_errors);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_via_date_search);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_scan_workers);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_scan_dates);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_calendar_sets);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_business_days);
+    FOSSIL_TEST_ADD(c_query_suite, c_test_query_profile);
+
+    FOSSIL_TEST_REGISTER(c_query_suite);
+}
@@ -0,0 +1,136 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(cpp_query_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(cpp_query_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(cpp_query_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+using fossil::time::Query;
+using fossil::time::Date;
+
+// Test: Query wrapper compiles a relative window and matches dates
+FOSSIL_TEST(cpp_test_query_relative_window) {
+    Date now(2024, 6, 5, 12, 0, 0);
+    Query q;
+    ASSUME_ITS_TRUE(q.compile("last 7 days", now));
+
+    Date inside(2024, 6, 1, 8, 0, 0);
+    Date outside(2024, 5, 1, 8, 0, 0);
+    ASSUME_ITS_TRUE(q.match(inside));
+    ASSUME_ITS_FALSE(q.match(outside));
+    ASSUME_ITS_TRUE(q.match_ns(inside.to_unix_nanoseconds()));
+
+    int64_t start = 0, end = 0;
+    ASSUME_ITS_TRUE(q.bounds(start, end));
+    ASSUME_ITS_EQUAL_I64(end - start, 7LL * 86400LL * 1000000000LL);
+}
+
+// Test: Query wrapper compiles field clauses without now
+FOSSIL_TEST(cpp_test_query_fields) {
+    Query q;
+    ASSUME_ITS_TRUE(q.compile("year in 2020..2025 and month >= 6"));
+    ASSUME_ITS_TRUE(q.match(Date(2024, 7, 1)));
+    ASSUME_ITS_FALSE(q.match(Date(2024, 5, 1)));
+    ASSUME_ITS_FALSE(q.match(Date(2026, 7, 1)));
+    ASSUME_ITS_FALSE(q.compile("next week"));
+}
+
+// Test: Query wrapper scans arrays into a bitmap and an index list
+FOSSIL_TEST(cpp_test_query_scan) {
+    Query q;
+    ASSUME_ITS_TRUE(q.compile("month = 2"));
+
+    int64_t ns[3] = {
+        Date(2024, 1, 31).to_unix_nanoseconds(),
+        Date(2024, 2, 29).to_unix_nanoseconds(),
+        Date(2024, 3, 1).to_unix_nanoseconds()
+    };
+    uint64_t bitmap[1] = { 0 };
+    size_t index[3] = { 0, 0, 0 };
+
+    ASSUME_ITS_EQUAL_I64(q.scan_ns(ns, 3, bitmap, 2), 1);
+    ASSUME_ITS_EQUAL_I64((int64_t)bitmap[0], 2);
+    ASSUME_ITS_EQUAL_I64(q.select_ns(ns, 3, index), 1);
+    ASSUME_ITS_EQUAL_I64((int64_t)index[0], 1);
+}
+
+// Test: Query wrapper evaluates calendar clauses
+FOSSIL_TEST(cpp_test_query_calendar) {
+    Query q;
+    ASSUME_ITS_TRUE(q.compile("holiday us and quarter = 3"));
+    ASSUME_ITS_TRUE(q.match(Date(2024, 7, 4)));
+    ASSUME_ITS_FALSE(q.match(Date(2024, 7, 5)));
+    ASSUME_ITS_FALSE(q.match(Date(2024, 12, 25)));
+
+    ASSUME_ITS_TRUE(q.compile("business day"));
+    ASSUME_ITS_TRUE(q.match(Date(2024, 7, 5)));
+    ASSUME_ITS_FALSE(q.match(Date(2024, 7, 6)));
+}
+
+// Test: Query wrapper profiles evaluations and explains the plan
+FOSSIL_TEST(cpp_test_query_explain) {
+    Query q;
+    fossil_time_query_stats_t stats;
+    ASSUME_ITS_TRUE(q.compile("leap year and business day"));
+    q.profile(&stats);
+
+    ASSUME_ITS_TRUE(q.match(Date(2024, 2, 29)));
+    ASSUME_ITS_FALSE(q.match(Date(2023, 3, 1)));
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.records, 2);
+    ASSUME_ITS_EQUAL_I64((int64_t)stats.clauses[1].evaluations, 1);
+
+    std::string plan = q.explain();
+    ASSUME_ITS_TRUE(plan.find("clause 0: leap year evals=2 pass=1 (50.00%)") != std::string::npos);
+    ASSUME_ITS_TRUE(plan.find("clause 1: calendar business day (registry)") != std::string::npos);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_query_tests) {
+    FOSSIL_TEST_ADD(cpp_query_suite, cpp_test_query_relative_window);
+    FOSSIL_TEST_ADD(cpp_query_suite, cpp_test_query_fields);
+    FOSSIL_TEST_ADD(cpp_query_suite, cpp_test_query_scan);
+    FOSSIL_TEST_ADD(cpp_query_suite, cpp_test_query_calendar);
+    FOSSIL_TEST_ADD(cpp_query_suite, cpp_test_query_explain);
+
+    FOSSIL_TEST_REGISTER(cpp_query_suite);
+}
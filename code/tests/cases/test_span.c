@@ -244,6 +244,608 @@ FOSSIL_TEST(c_test_span_format_nulls) {
     ASSUME_ITS_EQUAL_I32(rc, -1);
 }
 
+// Helper: every precision bit from days to yoctoseconds
+#define SPAN_ALL_UNITS ((FOSSIL_TIME_SPAN_PRECISION_YOCTO << 1) - 1)
+
+// Test: canonical ticks round-trip the whole ladder
+FOSSIL_TEST(c_test_span_ticks_roundtrip) {
+    fossil_time_span_t span = make_span(1, 2, 3, 4, 5, 6, 7, SPAN_ALL_UNITS);
+    fossil_time_span_t back;
+    span.picoseconds = 8; span.femtoseconds = 9; span.attoseconds = 10;
+    span.zeptoseconds = 11; span.yoctoseconds = 12;
+
+    fossil_time_span_ticks_t t = fossil_time_span_to_ticks(&span);
+    fossil_time_span_from_ticks(&back, t);
+    ASSUME_ITS_EQUAL_I64(back.days, 1);
+    ASSUME_ITS_EQUAL_I32(back.hours, 2);
+    ASSUME_ITS_EQUAL_I32(back.seconds, 4);
+    ASSUME_ITS_EQUAL_I32(back.nanoseconds, 7);
+    ASSUME_ITS_EQUAL_I32(back.femtoseconds, 9);
+    ASSUME_ITS_EQUAL_I32(back.yoctoseconds, 12);
+    ASSUME_ITS_EQUAL_I64(back.precision_mask, SPAN_ALL_UNITS);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_compare(&span, &back), 0);
+
+    // A million years still round-trips
+    span = make_span(365250000LL, 0, 0, 0, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_DAYS);
+    span.yoctoseconds = -1;
+    span.precision_mask |= FOSSIL_TIME_SPAN_PRECISION_YOCTO;
+    fossil_time_span_from_ticks(&back, fossil_time_span_to_ticks(&span));
+    ASSUME_ITS_EQUAL_I64(back.days, 365249999LL);
+    ASSUME_ITS_EQUAL_I32(back.hours, 23);
+    ASSUME_ITS_EQUAL_I32(back.yoctoseconds, 999);
+}
+
+// Test: field views take a single sign and a minimal precision mask
+FOSSIL_TEST(c_test_span_ticks_sign) {
+    fossil_time_span_t span = make_span(0, 0, 0, -1, -500, 0, 0,
+        FOSSIL_TIME_SPAN_PRECISION_SECONDS | FOSSIL_TIME_SPAN_PRECISION_MILLI);
+    fossil_time_span_t back;
+
+    fossil_time_span_from_ticks(&back, fossil_time_span_to_ticks(&span));
+    ASSUME_ITS_EQUAL_I32(back.seconds, -1);
+    ASSUME_ITS_EQUAL_I32(back.milliseconds, -500);
+    ASSUME_ITS_EQUAL_I64(back.precision_mask,
+        FOSSIL_TIME_SPAN_PRECISION_DAYS | FOSSIL_TIME_SPAN_PRECISION_HOURS |
+        FOSSIL_TIME_SPAN_PRECISION_MINUTES | FOSSIL_TIME_SPAN_PRECISION_SECONDS |
+        FOSSIL_TIME_SPAN_PRECISION_MILLI);
+
+    // Mixed signs collapse: 1 s - 500 ms
+    span.seconds = 1;
+    fossil_time_span_from_ticks(&back, fossil_time_span_to_ticks(&span));
+    ASSUME_ITS_EQUAL_I32(back.seconds, 0);
+    ASSUME_ITS_EQUAL_I32(back.milliseconds, 500);
+
+    fossil_time_span_from_nanoseconds(&back, -1);
+    ASSUME_ITS_EQUAL_I32(back.nanoseconds, -1);
+    ASSUME_ITS_EQUAL_I32(back.microseconds, 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&back), -1);
+}
+
+// Test: tick add, sub and compare carry across the 64-bit words
+FOSSIL_TEST(c_test_span_ticks_arith) {
+    fossil_time_span_ticks_t one = { 0, 1 }, max_lo = { 0, UINT64_MAX }, minus_one = { -1, UINT64_MAX };
+    fossil_time_span_ticks_t r;
+
+    r = fossil_time_span_ticks_add(max_lo, one);
+    ASSUME_ITS_EQUAL_I64(r.hi, 1);
+    ASSUME_ITS_TRUE(r.lo == 0);
+    r = fossil_time_span_ticks_sub(r, one);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_cmp(r, max_lo), 0);
+    r = fossil_time_span_ticks_add(one, minus_one);
+    ASSUME_ITS_TRUE(r.hi == 0 && r.lo == 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_cmp(minus_one, one), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_cmp(max_lo, one), 1);
+
+    fossil_time_span_t a = make_span(0, 0, 90, 0, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_MINUTES);
+    fossil_time_span_t b = make_span(0, 1, 30, 0, 0, 0, 0,
+        FOSSIL_TIME_SPAN_PRECISION_HOURS | FOSSIL_TIME_SPAN_PRECISION_MINUTES);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_compare(&a, &b), 0);
+    b.yoctoseconds = 1;
+    b.precision_mask |= FOSSIL_TIME_SPAN_PRECISION_YOCTO;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_compare(&a, &b), -1);
+}
+
+// Test: normalize carries the whole ladder and leaves a single sign
+FOSSIL_TEST(c_test_span_normalize_sign) {
+    fossil_time_span_t span = make_span(0, 0, 0, -1, 500, 0, 0,
+        FOSSIL_TIME_SPAN_PRECISION_SECONDS | FOSSIL_TIME_SPAN_PRECISION_MILLI);
+    fossil_time_span_normalize(&span);
+    ASSUME_ITS_EQUAL_I32(span.seconds, 0);
+    ASSUME_ITS_EQUAL_I32(span.milliseconds, -500);
+
+    // Sub-nanosecond fields carry too, whatever the mask says
+    span = make_span(0, 0, 0, 0, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_NANO);
+    span.picoseconds = 1500;
+    span.yoctoseconds = -1;
+    fossil_time_span_normalize(&span);
+    ASSUME_ITS_EQUAL_I32(span.nanoseconds, 1);
+    ASSUME_ITS_EQUAL_I32(span.picoseconds, 499);
+    ASSUME_ITS_EQUAL_I32(span.femtoseconds, 999);
+    ASSUME_ITS_EQUAL_I32(span.yoctoseconds, 999);
+    ASSUME_ITS_TRUE(span.precision_mask & FOSSIL_TIME_SPAN_PRECISION_PICO);
+    ASSUME_ITS_TRUE(span.precision_mask & FOSSIL_TIME_SPAN_PRECISION_YOCTO);
+
+    // Large unnormalized hours
+    span = make_span(0, 1000000, -30, 0, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_HOURS);
+    fossil_time_span_normalize(&span);
+    ASSUME_ITS_EQUAL_I64(span.days, 41666);
+    ASSUME_ITS_EQUAL_I32(span.hours, 15);
+    ASSUME_ITS_EQUAL_I32(span.minutes, 30);
+}
+
+// Test: batch normalize matches the scalar form
+FOSSIL_TEST(c_test_span_normalize_batch) {
+    fossil_time_span_t spans[16], one[16];
+
+    for (int i = 0; i < 16; ++i) {
+        spans[i] = make_span(i - 8, 25 * i, -61 * i, 3601 - 500 * i, 1999 * i, -7 * i, 1001, SPAN_ALL_UNITS);
+        spans[i].zeptoseconds = -2000 * i;
+        one[i] = spans[i];
+        fossil_time_span_normalize(&one[i]);
+    }
+    fossil_time_span_normalize_batch(spans, 16);
+    for (int i = 0; i < 16; ++i) {
+        ASSUME_ITS_TRUE(memcmp(&one[i], &spans[i], sizeof(one[i])) == 0);
+        ASSUME_ITS_TRUE(spans[i].days <= 0 || spans[i].hours >= 0);
+    }
+    fossil_time_span_normalize_batch(NULL, 4);
+}
+
+// Helper: parse and return nanoseconds, or INT64_MIN on failure
+static int64_t parse_ns(const char *text) {
+    fossil_time_span_t span;
+    if (fossil_time_span_parse(text, &span) != 0)
+        return INT64_MIN;
+    return fossil_time_span_to_nanoseconds(&span);
+}
+
+// Test: ISO 8601 durations
+FOSSIL_TEST(c_test_span_parse_iso) {
+    fossil_time_span_t span;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_parse("P3DT4H5M6.789S", &span), 0);
+    ASSUME_ITS_EQUAL_I64(span.days, 3);
+    ASSUME_ITS_EQUAL_I32(span.hours, 4);
+    ASSUME_ITS_EQUAL_I32(span.minutes, 5);
+    ASSUME_ITS_EQUAL_I32(span.seconds, 6);
+    ASSUME_ITS_EQUAL_I32(span.milliseconds, 789);
+
+    ASSUME_ITS_EQUAL_I64(parse_ns("PT0,5S"), 500000000LL);
+    ASSUME_ITS_EQUAL_I64(parse_ns("P2W"), 14 * 86400LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I64(parse_ns("PT1.5H"), 5400LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I64(parse_ns("-PT90M"), -5400LL * 1000000000LL);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_parse("PT0.000000000000000000000001S", &span), 0);
+    ASSUME_ITS_EQUAL_I32(span.yoctoseconds, 1);
+
+    ASSUME_ITS_EQUAL_I64(parse_ns("P"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("PT"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("P1Y"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("P1M"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("PT1S2M"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("PT1H1H"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("P1DT"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("PT.S"), INT64_MIN);
+}
+
+// Test: Go-style compact durations
+FOSSIL_TEST(c_test_span_parse_compact) {
+    fossil_time_span_t span;
+
+    ASSUME_ITS_EQUAL_I64(parse_ns("1h30m"), 5400LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I64(parse_ns("250ms"), 250000000LL);
+    ASSUME_ITS_EQUAL_I64(parse_ns("1.5us"), 1500);
+    ASSUME_ITS_EQUAL_I64(parse_ns("\xC2\xB5s") , INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("3\xC2\xB5s"), 3000);
+    ASSUME_ITS_EQUAL_I64(parse_ns("-1m.5s"), -60500000000LL);
+    ASSUME_ITS_EQUAL_I64(parse_ns("0"), 0);
+    ASSUME_ITS_EQUAL_I64(parse_ns("2d"), 172800LL * 1000000000LL);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_parse("7ys1zs", &span), 0);
+    ASSUME_ITS_EQUAL_I32(span.zeptoseconds, 1);
+    ASSUME_ITS_EQUAL_I32(span.yoctoseconds, 7);
+
+    ASSUME_ITS_EQUAL_I64(parse_ns(""), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("-"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("5"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("5 s"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("1h-5m"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("5parsecs"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(parse_ns("99999999999999999999999999h"), INT64_MIN);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_parse(NULL, &span), -1);
+}
+
+// Test: batch parsing counts and zeroes failed rows
+FOSSIL_TEST(c_test_span_parse_batch) {
+    const char *texts[] = { "1s", "bogus", "PT2S", NULL, "3ms" };
+    fossil_time_span_t out[5];
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_parse_batch(texts, 5, out), 2);
+    ASSUME_ITS_EQUAL_I32(out[0].seconds, 1);
+    ASSUME_ITS_EQUAL_I64(out[1].precision_mask, 0);
+    ASSUME_ITS_EQUAL_I32(out[2].seconds, 2);
+    ASSUME_ITS_EQUAL_I64(out[3].precision_mask, 0);
+    ASSUME_ITS_EQUAL_I32(out[4].milliseconds, 3);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_parse_batch(NULL, 1, out), -1);
+}
+
+// Parse text, then format it; the buffer is shared between calls
+static const char *reformat(const char *text, const char *format_id) {
+    static char buf[128];
+    fossil_time_span_t span;
+    if (fossil_time_span_parse(text, &span) != 0)
+        return "(parse error)";
+    if (fossil_time_span_format(&span, buf, sizeof(buf), format_id) < 0)
+        return "(format error)";
+    return buf;
+}
+
+// Test: ISO 8601 output is exact and parses back to the same value
+FOSSIL_TEST(c_test_span_format_iso) {
+    static const char *cases[] = {
+        "PT0S", "P1D", "P1DT2H3M4.005S", "-PT1.5S", "PT1M", "PT0.000000000000000000000001S", "P12345DT23H59M59.999999999S"
+    };
+    fossil_time_span_t span, back;
+    char buf[64];
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        ASSUME_ITS_EQUAL_CSTR(reformat(cases[i], "iso"), cases[i]);
+    ASSUME_ITS_EQUAL_CSTR(reformat("90m", "iso"), "PT1H30M");
+
+    // Unnormalized fields print their exact total
+    span = make_span(0, 0, 0, -1, 500, 0, 0, FOSSIL_TIME_SPAN_PRECISION_SECONDS | FOSSIL_TIME_SPAN_PRECISION_MILLI);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format(&span, buf, sizeof(buf), "iso"), 7);
+    ASSUME_ITS_EQUAL_CSTR(buf, "-PT0.5S");
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_parse(buf, &back), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_compare(&span, &back), 0);
+}
+
+// Test: Go-style compact and exact-seconds output
+FOSSIL_TEST(c_test_span_format_compact) {
+    ASSUME_ITS_EQUAL_CSTR(reformat("0", "compact"), "0s");
+    ASSUME_ITS_EQUAL_CSTR(reformat("PT1H2M3.004S", "compact"), "1h2m3.004s");
+    ASSUME_ITS_EQUAL_CSTR(reformat("P1D", "compact"), "24h0m0s");
+    ASSUME_ITS_EQUAL_CSTR(reformat("90s", "compact"), "1m30s");
+    ASSUME_ITS_EQUAL_CSTR(reformat("1500us", "compact"), "1.5ms");
+    ASSUME_ITS_EQUAL_CSTR(reformat("250ns", "compact"), "250ns");
+    ASSUME_ITS_EQUAL_CSTR(reformat("-7ys", "compact"), "-7ys");
+    ASSUME_ITS_EQUAL_CSTR(reformat("1001ps", "compact"), "1.001ns");
+
+    ASSUME_ITS_EQUAL_CSTR(reformat("5s", "precise"), "5.000000000 s");
+    ASSUME_ITS_EQUAL_CSTR(reformat("-1m1ps", "precise"), "-60.000000000001 s");
+    ASSUME_ITS_EQUAL_CSTR(reformat("PT0S", "precise"), "0.000000000 s");
+}
+
+// Test: measured lengths, truncation and batch rows
+FOSSIL_TEST(c_test_span_format_batch) {
+    fossil_time_span_t spans[3];
+    char rows[3][8];
+    char small[4];
+
+    fossil_time_span_parse("1h2m3.004s", &spans[0]);
+    fossil_time_span_parse("250ms", &spans[1]);
+    fossil_time_span_parse("-P3D", &spans[2]);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format_length(&spans[0], "compact"), 10);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format_length(&spans[0], "short"), 11);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format_length(&spans[0], "bogus"), -1);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format(&spans[0], small, sizeof(small), "compact"), 10);
+    ASSUME_ITS_EQUAL_CSTR(small, "1h2");
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format_batch(spans, 3, rows[0], sizeof(rows[0]), "iso"), 0);
+    ASSUME_ITS_EQUAL_CSTR(rows[0], "PT1H2M3");
+    ASSUME_ITS_EQUAL_CSTR(rows[1], "PT0.25S");
+    ASSUME_ITS_EQUAL_CSTR(rows[2], "-P3D");
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format_batch(spans, 3, rows[0], sizeof(rows[0]), "bogus"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format_batch(NULL, 3, rows[0], sizeof(rows[0]), "iso"), -1);
+}
+
+// Test: totals past the tick range are refused by the total-based styles
+FOSSIL_TEST(c_test_span_format_out_of_range) {
+    fossil_time_span_t spans[2];
+    char rows[2][24];
+    char buf[48];
+
+    spans[0] = make_span(1000000000, 0, 0, 0, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_DAYS);
+    spans[1] = make_span(INT64_MAX, 0, 0, 0, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_DAYS);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format(&spans[0], buf, sizeof(buf), "iso"), 12);
+    ASSUME_ITS_EQUAL_CSTR(buf, "P1000000000D");
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format(&spans[0], buf, sizeof(buf), "compact"), 16);
+    ASSUME_ITS_EQUAL_CSTR(buf, "24000000000h0m0s");
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format(&spans[1], buf, sizeof(buf), "iso"), -1);
+    ASSUME_ITS_EQUAL_CSTR(buf, "");
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format(&spans[1], buf, sizeof(buf), "compact"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format(&spans[1], buf, sizeof(buf), "precise"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format_length(&spans[1], "iso"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format(&spans[1], buf, sizeof(buf), "short"), 29);
+    ASSUME_ITS_EQUAL_CSTR(buf, "9223372036854775807d 0h 0m 0s");
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_format_batch(spans, 2, rows[0], sizeof(rows[0]), "iso"), -1);
+    ASSUME_ITS_EQUAL_CSTR(rows[0], "P1000000000D");
+    ASSUME_ITS_EQUAL_CSTR(rows[1], "");
+}
+
+// Test: aggregates over spans with mixed layouts and signs
+FOSSIL_TEST(c_test_span_aggregates) {
+    fossil_time_span_t spans[4], out;
+    double var = 0.0;
+
+    fossil_time_span_parse("1s", &spans[0]);
+    fossil_time_span_parse("3s", &spans[1]);
+    spans[2] = make_span(0, 0, 0, 3, -1000, 0, 0,
+        FOSSIL_TIME_SPAN_PRECISION_SECONDS | FOSSIL_TIME_SPAN_PRECISION_MILLI);
+    fossil_time_span_parse("-PT2S", &spans[3]);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_sum(spans, 4, &out), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&out), 4000000000LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_mean(spans, 4, &out), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&out), 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_variance(spans, 4, &var), 0);
+    ASSUME_ITS_TRUE(var > 3.4999 && var < 3.5001);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_min(spans, 4, &out), 0);
+    ASSUME_ITS_EQUAL_I32(out.seconds, -2);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_max(spans, 4, &out), 0);
+    ASSUME_ITS_EQUAL_I32(out.seconds, 3);
+    ASSUME_ITS_EQUAL_I32(out.milliseconds, 0);
+
+    // Mean rounds toward zero at the yoctosecond
+    fossil_time_span_parse("-1ys", &spans[0]);
+    fossil_time_span_parse("0", &spans[1]);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_mean(spans, 2, &out), 0);
+    ASSUME_ITS_EQUAL_I32(out.yoctoseconds, 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_sum(spans, 0, &out), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&out), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_mean(spans, 0, &out), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_min(NULL, 1, &out), -1);
+}
+
+// Test: tick aggregates carry across words and report overflow
+FOSSIL_TEST(c_test_span_ticks_aggregates) {
+    fossil_time_span_ticks_t t[3], out;
+    double var = 0.0;
+
+    // Three values near 2^64 ys: the low words carry into hi
+    t[0].hi = 0; t[0].lo = UINT64_MAX;
+    t[1].hi = 0; t[1].lo = UINT64_MAX;
+    t[2].hi = -1; t[2].lo = 0; // -2^64
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_sum(t, 3, &out), 0);
+    ASSUME_ITS_EQUAL_I64(out.hi, 0);
+    ASSUME_ITS_TRUE(out.lo == UINT64_MAX - 1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_min(t, 3, &out), 0);
+    ASSUME_ITS_EQUAL_I64(out.hi, -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_max(t, 3, &out), 0);
+    ASSUME_ITS_TRUE(out.lo == UINT64_MAX);
+
+    // The sum overflows 128 bits but the mean does not
+    t[0].hi = INT64_MAX; t[0].lo = UINT64_MAX;
+    t[1] = t[0];
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_sum(t, 2, &out), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_mean(t, 2, &out), 0);
+    ASSUME_ITS_EQUAL_I64(out.hi, INT64_MAX);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_variance(t, 2, &var), 0);
+    ASSUME_ITS_TRUE(var == 0.0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_variance(t, 0, &var), -1);
+}
+
+// Test: checked field-wise arithmetic reports overflow and leaves the result
+FOSSIL_TEST(c_test_span_checked) {
+    fossil_time_span_t a = make_span(0, 0, 0, 0, INT32_MAX, 0, 0, FOSSIL_TIME_SPAN_PRECISION_MILLI);
+    fossil_time_span_t b = make_span(0, 0, 0, 0, 1, 0, 0, FOSSIL_TIME_SPAN_PRECISION_MILLI);
+    fossil_time_span_t r = make_span(0, 0, 0, 7, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_SECONDS);
+    int64_t ns = 0;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_add_checked(&r, &a, &b), -1);
+    ASSUME_ITS_EQUAL_I32(r.seconds, 7);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_sub_checked(&r, &a, &b), 0);
+    ASSUME_ITS_EQUAL_I32(r.milliseconds, INT32_MAX - 1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_scale_checked(&r, &b, 3), 0);
+    ASSUME_ITS_EQUAL_I32(r.milliseconds, 3);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_scale_checked(&r, &a, -2), -1);
+
+    // Values beyond the int32 field carry instead of truncating
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_from_unit_checked(&r, 5000000000LL, "ms"), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&r), 5000000000LL * 1000000);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_from_unit_checked(&r, 90, "minutes"), 0);
+    ASSUME_ITS_EQUAL_I32(r.minutes, 90);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_from_unit_checked(&r, INT64_MAX, "days"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_from_unit_checked(&r, 1, "fortnights"), -1);
+
+    a = make_span(200000LL, 0, 0, 0, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_DAYS);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_nanoseconds_checked(&a, &ns), -1);
+    a.days = 1;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_nanoseconds_checked(&a, &ns), 0);
+    ASSUME_ITS_EQUAL_I64(ns, 86400LL * 1000000000LL);
+}
+
+// Test: saturating arithmetic clamps instead of wrapping
+FOSSIL_TEST(c_test_span_saturating) {
+    fossil_time_span_t huge = make_span(INT64_MAX, 0, 0, 0, 0, 0, 0, FOSSIL_TIME_SPAN_PRECISION_DAYS);
+    fossil_time_span_t one, r, back;
+    fossil_time_span_ticks_t t;
+
+    fossil_time_span_parse("1s", &one);
+    fossil_time_span_add_saturating(&r, &huge, &one);
+    t = fossil_time_span_to_ticks(&r);
+    ASSUME_ITS_EQUAL_I64(t.hi, INT64_MAX);
+    ASSUME_ITS_TRUE(t.lo == UINT64_MAX);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds_saturating(&huge), INT64_MAX);
+
+    // Out of range inputs that cancel give the exact result
+    fossil_time_span_sub_saturating(&r, &huge, &huge);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&r), 0);
+
+    fossil_time_span_scale_saturating(&r, &one, INT64_MIN);
+    t = fossil_time_span_to_ticks(&r);
+    ASSUME_ITS_EQUAL_I64(t.hi, INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds_saturating(&r), INT64_MIN);
+
+    fossil_time_span_scale_saturating(&r, &one, -3);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds_saturating(&r), -3000000000LL);
+    fossil_time_span_scale_saturating(&r, &huge, 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds_saturating(&r), 0);
+
+    fossil_time_span_sub_saturating(&back, &one, &one);
+    fossil_time_span_add_saturating(&r, &back, &one);
+    ASSUME_ITS_EQUAL_I32(r.seconds, 1);
+
+    // Fields that cancel are range-checked on the exact total only
+    fossil_time_span_t edge = make_span(106751, 23, 47, 17, -1000, 0, 0, SPAN_ALL_UNITS);
+    int64_t ns = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_nanoseconds_checked(&edge, &ns), 0);
+    ASSUME_ITS_EQUAL_I64(ns, 9223372036000000000LL);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds_saturating(&edge), 9223372036000000000LL);
+    edge = make_span(-106751, -23, -47, -16, -854, -775, -807, SPAN_ALL_UNITS);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds_saturating(&edge), INT64_MIN + 1);
+    edge.nanoseconds = -808;
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds_saturating(&edge), INT64_MIN);
+    edge.nanoseconds = -809;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_nanoseconds_checked(&edge, &ns), -1);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds_saturating(&edge), INT64_MIN);
+}
+
+// Test: exact conversion to and from every unit
+FOSSIL_TEST(c_test_span_to_unit) {
+    fossil_time_span_t span;
+    fossil_time_span_ticks_t count, rem, big;
+
+    fossil_time_span_parse("PT1H2M3.000000004000005S", &span);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_unit(&span, "fs", &count, &rem), 0);
+    ASSUME_ITS_EQUAL_I64(count.hi, 0);
+    ASSUME_ITS_TRUE(count.lo == 3723000000004000005ULL);
+    ASSUME_ITS_TRUE(rem.lo == 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_unit(&span, "minutes", &count, &rem), 0);
+    ASSUME_ITS_TRUE(count.lo == 62);
+
+    // Beyond 64 bits: one day in yoctoseconds
+    fossil_time_span_parse("P1D", &span);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_unit(&span, "ys", &count, NULL), 0);
+    ASSUME_ITS_EQUAL_I64(count.hi, 0x1172C67A9LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_from_unit_exact(&span, count, "ys"), 0);
+    ASSUME_ITS_EQUAL_I64(span.days, 1);
+
+    // Truncation toward zero keeps the sign in the remainder
+    fossil_time_span_parse("-90s", &span);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_unit(&span, "minutes", &count, &rem), 0);
+    ASSUME_ITS_EQUAL_I64(count.hi, -1);
+    ASSUME_ITS_TRUE(count.lo == UINT64_MAX);
+    fossil_time_span_from_ticks(&span, rem);
+    ASSUME_ITS_EQUAL_I32(span.seconds, -30);
+
+    // A count that exceeds every int32 field
+    big.hi = 0;
+    big.lo = 123456789012345ULL;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_from_unit_exact(&span, big, "fs"), 0);
+    ASSUME_ITS_EQUAL_I32(span.milliseconds, 123);
+    ASSUME_ITS_EQUAL_I32(span.femtoseconds, 345);
+    big.lo = 1ULL << 62;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_from_unit_exact(&span, big, "days"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_to_unit(&span, "weeks", &count, NULL), -1);
+}
+
+// Test: the unit conversion matrix in both directions
+FOSSIL_TEST(c_test_span_convert_unit) {
+    fossil_time_span_ticks_t in, out, rem;
+
+    in.hi = 0;
+    in.lo = 3;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_convert_unit(in, "hours", "ms", &out, &rem), 0);
+    ASSUME_ITS_TRUE(out.lo == 10800000ULL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_convert_unit(out, "ms", "hours", &out, &rem), 0);
+    ASSUME_ITS_TRUE(out.lo == 3 && rem.lo == 0);
+
+    in.lo = 1500;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_convert_unit(in, "ps", "ns", &out, &rem), 0);
+    ASSUME_ITS_TRUE(out.lo == 1 && rem.lo == 500);
+
+    in.hi = INT64_MAX;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_convert_unit(in, "zs", "ys", &out, NULL), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_convert_unit(in, "zs", "zs", &out, NULL), 0);
+    ASSUME_ITS_EQUAL_I64(out.hi, INT64_MAX);
+}
+
+// Test: exact multiply, divide, modulo and ratio on the tick form
+FOSSIL_TEST(c_test_span_mul_div) {
+    fossil_time_span_t span, frame, r;
+    fossil_time_span_ticks_t num, den, t, q, rem;
+
+    fossil_time_span_parse("1s", &span);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_div(&frame, &span, 60), 0);
+    ASSUME_ITS_EQUAL_I32(frame.milliseconds, 16);
+    ASSUME_ITS_EQUAL_I32(frame.microseconds, 666);
+    ASSUME_ITS_EQUAL_I32(frame.yoctoseconds, 666);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_mul(&r, &frame, 60), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&r), 999999999);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_div(&r, &span, 0), -1);
+
+    // Sub-nanosecond periods count exactly
+    fossil_time_span_parse("1ms", &span);
+    fossil_time_span_parse("3ps", &frame);
+    ASSUME_ITS_TRUE(fossil_time_span_ratio(&span, &frame) > 333333333.33 &&
+                    fossil_time_span_ratio(&span, &frame) < 333333333.34);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ratio_exact(&span, &frame, &num, &den), 0);
+    ASSUME_ITS_TRUE(num.lo == 1000000000ULL && den.lo == 3);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_mod(&r, &span, &frame), 0);
+    ASSUME_ITS_EQUAL_I32(r.picoseconds, 1);
+
+    // Floored modulo gives the phase of negative spans
+    fossil_time_span_parse("-1s", &span);
+    fossil_time_span_parse("300ms", &frame);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_mod(&r, &span, &frame), 0);
+    ASSUME_ITS_EQUAL_I32(r.milliseconds, 200);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_divmod(fossil_time_span_to_ticks(&span),
+        fossil_time_span_to_ticks(&frame), &q, &rem), 0);
+    ASSUME_ITS_EQUAL_I64(q.hi, -1);
+    ASSUME_ITS_TRUE(q.lo == (uint64_t)-4);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ratio_exact(&span, &frame, &num, &den), 0);
+    ASSUME_ITS_EQUAL_I64(num.hi, -1);
+    ASSUME_ITS_TRUE(num.lo == (uint64_t)-10 && den.lo == 3);
+
+    t.hi = INT64_MIN;
+    t.lo = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_div(t, -1, &q), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_mul(t, 2, &q), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ticks_mul(t, 1, &q), 0);
+}
+
+// Test: rounding to units and multiples, including steps past 64 bits
+FOSSIL_TEST(c_test_span_round) {
+    fossil_time_span_t span, r;
+
+    fossil_time_span_parse("PT1H22M30S", &span);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_floor(&r, &span, 15, "minutes"), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_seconds(&r), 4500);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ceil(&r, &span, 15, "minutes"), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_seconds(&r), 5400);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_round(&r, &span, 15, "minutes"), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_seconds(&r), 5400); // tie, away from zero
+
+    fossil_time_span_parse("-150us", &span);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_floor(&r, &span, 100, "us"), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&r), -200000);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ceil(&r, &span, 100, "us"), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&r), -100000);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_round(&r, &span, 100, "us"), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&r), -200000);
+
+    // 7 days is 6.048e29 ys
+    fossil_time_span_parse("P10DT1S", &span);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_round(&r, &span, 7, "days"), 0);
+    ASSUME_ITS_EQUAL_I64(r.days, 7);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_floor(&r, &span, 1, "ys"), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_compare(&r, &span), 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_floor(&r, &span, 0, "ms"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_floor(&r, &span, 1, "fortnights"), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ceil(&r, &span, INT64_MAX, "days"), -1);
+}
+
+// Test: batch rounding resolves the step once and works in place
+FOSSIL_TEST(c_test_span_round_batch) {
+    fossil_time_span_t spans[3];
+
+    fossil_time_span_parse("1.2ms", &spans[0]);
+    fossil_time_span_parse("1.25ms", &spans[1]);
+    fossil_time_span_parse("-0.05ms", &spans[2]);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_round_batch(spans, 3, 100, "us", spans), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&spans[0]), 1200000);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&spans[1]), 1300000);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&spans[2]), -100000);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_floor_batch(spans, 3, 1, "ms", spans), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&spans[2]), -1000000);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ceil_batch(spans, 3, 1, "seconds", spans), 0);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&spans[0]), 1000000000);
+    ASSUME_ITS_EQUAL_I64(fossil_time_span_to_nanoseconds(&spans[2]), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_span_ceil_batch(spans, 3, -1, "seconds", spans), -1);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -259,6 +861,27 @@ FOSSIL_TEST_GROUP(c_span_tests) {
     FOSSIL_TEST_ADD(c_span_suite, c_test_span_format);
     FOSSIL_TEST_ADD(c_span_suite, c_test_span_format_buffer_small);
     FOSSIL_TEST_ADD(c_span_suite, c_test_span_format_nulls);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_ticks_roundtrip);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_ticks_sign);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_ticks_arith);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_normalize_sign);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_normalize_batch);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_parse_iso);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_parse_compact);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_parse_batch);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_format_iso);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_format_compact);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_format_batch);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_format_out_of_range);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_aggregates);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_ticks_aggregates);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_checked);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_saturating);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_to_unit);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_convert_unit);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_mul_div);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_round);
+    FOSSIL_TEST_ADD(c_span_suite, c_test_span_round_batch);
 
     FOSSIL_TEST_REGISTER(c_span_suite);
 }
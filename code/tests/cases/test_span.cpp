@@ -253,6 +253,159 @@ FOSSIL_TEST(cpp_test_span_format_nulls) {
     ASSUME_ITS_EQUAL_I32(rc, -1);
 }
 
+// Test: ticks view and length comparison through the wrapper
+FOSSIL_TEST(cpp_test_span_ticks) {
+    Span a, b;
+    a.from_unit(90, "minutes");
+    b.from_nanoseconds(5400LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(a.compare(b), 0);
+    ASSUME_ITS_EQUAL_I32(b.raw.hours, 1);
+    ASSUME_ITS_EQUAL_I32(b.raw.minutes, 30);
+
+    Span c = Span::from_ticks(fossil_time_span_ticks_add(a.ticks(), b.ticks()));
+    ASSUME_ITS_EQUAL_I32(c.raw.hours, 3);
+    ASSUME_ITS_EQUAL_I32(c.compare(a), 1);
+}
+
+// Test: parsing ISO and compact durations through the wrapper
+FOSSIL_TEST(cpp_test_span_parse) {
+    Span a, b;
+    ASSUME_ITS_TRUE(a.parse("PT1H30M"));
+    ASSUME_ITS_TRUE(b.parse("90m"));
+    ASSUME_ITS_EQUAL_I32(a.compare(b), 0);
+    ASSUME_ITS_FALSE(b.parse("90 minutes"));
+}
+
+FOSSIL_TEST(cpp_test_span_format_styles) {
+    Span span;
+    char buf[32];
+    ASSUME_ITS_TRUE(span.parse("P1DT0.5S"));
+    ASSUME_ITS_EQUAL_I32(span.format_length("iso"), 8);
+    ASSUME_ITS_EQUAL_I32(span.format(buf, sizeof(buf), "iso"), 8);
+    ASSUME_ITS_EQUAL_CSTR(buf, "P1DT0.5S");
+    span.format(buf, sizeof(buf), "compact");
+    ASSUME_ITS_EQUAL_CSTR(buf, "24h0m0.5s");
+
+    fossil_time_span_t spans[2] = { span.raw, span.raw };
+    char rows[2][24];
+    ASSUME_ITS_EQUAL_I32(Span::format(spans, 2, rows[0], sizeof(rows[0]), "precise"), 0);
+    ASSUME_ITS_EQUAL_CSTR(rows[1], "86400.500000000 s");
+}
+
+FOSSIL_TEST(cpp_test_span_aggregates) {
+    Span a, b, out;
+    a.parse("250ms");
+    b.parse("750ms");
+    fossil_time_span_t spans[2] = { a.raw, b.raw };
+    double var = 0.0;
+
+    ASSUME_ITS_TRUE(Span::sum(spans, 2, out));
+    ASSUME_ITS_EQUAL_I32(out.raw.seconds, 1);
+    ASSUME_ITS_TRUE(Span::mean(spans, 2, out));
+    ASSUME_ITS_EQUAL_I32(out.raw.milliseconds, 500);
+    ASSUME_ITS_TRUE(Span::minimum(spans, 2, out));
+    ASSUME_ITS_EQUAL_I32(out.raw.milliseconds, 250);
+    ASSUME_ITS_TRUE(Span::maximum(spans, 2, out));
+    ASSUME_ITS_EQUAL_I32(out.raw.milliseconds, 750);
+    ASSUME_ITS_TRUE(Span::variance(spans, 2, var));
+    ASSUME_ITS_TRUE(var > 0.0624 && var < 0.0626);
+    ASSUME_ITS_FALSE(Span::mean(spans, 0, out));
+}
+
+FOSSIL_TEST(cpp_test_span_overflow) {
+    Span a, b, out;
+    a.from_unit(INT32_MAX, "ns");
+    b.from_unit(1, "ns");
+    ASSUME_ITS_FALSE(Span::add_checked(a, b, out));
+    ASSUME_ITS_TRUE(Span::sub_checked(a, b, out));
+    ASSUME_ITS_EQUAL_I64(Span::add_saturating(a, b).to_nanoseconds(), 2147483648LL);
+    ASSUME_ITS_EQUAL_I64(a.scale_saturating(INT64_MAX).to_nanoseconds_saturating(), INT64_MAX);
+    ASSUME_ITS_TRUE(out.from_unit_checked(3000000000LL, "seconds"));
+    ASSUME_ITS_EQUAL_I64(out.to_seconds(), 3000000000LL);
+}
+
+FOSSIL_TEST(cpp_test_span_to_unit) {
+    Span span;
+    fossil_time_span_ticks_t count;
+    span.parse("2.5ns");
+    ASSUME_ITS_TRUE(span.to_unit("ps", count));
+    ASSUME_ITS_TRUE(count.lo == 2500);
+    ASSUME_ITS_TRUE(span.from_unit_exact(count, "fs"));
+    ASSUME_ITS_EQUAL_I32(span.raw.picoseconds, 2);
+    ASSUME_ITS_EQUAL_I32(span.raw.femtoseconds, 500);
+    ASSUME_ITS_FALSE(span.to_unit("parsec", count));
+}
+
+FOSSIL_TEST(cpp_test_span_mul_div) {
+    Span second, frame, out;
+    second.parse("1s");
+    ASSUME_ITS_TRUE(second.div(4, frame));
+    ASSUME_ITS_EQUAL_I32(frame.raw.milliseconds, 250);
+    ASSUME_ITS_TRUE(frame.mul(6, out));
+    ASSUME_ITS_EQUAL_I32(out.raw.seconds, 1);
+    ASSUME_ITS_TRUE(out.mod(frame, out));
+    ASSUME_ITS_EQUAL_I32(out.raw.milliseconds, 0);
+    ASSUME_ITS_TRUE(second.ratio(frame) == 4.0);
+}
+
+FOSSIL_TEST(cpp_test_span_round) {
+    Span span;
+    span.parse("PT7M29S");
+    ASSUME_ITS_EQUAL_I64(span.floor(5, "minutes").to_seconds(), 300);
+    ASSUME_ITS_EQUAL_I64(span.ceil(5, "minutes").to_seconds(), 600);
+    ASSUME_ITS_EQUAL_I64(span.round(5, "minutes").to_seconds(), 300);
+    ASSUME_ITS_EQUAL_I64(span.round(0, "minutes").to_seconds(), 0);
+}
+
+FOSSIL_TEST(cpp_test_span_constexpr) {
+    constexpr Span timeout = Span::seconds(90) + Span::milliseconds(250);
+    static_assert(timeout.raw.minutes == 1 && timeout.raw.seconds == 30, "folds at compile time");
+    static_assert(timeout.raw.milliseconds == 250, "folds at compile time");
+    static_assert(timeout * 4 == Span::minutes(6) + Span::seconds(1), "exact multiply");
+    static_assert(timeout / 2 < timeout && -timeout < Span(), "ordering");
+    static_assert(Span::hours(1) / Span::minutes(7) == 8, "whole quotient");
+    static_assert(Span::days(1) / Span::yoctoseconds(1) == INT64_MAX, "saturates");
+    static_assert(-Span::days(1) / Span::yoctoseconds(1) == INT64_MIN, "saturates");
+
+    Span runtime;
+    runtime.from_unit(90250, "ms");
+    ASSUME_ITS_TRUE(runtime == timeout);
+    ASSUME_ITS_EQUAL_I32(runtime.compare(timeout), fossil_time_span_compare(&runtime.raw, &timeout.raw));
+
+    Span big = Span::nanoseconds(INT64_MAX);
+    ASSUME_ITS_EQUAL_I64(big.to_nanoseconds(), INT64_MAX);
+    big -= Span::nanoseconds(1);
+    big /= 0;
+    ASSUME_ITS_EQUAL_I64(big.to_seconds(), 0);
+}
+
+FOSSIL_TEST(cpp_test_span_chrono) {
+    using namespace std::chrono;
+    using frames = duration<int64_t, std::ratio<1, 60>>;
+
+    constexpr Span frame = frames(1);
+    static_assert(frame.raw.milliseconds == 16 && frame.raw.microseconds == 666, "1/60 s");
+    static_assert(frame.raw.yoctoseconds == 667, "1/60 s to the nearest ys");
+    using thirds = duration<int64_t, std::ratio<1, 3>>;
+    static_assert(thirds(Span(thirds(1))).count() == 1, "1/3 s round trip");
+    static_assert(thirds(Span(thirds(-5))).count() == -5, "1/3 s round trip");
+    static_assert(frames(Span(frames(1))).count() == 1, "1/60 s round trip");
+    static_assert(frames(Span(frames(-7))).count() == -7, "1/60 s round trip");
+    static_assert(frames(Span::milliseconds(16)).count() == 0, "still truncates");
+    constexpr milliseconds ms = Span::seconds(3) + milliseconds(5);
+    static_assert(ms.count() == 3005, "round trip through chrono");
+    static_assert(nanoseconds(-Span::microseconds(7)).count() == -7000, "negative spans");
+
+    Span span = hours(26) + nanoseconds(3);
+    ASSUME_ITS_EQUAL_I64(span.raw.days, 1);
+    ASSUME_ITS_EQUAL_I32(span.raw.hours, 2);
+    ASSUME_ITS_EQUAL_I32(span.raw.nanoseconds, 3);
+    ASSUME_ITS_EQUAL_I64(nanoseconds(span).count(), 93600000000003LL);
+    ASSUME_ITS_EQUAL_I64(frames(span).count(), 5616000);
+    ASSUME_ITS_TRUE(duration<double>(Span::milliseconds(1500)).count() == 1.5);
+    ASSUME_ITS_TRUE(span > seconds(93600));
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -268,6 +421,16 @@ FOSSIL_TEST_GROUP(cpp_span_tests) {
     FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_format);
     FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_format_buffer_small);
     FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_format_nulls);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_ticks);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_parse);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_format_styles);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_aggregates);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_overflow);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_to_unit);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_mul_div);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_round);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_constexpr);
+    FOSSIL_TEST_ADD(cpp_span_suite, cpp_test_span_chrono);
 
     FOSSIL_TEST_REGISTER(cpp_span_suite);
 }
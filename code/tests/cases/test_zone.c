@@ -0,0 +1,420 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+#include <string.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(c_zone_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(c_zone_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(c_zone_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test: offsets, DST flags and abbreviations across a DST year
+FOSSIL_TEST(c_test_zone_berlin_offsets) {
+    fossil_time_zone_t *zone = fossil_time_zone_open("Europe/Berlin");
+    fossil_time_zone_period_t p;
+
+    if (!zone) return; // zoneinfo not installed on this host
+
+    ASSUME_ITS_EQUAL_CSTR(fossil_time_zone_name(zone), "Europe/Berlin");
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(zone, 1705320000LL, &p), 0); // 2024-01-15
+    ASSUME_ITS_EQUAL_I32(p.offset_sec, 3600);
+    ASSUME_ITS_FALSE(p.is_dst);
+    ASSUME_ITS_EQUAL_CSTR(p.abbrev, "CET");
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(zone, 1711846800LL, &p), 0); // DST start
+    ASSUME_ITS_EQUAL_I32(p.offset_sec, 7200);
+    ASSUME_ITS_TRUE(p.is_dst);
+    ASSUME_ITS_EQUAL_CSTR(p.abbrev, "CEST");
+    ASSUME_ITS_EQUAL_I64(p.begin, 1711846800LL);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(zone, 1711846799LL, &p), 0);
+    ASSUME_ITS_EQUAL_I32(p.offset_sec, 3600);
+    ASSUME_ITS_EQUAL_I64(p.end, 1711846800LL);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_offset(zone, -5364662400LL * 1000000000LL), 3208); // LMT
+
+    fossil_time_zone_close(zone);
+}
+
+// Test: instants past the transition table follow the footer rule
+FOSSIL_TEST(c_test_zone_footer_rule) {
+    fossil_time_zone_t *zone = fossil_time_zone_open("Europe/Berlin");
+    fossil_time_zone_period_t p;
+
+    if (!zone) return;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(zone, 4110000000LL, &p), 0); // 2100-03-29
+    ASSUME_ITS_EQUAL_I32(p.offset_sec, 7200);
+    ASSUME_ITS_EQUAL_CSTR(p.abbrev, "CEST");
+    ASSUME_ITS_EQUAL_I64(p.begin, 4109878800LL);
+    ASSUME_ITS_EQUAL_I64(p.end, 4128627600LL);
+
+    fossil_time_zone_close(zone);
+}
+
+// Test: conversion to local wall-clock time
+FOSSIL_TEST(c_test_zone_to_local) {
+    fossil_time_zone_t *zone = fossil_time_zone_open("America/New_York");
+    fossil_time_date_t dt;
+
+    if (!zone) return;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_local(zone, 1719828000LL * 1000000000LL + 5, &dt), 0);
+    ASSUME_ITS_EQUAL_I32(dt.year, 2024);
+    ASSUME_ITS_EQUAL_I32(dt.month, 7);
+    ASSUME_ITS_EQUAL_I32(dt.day, 1);
+    ASSUME_ITS_EQUAL_I32(dt.hour, 6);
+    ASSUME_ITS_EQUAL_I32(dt.nanosecond, 5);
+    ASSUME_ITS_EQUAL_I32(dt.tz_offset_min, -240);
+    ASSUME_ITS_EQUAL_I64(fossil_time_date_to_unix_nanoseconds(&dt), 1719828000LL * 1000000000LL + 5);
+
+    // fall back: 01:59:59 EDT is followed by 01:00:00 EST
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_local(zone, 1730613600LL * 1000000000LL, &dt), 0);
+    ASSUME_ITS_EQUAL_I32(dt.hour, 1);
+    ASSUME_ITS_EQUAL_I32(dt.tz_offset_min, -300);
+
+    fossil_time_zone_close(zone);
+}
+
+// Test: invalid names and data are rejected
+FOSSIL_TEST(c_test_zone_invalid) {
+    static const char junk[] = "TZif-not-really-a-zone-file";
+    fossil_time_zone_period_t p;
+
+    ASSUME_ITS_TRUE(fossil_time_zone_open("No/Such_Zone") == NULL);
+    ASSUME_ITS_TRUE(fossil_time_zone_open("../etc/passwd") == NULL);
+    ASSUME_ITS_TRUE(fossil_time_zone_open("/etc/localtime") == NULL);
+    ASSUME_ITS_TRUE(fossil_time_zone_open("") == NULL);
+    ASSUME_ITS_TRUE(fossil_time_zone_open(NULL) == NULL);
+    ASSUME_ITS_TRUE(fossil_time_zone_open_memory("junk", junk, sizeof(junk)) == NULL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(NULL, 0, &p), -1);
+    fossil_time_zone_close(NULL);
+}
+
+// Test: the zoneinfo directory is configurable
+FOSSIL_TEST(c_test_zone_directory) {
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_set_directory("/nonexistent/zoneinfo"), 0);
+    ASSUME_ITS_EQUAL_CSTR(fossil_time_zone_directory(), "/nonexistent/zoneinfo");
+    ASSUME_ITS_TRUE(fossil_time_zone_open("Europe/Berlin") == NULL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_set_directory(NULL), 0);
+    ASSUME_ITS_TRUE(strcmp(fossil_time_zone_directory(), "/nonexistent/zoneinfo") != 0);
+}
+
+// Test: cached lookups agree with uncached ones across zones and reopen
+FOSSIL_TEST(c_test_zone_cached_lookup) {
+    fossil_time_zone_t *berlin = fossil_time_zone_open("Europe/Berlin");
+    fossil_time_zone_t *sydney = fossil_time_zone_open("Australia/Sydney");
+    fossil_time_zone_period_t a, b;
+
+    if (!berlin || !sydney) {
+        fossil_time_zone_close(berlin);
+        fossil_time_zone_close(sydney);
+        return;
+    }
+
+    for (int64_t t = 1704067200LL; t < 1767225600LL; t += 86400 / 3 + 7) {
+        fossil_time_zone_t *zone = ((t / 86400) % 2) ? berlin : sydney;
+        ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup_cached(zone, t, &a), 0);
+        ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(zone, t, &b), 0);
+        ASSUME_ITS_EQUAL_I32(a.offset_sec, b.offset_sec);
+        ASSUME_ITS_EQUAL_I64(a.begin, b.begin);
+        ASSUME_ITS_EQUAL_I64(a.end, b.end);
+    }
+
+    // A zone reopened after close never sees the old zone's entries
+    fossil_time_zone_close(berlin);
+    berlin = fossil_time_zone_open("America/New_York");
+    if (berlin) {
+        ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup_cached(berlin, 1719828000LL, &a), 0);
+        ASSUME_ITS_EQUAL_I32(a.offset_sec, -4 * 3600);
+    }
+
+    fossil_time_zone_close(berlin);
+    fossil_time_zone_close(sydney);
+}
+
+static fossil_time_date_t make_wall(int y, int mo, int d, int h, int mi) {
+    fossil_time_date_t dt;
+    memset(&dt, 0, sizeof(dt));
+    dt.year = y; dt.month = (int8_t)mo; dt.day = (int8_t)d;
+    dt.hour = (int8_t)h; dt.minute = (int8_t)mi;
+    dt.precision_mask = FOSSIL_TIME_PRECISION_YEAR | FOSSIL_TIME_PRECISION_MONTH |
+                        FOSSIL_TIME_PRECISION_DAY | FOSSIL_TIME_PRECISION_HOUR |
+                        FOSSIL_TIME_PRECISION_MINUTE | FOSSIL_TIME_PRECISION_SECOND;
+    return dt;
+}
+
+// Test: batch localization matches per-row conversion and round-trips
+FOSSIL_TEST(c_test_zone_to_local_batch) {
+    enum { ROWS = 3000 };
+    static int64_t utc[ROWS], back[ROWS];
+    static fossil_time_date_t local[ROWS];
+    fossil_time_zone_t *zone = fossil_time_zone_open("Europe/Berlin");
+
+    if (!zone) return;
+
+    // Every 97 minutes from 2024-03-01 into September: crosses spring forward
+    for (int i = 0; i < ROWS; ++i)
+        utc[i] = (1709251200LL + (int64_t)i * 97 * 60) * 1000000000LL + i;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_local_batch(zone, utc, ROWS, local), 0);
+    for (int i = 0; i < ROWS; i += 37) {
+        fossil_time_date_t one;
+        fossil_time_zone_to_local(zone, utc[i], &one);
+        ASSUME_ITS_TRUE(memcmp(&one, &local[i], sizeof(one)) == 0);
+    }
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc_batch(zone, local, ROWS, FOSSIL_TIME_ZONE_SHIFT_FORWARD, back), 0);
+    ASSUME_ITS_TRUE(memcmp(utc, back, sizeof(utc)) == 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_local_batch(NULL, utc, ROWS, local), -1);
+    fossil_time_zone_close(zone);
+}
+
+// Test: skipped wall times shift forward, repeated ones take the earlier instant
+FOSSIL_TEST(c_test_zone_to_utc_batch_transitions) {
+    fossil_time_zone_t *zone = fossil_time_zone_open("Europe/Berlin");
+    fossil_time_date_t wall[3];
+    int64_t utc[3];
+
+    if (!zone) return;
+
+    wall[0] = make_wall(2024, 3, 31, 2, 30);   // does not exist
+    wall[1] = make_wall(2024, 10, 27, 2, 30);  // happens twice
+    wall[2] = make_wall(2024, 7, 1, 12, 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc_batch(zone, wall, 3, FOSSIL_TIME_ZONE_SHIFT_FORWARD, utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc[0], 1711848600LL * 1000000000LL); // 03:30 CEST
+    ASSUME_ITS_EQUAL_I64(utc[1], 1729989000LL * 1000000000LL); // 02:30 CEST
+    ASSUME_ITS_EQUAL_I64(utc[2], 1719828000LL * 1000000000LL);
+
+    fossil_time_zone_close(zone);
+}
+
+// Test: each policy picks its instant for skipped and repeated wall times
+FOSSIL_TEST(c_test_zone_to_utc_policies) {
+    fossil_time_zone_t *zone = fossil_time_zone_open("Europe/Berlin");
+    fossil_time_date_t gap = make_wall(2024, 3, 31, 2, 30);
+    fossil_time_date_t fold = make_wall(2024, 10, 27, 2, 30);
+    fossil_time_date_t plain = make_wall(2024, 7, 1, 12, 0);
+    fossil_time_date_t rows[3];
+    int64_t utc, out[3];
+
+    if (!zone) return;
+
+    // 02:30 on 2024-03-31 is skipped: 01:30 CET or 03:30 CEST
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &gap, FOSSIL_TIME_ZONE_EARLIEST, &utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc, 1711845000LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &gap, FOSSIL_TIME_ZONE_LATEST, &utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc, 1711848600LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &gap, FOSSIL_TIME_ZONE_SHIFT_FORWARD, &utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc, 1711848600LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &gap, FOSSIL_TIME_ZONE_REJECT, &utc), -1);
+
+    // 02:30 on 2024-10-27 happens in CEST, then again in CET
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &fold, FOSSIL_TIME_ZONE_EARLIEST, &utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc, 1729989000LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &fold, FOSSIL_TIME_ZONE_LATEST, &utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc, 1729992600LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &fold, FOSSIL_TIME_ZONE_SHIFT_FORWARD, &utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc, 1729989000LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &fold, FOSSIL_TIME_ZONE_REJECT, &utc), -1);
+
+    // Unambiguous times convert under every policy
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &plain, FOSSIL_TIME_ZONE_REJECT, &utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc, 1719828000LL * 1000000000LL);
+
+    // The batch form marks rejected rows and keeps going
+    rows[0] = gap; rows[1] = plain; rows[2] = fold;
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc_batch(zone, rows, 3, FOSSIL_TIME_ZONE_REJECT, out), 2);
+    ASSUME_ITS_EQUAL_I64(out[0], INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(out[1], 1719828000LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I64(out[2], INT64_MIN);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc_batch(zone, rows, 3, FOSSIL_TIME_ZONE_LATEST, out), 0);
+    ASSUME_ITS_EQUAL_I64(out[2], 1729992600LL * 1000000000LL);
+
+    // Rows past 2262 are rejected like policy failures, not wrapped
+    rows[0] = make_wall(3000, 1, 1, 0, 0); rows[1] = plain; rows[2] = make_wall(3000, 1, 2, 0, 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc_batch(zone, rows, 3, FOSSIL_TIME_ZONE_LATEST, out), 2);
+    ASSUME_ITS_EQUAL_I64(out[0], INT64_MIN);
+    ASSUME_ITS_EQUAL_I64(out[1], 1719828000LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I64(out[2], INT64_MIN);
+
+    // Valid wall times past 2262 have no int64 nanosecond instant
+    fossil_time_date_t late = make_wall(3000, 1, 1, 0, 0);
+    utc = 42;
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &late, FOSSIL_TIME_ZONE_EARLIEST, &utc), -1);
+    ASSUME_ITS_EQUAL_I64(utc, 42);
+    late = make_wall(2262, 4, 12, 1, 47);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(zone, &late, FOSSIL_TIME_ZONE_EARLIEST, &utc), 0);
+    ASSUME_ITS_EQUAL_I64(utc, 9223372020000000000LL);
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_to_utc(NULL, &plain, FOSSIL_TIME_ZONE_EARLIEST, &utc), -1);
+    fossil_time_zone_close(zone);
+}
+
+// Test: zones compiled into the library agree with the zoneinfo files
+FOSSIL_TEST(c_test_zone_embedded) {
+    static const char *names[] = { "Europe/Berlin", "America/Sao_Paulo", "Australia/Lord_Howe", "UTC" };
+    fossil_time_zone_period_t a, b;
+
+    ASSUME_ITS_TRUE(fossil_time_zone_open_embedded("../etc/passwd") == NULL);
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        fossil_time_zone_t *embedded = fossil_time_zone_open_embedded(names[i]);
+        fossil_time_zone_t *file;
+
+        if (!embedded) return;  // built without embedded zones
+        ASSUME_ITS_EQUAL_CSTR(fossil_time_zone_name(embedded), names[i]);
+
+        fossil_time_zone_set_directory(fossil_time_zone_directory());
+        file = fossil_time_zone_open(names[i]);
+        fossil_time_zone_set_directory(NULL);
+        if (file) {
+            for (int64_t t = -2500000000LL; t < 4200000000LL; t += 86400 * 5 + 3607) {
+                ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(embedded, t, &a), 0);
+                ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(file, t, &b), 0);
+                ASSUME_ITS_EQUAL_I32(a.offset_sec, b.offset_sec);
+                ASSUME_ITS_EQUAL_I64(a.begin, b.begin);
+                ASSUME_ITS_EQUAL_I64(a.end, b.end);
+                ASSUME_ITS_EQUAL_CSTR(a.abbrev, b.abbrev);
+            }
+        }
+        fossil_time_zone_close(file);
+        fossil_time_zone_close(embedded);
+    }
+}
+
+// Test: shared zones are one object per name and survive a reload
+FOSSIL_TEST(c_test_zone_shared) {
+    fossil_time_zone_t *a = fossil_time_zone_get("Europe/Paris");
+    fossil_time_zone_t *b, *c;
+    fossil_time_zone_period_t p;
+
+    if (!a) return;
+
+    b = fossil_time_zone_get("Europe/Paris");
+    ASSUME_ITS_TRUE(a == b);
+    ASSUME_ITS_TRUE(fossil_time_zone_get("Not/A_Zone") == NULL);
+    ASSUME_ITS_TRUE(fossil_time_zone_get("../Europe/Paris") == NULL);
+
+    // Reloading publishes a new version; held handles keep the old one
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_reload("Europe/Paris"), 1);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_reload("Not/A_Zone"), 0);
+    c = fossil_time_zone_get("Europe/Paris");
+    ASSUME_ITS_TRUE(c != a);
+    ASSUME_ITS_EQUAL_CSTR(fossil_time_zone_name(c), "Europe/Paris");
+
+    fossil_time_zone_close(b);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_lookup(a, 1719828000LL, &p), 0);
+    ASSUME_ITS_EQUAL_CSTR(p.abbrev, "CEST");
+    fossil_time_zone_close(a);
+
+    ASSUME_ITS_TRUE(fossil_time_zone_retain(c) == c);
+    fossil_time_zone_close(c);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_offset(c, 1704067200LL * 1000000000LL), 3600);
+    fossil_time_zone_close(c);
+}
+
+// Test: local formatting with offsets and abbreviations, scalar and batch
+FOSSIL_TEST(c_test_zone_format) {
+    enum { ROWS = 400, STRIDE = 48 };
+    static int64_t utc[ROWS];
+    static char rows[ROWS * STRIDE];
+    fossil_time_zone_t *zone = fossil_time_zone_open("Europe/Berlin");
+    char one[STRIDE];
+
+    if (!zone) return;
+
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_format(zone, 1719828000LL * 1000000000LL + 5000000,
+                                                 one, sizeof(one), "iso"), 29);
+    ASSUME_ITS_EQUAL_CSTR(one, "2024-07-01T12:00:00.005+02:00");
+    fossil_time_zone_format(zone, 1704067200LL * 1000000000LL, one, sizeof(one), "abbr");
+    ASSUME_ITS_EQUAL_CSTR(one, "2024-01-01T01:00:00 CET");
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_format(zone, 0, one, sizeof(one), "human"), -1);
+
+    // Hourly across the autumn transition: rows match the scalar form
+    for (int i = 0; i < ROWS; ++i)
+        utc[i] = (1729900000LL + (int64_t)i * 3600) * 1000000000LL;
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_format_batch(zone, utc, ROWS, rows, STRIDE, "abbr"), 0);
+    for (int i = 0; i < ROWS; ++i) {
+        fossil_time_zone_format(zone, utc[i], one, sizeof(one), "abbr");
+        ASSUME_ITS_EQUAL_CSTR(rows + i * STRIDE, one);
+    }
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_format_batch(zone, utc, ROWS, rows, STRIDE, "iso"), 0);
+    for (int i = 0; i < ROWS; ++i) {
+        fossil_time_date_t dt;
+        fossil_time_zone_to_local(zone, utc[i], &dt);
+        fossil_time_date_format(&dt, one, sizeof(one), "iso");
+        ASSUME_ITS_EQUAL_CSTR(rows + i * STRIDE, one);
+    }
+
+    // The range ends format the same through both forms
+    utc[0] = INT64_MAX;
+    utc[1] = INT64_MIN;
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_format_batch(zone, utc, 2, rows, STRIDE, "iso"), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_time_zone_format(zone, INT64_MAX, one, sizeof(one), "iso"), 35);
+    ASSUME_ITS_EQUAL_CSTR(one, "2262-04-12T01:47:16.854775807+02:00");
+    ASSUME_ITS_EQUAL_CSTR(rows, one);
+    ASSUME_ITS_TRUE(fossil_time_zone_format(zone, INT64_MIN, one, sizeof(one), "iso") > 0);
+    ASSUME_ITS_EQUAL_CSTR(rows + STRIDE, one);
+
+    fossil_time_zone_close(zone);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_zone_tests) {
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_berlin_offsets);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_footer_rule);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_to_local);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_invalid);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_directory);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_cached_lookup);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_to_local_batch);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_to_utc_batch_transitions);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_to_utc_policies);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_embedded);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_shared);
+    FOSSIL_TEST_ADD(c_zone_suite, c_test_zone_format);
+
+    FOSSIL_TEST_REGISTER(c_zone_suite);
+}
@@ -0,0 +1,125 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * performance, cross-platform applications and libraries. The code contained
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+
+#include "fossil/time/framework.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Define the test suite and add test cases
+FOSSIL_SUITE(cpp_zone_suite);
+
+// Setup function for the test suite
+FOSSIL_SETUP(cpp_zone_suite) {
+    // Setup code here
+}
+
+// Teardown function for the test suite
+FOSSIL_TEARDOWN(cpp_zone_suite) {
+    // Teardown code here
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+using fossil::time::Zone;
+using fossil::time::Date;
+
+// Test: Zone wrapper opens a zone and converts to local time
+FOSSIL_TEST(cpp_test_zone_wrapper) {
+    Zone zone("Europe/Berlin");
+    if (!zone.is_open()) return; // zoneinfo not installed on this host
+
+    ASSUME_ITS_EQUAL_CSTR(zone.name(), "Europe/Berlin");
+    ASSUME_ITS_EQUAL_I32(zone.offset(1719828000LL * 1000000000LL), 7200);
+
+    Date local = zone.to_local(1719828000LL * 1000000000LL);
+    ASSUME_ITS_EQUAL_I32(local.raw.hour, 12);
+    ASSUME_ITS_EQUAL_I32(local.raw.tz_offset_min, 120);
+
+    fossil_time_zone_period_t p;
+    ASSUME_ITS_TRUE(zone.lookup(1705320000LL, p));
+    ASSUME_ITS_EQUAL_CSTR(p.abbrev, "CET");
+
+    ASSUME_ITS_FALSE(zone.open("Not/A_Zone"));
+    ASSUME_ITS_FALSE(zone.is_open());
+}
+
+// Test: Zone wrapper converts columns in both directions
+FOSSIL_TEST(cpp_test_zone_batch) {
+    Zone zone("America/New_York");
+    if (!zone.is_open()) return;
+
+    int64_t utc[3] = {
+        1704067200LL * 1000000000LL,   // 2024-01-01T00:00Z
+        1719828000LL * 1000000000LL,   // 2024-07-01T10:00Z
+        1730613600LL * 1000000000LL    // 2024-11-03T06:00Z, first EST instant
+    };
+    fossil_time_date_t local[3];
+    int64_t back[3];
+
+    ASSUME_ITS_TRUE(zone.to_local(utc, 3, local));
+    ASSUME_ITS_EQUAL_I32(local[0].year, 2023);
+    ASSUME_ITS_EQUAL_I32(local[0].hour, 19);
+    ASSUME_ITS_EQUAL_I32(local[1].tz_offset_min, -240);
+    ASSUME_ITS_EQUAL_I32(local[2].hour, 1);
+
+    ASSUME_ITS_TRUE(zone.to_utc(local, 3, back));
+    ASSUME_ITS_EQUAL_I64(back[0], utc[0]);
+    ASSUME_ITS_EQUAL_I64(back[1], utc[1]);
+    ASSUME_ITS_EQUAL_I64(back[2], utc[2] - 3600LL * 1000000000LL); // repeated 01:00 -> EDT
+
+    ASSUME_ITS_TRUE(zone.to_utc(local, 3, back, FOSSIL_TIME_ZONE_LATEST));
+    ASSUME_ITS_EQUAL_I64(back[2], utc[2]);
+    ASSUME_ITS_FALSE(zone.to_utc(local, 3, back, FOSSIL_TIME_ZONE_REJECT));
+
+    int64_t one = 0;
+    ASSUME_ITS_TRUE(zone.to_utc(Date(local[1]), one, FOSSIL_TIME_ZONE_REJECT));
+    ASSUME_ITS_EQUAL_I64(one, utc[1]);
+}
+
+// Test: Zone wrapper shares process-wide zones
+FOSSIL_TEST(cpp_test_zone_shared) {
+    Zone a, b;
+    if (!a.get("Asia/Tokyo")) return;
+
+    ASSUME_ITS_TRUE(b.get("Asia/Tokyo"));
+    ASSUME_ITS_TRUE(a.raw == b.raw);
+    ASSUME_ITS_EQUAL_I32(Zone::reload("Asia/Tokyo"), 1);
+    ASSUME_ITS_EQUAL_I32(a.offset(0), 9 * 3600);
+
+    ASSUME_ITS_TRUE(b.get("Asia/Tokyo"));
+    ASSUME_ITS_TRUE(a.raw != b.raw);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_zone_tests) {
+    FOSSIL_TEST_ADD(cpp_zone_suite, cpp_test_zone_wrapper);
+    FOSSIL_TEST_ADD(cpp_zone_suite, cpp_test_zone_batch);
+    FOSSIL_TEST_ADD(cpp_zone_suite, cpp_test_zone_shared);
+
+    FOSSIL_TEST_REGISTER(cpp_zone_suite);
+}